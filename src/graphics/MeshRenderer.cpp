@@ -6,70 +6,68 @@
 
 #include <GL/gl.h>
 
-#include "viewport/scene/Mode.h"
+#include "objects/mesh/Mesh.h"
 #include "material/texture/Texture.h"
 #include "color/Colors.h"
 
 bool MeshRenderer::toggleDiffuse = false;
 
 
-/** Reinterpret Vertex as GLfloat* */
-void vertex3fv(const Vertex& v) {
-	glVertex3fv(reinterpret_cast<const float *>(&v));
-}
-
-void MeshRenderer::renderVertex(const Vertex& v) {
-	vertex3fv(v);
-}
-
-void MeshRenderer::renderEdge(const Edge& e, const Color& c1, const Color& c2) {
-	color3f(c1);
-	vertex3fv(*e.v0);
-	color3f(c2);
-	vertex3fv(*e.v1);
+void MeshRenderer::renderVertex(const Vector3& position) {
+	glVertex3f(position.x, position.y, position.z);
 }
 
 
-void MeshRenderer::renderVertices(const Mesh& mesh) {
+void MeshRenderer::renderVertices(const MeshSnapshot& mesh) {
 	glPointSize(4.0f);
 
-	for (const auto& v : mesh.vertices) {
+	const auto& positions = mesh.geometry->positions;
+	const auto& selected = mesh.selection->vertices;
+	for (size_t i = 0; i < positions.size(); i++) {
 		// Highlight if the Vertex is currently selected
-		const auto color = v->isSelected
+		const auto color = selected.test(i)
 			? Colors::MESH_SELECT_COLOR
 			: Colors::MESH_VERT_COLOR;
 		color3f(color);
-		renderVertex(*v);
+		renderVertex(positions[i]);
 	}
 }
 
-void MeshRenderer::renderEdges(const Mesh& mesh) {
+void MeshRenderer::renderEdges(const MeshSnapshot& mesh) {
 	glLineWidth(2.0f);
 
-	for (const auto& edge : mesh.edgeToFaceMap | views::keys) {
-		// Highlight if either of the 2 Vertices of the Edge are currently selected
-		const auto firstColor = edge.v0->isSelected
+	const auto& positions = mesh.geometry->positions;
+	const auto& selected = mesh.selection->vertices;
+	for (const auto& [a, b] : mesh.geometry->topology->edges) {
+		// Highlight either of the 2 Vertices of the Edge that are currently selected
+		const auto firstColor = selected.test(a)
 			? Colors::MESH_SELECT_COLOR
 			: Colors::MESH_EDGE_COLOR;
-		const auto secondColor = edge.v1->isSelected
+		const auto secondColor = selected.test(b)
 			? Colors::MESH_SELECT_COLOR
 			: Colors::MESH_EDGE_COLOR;
-		renderEdge(edge, firstColor, secondColor);
+		color3f(firstColor);
+		renderVertex(positions[a]);
+		color3f(secondColor);
+		renderVertex(positions[b]);
 	}
 }
 
-void MeshRenderer::renderTriangles(const Mesh& mesh) {
+void MeshRenderer::renderTriangles(const MeshSnapshot& mesh) {
+	const auto& geometry = *mesh.geometry;
+	const auto& topology = *geometry.topology;
+
 	// Function to draw a triangle with a specified color and transparency
-	auto renderTriangle = [&mesh](const Triangle& t) {
+	auto renderTriangle = [&](const size_t t) {
 		glBegin(GL_TRIANGLES);
-		for (const auto& v : {t.v0, t.v1, t.v2}) {
+		for (const auto v : topology.triangles[t]) {
 			// Choose the shading mode
 			const auto normal = mesh.shadingMode == ShadingMode::FLAT
-				? t.normal		// Flat shading
-				: v->normal;	// Smooth shading
+				? geometry.faceNormals[t]	// Flat shading
+				: geometry.normals[v];		// Smooth shading
 			glNormal3f(normal.x, normal.y, normal.z);
-			glTexCoord2f(static_cast<float>(v->texCoords.x), static_cast<float>(v->texCoords.y));
-			vertex3fv(*v);
+			glTexCoord2f(static_cast<float>(topology.texCoords[v].x), static_cast<float>(topology.texCoords[v].y));
+			renderVertex(geometry.positions[v]);
 		}
 		glEnd();
 	};
@@ -80,12 +78,14 @@ void MeshRenderer::renderTriangles(const Mesh& mesh) {
 	glMaterialfv(GL_FRONT_AND_BACK, GL_EMISSION, mesh.emission.toGLfloat());
 	glMaterialf(GL_FRONT_AND_BACK, GL_SHININESS, mesh.shininess);
 
-	for (const auto& t : mesh.triangles) {
-		// Highlight if all 3 Vertices of the Triangle are currently selected
-		const auto isSelected = t->v0->isSelected && t->v1->isSelected && t->v2->isSelected;
+	// Triangles are highlighted if all 3 of their Vertices are currently selected
+	const auto& selectedFaces = mesh.selection->faces;
+
+	for (size_t i = 0; i < topology.triangles.size(); i++) {
+		const auto isSelected = selectedFaces.test(i);
 
 		// Draw the mesh with the base color
-		renderTriangle(*t);
+		renderTriangle(i);
 
 		if (isSelected) {
 			// Disable depth testing to ensure selection color overlays correctly
@@ -97,7 +97,7 @@ void MeshRenderer::renderTriangles(const Mesh& mesh) {
 				glMaterialfv(GL_FRONT_AND_BACK, GL_DIFFUSE, Colors::MESH_SELECT_COLOR.transparent(0.4f).toGLfloat());
 			}
 
-			renderTriangle(*t);
+			renderTriangle(i);
 
 			if (toggleDiffuse) {
 				toggleDiffuse = false;
@@ -110,10 +110,10 @@ void MeshRenderer::renderTriangles(const Mesh& mesh) {
 }
 
 
-void MeshRenderer::render(const Mesh& mesh, const Mode& selectionMode, const bool isMeshSelected) {
+void MeshRenderer::render(const MeshSnapshot& mesh) {
 	// Enable textures
 	glEnable(GL_TEXTURE_2D);
-	if (mesh.texture) glBindTexture(GL_TEXTURE_2D, mesh.texture->id);
+	if (mesh.texture) mesh.texture->bind();
 
 	// Enable backface culling
 	glEnable(GL_CULL_FACE);
@@ -126,7 +126,7 @@ void MeshRenderer::render(const Mesh& mesh, const Mode& selectionMode, const boo
 	// Draw the faces
 	renderTriangles(mesh);
 
-	if (isMeshSelected && selectionMode == EDIT) {
+	if (mesh.editOverlay) {
 		glDisable(GL_LIGHTING);
 
 		// Draw the edges
@@ -150,23 +150,26 @@ void MeshRenderer::render(const Mesh& mesh, const Mode& selectionMode, const boo
 	if (mesh.texture) glBindTexture(GL_TEXTURE_2D, 0);
 }
 
-void MeshRenderer::renderSilhouette(const Mesh& mesh, const Mode& selectionMode, const Vector3& camPos, const bool isMeshSelected) {
-	if (isMeshSelected && selectionMode == OBJECT) {
+void MeshRenderer::renderSilhouette(const MeshSnapshot& mesh, const Vector3& camPos) {
+	if (mesh.silhouette) {
 		// Highlight only the outline of the Mesh in Object Mode
 		const auto color = Colors::MESH_SELECT_COLOR;
+		const auto& geometry = *mesh.geometry;
 		glLineWidth(4.0f);
 		glPointSize(3.0f);
 
-		for (const auto&[first, second]: mesh.edgeToFaceMap) {
-			if (isSilhouetteEdge(second, camPos)) {
+		for (const auto& [v0, v1, t1, t2] : geometry.topology->silhouetteEdges) {
+			if (isSilhouetteEdge(geometry, t1, t2, camPos)) {
+				color3f(color);
 				glBegin(GL_LINES);
-				renderEdge(first, color, color);
+				renderVertex(geometry.positions[v0]);
+				renderVertex(geometry.positions[v1]);
 				glEnd();
 
 				// Highlight the vertices of the silhouette edges
 				glBegin(GL_POINTS);
-				renderVertex(*first.v0);
-				renderVertex(*first.v1);
+				renderVertex(geometry.positions[v0]);
+				renderVertex(geometry.positions[v1]);
 				glEnd();
 			}
 		}
@@ -177,19 +180,18 @@ void MeshRenderer::renderSilhouette(const Mesh& mesh, const Mode& selectionMode,
 }
 
 bool MeshRenderer::isSilhouetteEdge(
-	const vector<shared_ptr<Triangle>>& edgeAdjFaces,
+	const MeshGeometrySnapshot& geometry,
+	const uint32_t t1,
+	const uint32_t t2,
 	const Vector3& camPos
 ) {
-	const auto& t1 = *edgeAdjFaces[0];
-	const auto& t2 = *edgeAdjFaces[1];
-
-	const bool t1degen = t1.isDegenerate();
-	const bool t2degen = t2.isDegenerate();
+	const bool t1degen = geometry.degenerate[t1];
+	const bool t2degen = geometry.degenerate[t2];
 
 	if (t1degen && t2degen) return false; // Ignore edges fully enclosed by degenerate triangles
 
-	const bool t1ff = !t1degen && t1.normal.dot(camPos - t1.centroid) > 0.0f;
-	const bool t2ff = !t2degen && t2.normal.dot(camPos - t2.centroid) > 0.0f;
+	const bool t1ff = !t1degen && geometry.faceNormals[t1].dot(camPos - geometry.centroids[t1]) > 0.0f;
+	const bool t2ff = !t2degen && geometry.faceNormals[t2].dot(camPos - geometry.centroids[t2]) > 0.0f;
 
 	return t1degen || t2degen	// If only one triangle is degenerate...
 		? !(t1ff || t2ff)		// ...Edge is silhouette if the non-degenerate Triangle is back-facing
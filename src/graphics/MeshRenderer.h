@@ -2,23 +2,23 @@
 
 #include <vector>
 
-#include "objects/mesh/Mesh.h"
+#include "MeshSnapshot.h"
 
 
+/** Draws MeshSnapshots; called on the render thread only */
 class MeshRenderer {
 public:
-	static void render(const Mesh &mesh, const Mode &selectionMode, bool isMeshSelected);
-	static void renderSilhouette(const Mesh &mesh, const Mode &selectionMode, const Vector3 &camPos, bool isMeshSelected);
+	static void render(const MeshSnapshot &mesh);
+	static void renderSilhouette(const MeshSnapshot &mesh, const Vector3 &camPos);
 
 private:
-	static void renderVertex(const Vertex& v);
-	static void renderEdge(const Edge& e, const Color& c1, const Color& c2);
+	static void renderVertex(const Vector3 &position);
 
-	static void renderVertices(const Mesh &mesh);
-	static void renderEdges(const Mesh &mesh);
-	static void renderTriangles(const Mesh &mesh);
+	static void renderVertices(const MeshSnapshot &mesh);
+	static void renderEdges(const MeshSnapshot &mesh);
+	static void renderTriangles(const MeshSnapshot &mesh);
 
-	static bool isSilhouetteEdge(const vector<shared_ptr<Triangle>> &edgeAdjFaces, const Vector3 &camPos);
+	static bool isSilhouetteEdge(const MeshGeometrySnapshot &geometry, uint32_t t1, uint32_t t2, const Vector3 &camPos);
 
 	static bool toggleDiffuse;
 };
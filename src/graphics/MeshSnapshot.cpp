@@ -0,0 +1,120 @@
+#include "MeshSnapshot.h"
+
+#include <ranges>
+#include <unordered_map>
+
+#include "jobs/JobSystem.h"
+#include "objects/mesh/Mesh.h"
+#include "viewport/scene/Mode.h"
+
+
+MeshSnapshot MeshSnapshot::capture(const Mesh& mesh, const bool isMeshSelected, const Mode& selectionMode) {
+	auto& topology = mesh.topologySnapshot;
+	if (!topology || topology->version != mesh.topologyVersion) {
+		topology = captureTopology(mesh);
+	}
+
+	auto& geometry = mesh.geometrySnapshot;
+	if (!geometry || geometry->version != mesh.geometryVersion || geometry->topology != topology) {
+		geometry = captureGeometry(mesh, topology);
+	}
+
+	const auto& meshSelection = mesh.getSelection();
+	auto& selection = mesh.selectionSnapshot;
+	if (!selection || selection->version != meshSelection.getVersion() || selection->topologyVersion != mesh.topologyVersion) {
+		selection = captureSelection(mesh);
+	}
+
+	MeshSnapshot snapshot;
+	snapshot.geometry	 = geometry;
+	snapshot.selection	 = selection;
+	snapshot.texture	 = mesh.texture;
+	snapshot.shadingMode = mesh.shadingMode;
+	snapshot.diffuse	 = mesh.diffuse;
+	snapshot.specular	 = mesh.specular;
+	snapshot.emission	 = mesh.emission;
+	snapshot.ambient	 = mesh.ambient;
+	snapshot.shininess	 = mesh.shininess;
+	snapshot.editOverlay = isMeshSelected && selectionMode == EDIT;
+	snapshot.silhouette	 = isMeshSelected && selectionMode == OBJECT;
+	return snapshot;
+}
+
+
+shared_ptr<const MeshTopologySnapshot> MeshSnapshot::captureTopology(const Mesh& mesh) {
+	auto topology = make_shared<MeshTopologySnapshot>();
+	topology->version = mesh.topologyVersion;
+
+	unordered_map<const Vertex*, uint32_t> vertexIndex;
+	vertexIndex.reserve(mesh.vertices.size());
+	topology->texCoords.reserve(mesh.vertices.size());
+	for (size_t i = 0; i < mesh.vertices.size(); i++) {
+		vertexIndex.emplace(mesh.vertices[i].get(), static_cast<uint32_t>(i));
+		topology->texCoords.emplace_back(mesh.vertices[i]->texCoords);
+	}
+
+	unordered_map<const Triangle*, uint32_t> triangleIndex;
+	triangleIndex.reserve(mesh.triangles.size());
+	topology->triangles.reserve(mesh.triangles.size());
+	for (size_t i = 0; i < mesh.triangles.size(); i++) {
+		const auto& t = mesh.triangles[i];
+		triangleIndex.emplace(t.get(), static_cast<uint32_t>(i));
+		topology->triangles.push_back({vertexIndex.at(t->v0.get()), vertexIndex.at(t->v1.get()), vertexIndex.at(t->v2.get())});
+	}
+
+	topology->edges = mesh.getSelection().getEdgeList();
+
+	// Only Edges between two Triangles can be on the silhouette
+	for (const auto& [edge, faces] : mesh.edgeToFaceMap) {
+		if (faces.size() < 2) continue;
+		topology->silhouetteEdges.push_back({
+			vertexIndex.at(edge.v0.get()), vertexIndex.at(edge.v1.get()),
+			triangleIndex.at(faces[0].get()), triangleIndex.at(faces[1].get())
+		});
+	}
+
+	return topology;
+}
+
+shared_ptr<const MeshGeometrySnapshot> MeshSnapshot::captureGeometry(const Mesh& mesh, shared_ptr<const MeshTopologySnapshot> topology) {
+	auto geometry = make_shared<MeshGeometrySnapshot>();
+	geometry->version  = mesh.geometryVersion;
+	geometry->topology = move(topology);
+
+	const size_t vertexCount   = mesh.vertices.size();
+	const size_t triangleCount = mesh.triangles.size();
+
+	geometry->positions.resize(vertexCount);
+	geometry->normals.resize(vertexCount);
+	JobSystem::parallelFor(vertexCount, MESH_PARALLEL_THRESHOLD, [&](const size_t begin, const size_t end) {
+		for (size_t i = begin; i < end; i++) {
+			geometry->positions[i] = mesh.vertices[i]->position;
+			geometry->normals[i]   = mesh.vertices[i]->normal;
+		}
+	});
+
+	geometry->faceNormals.resize(triangleCount);
+	geometry->centroids.resize(triangleCount);
+	geometry->degenerate.resize(triangleCount);
+	JobSystem::parallelFor(triangleCount, MESH_PARALLEL_THRESHOLD, [&](const size_t begin, const size_t end) {
+		for (size_t i = begin; i < end; i++) {
+			const auto& t = *mesh.triangles[i];
+			geometry->faceNormals[i] = t.normal;
+			geometry->centroids[i]	 = t.centroid;
+			geometry->degenerate[i]	 = t.isDegenerate();
+		}
+	});
+
+	return geometry;
+}
+
+shared_ptr<const MeshSelectionSnapshot> MeshSnapshot::captureSelection(const Mesh& mesh) {
+	const auto& meshSelection = mesh.getSelection();
+
+	auto selection = make_shared<MeshSelectionSnapshot>();
+	selection->version		   = meshSelection.getVersion();
+	selection->topologyVersion = mesh.topologyVersion;
+	selection->vertices		   = meshSelection.getVertices();
+	selection->faces		   = meshSelection.getFaces();
+	return selection;
+}
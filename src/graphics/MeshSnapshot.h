@@ -0,0 +1,83 @@
+#pragma once
+
+using namespace std;
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "graphics/color/Colors.h"
+#include "math/BitSet.h"
+#include "math/vector/Vector2.h"
+#include "math/vector/Vector3.h"
+
+class Mesh;
+class Mode;
+class Texture;
+
+enum class ShadingMode;
+
+
+/** Index lists of a Mesh, which only change with its topology */
+struct MeshTopologySnapshot {
+	uint64_t version = 0;						// Mesh topology version this was taken from
+
+	vector<array<uint32_t, 3>> triangles;		// Vertex indices, in Mesh order
+	vector<array<uint32_t, 2>> edges;			// Vertex indices of every unique Edge
+	vector<array<uint32_t, 4>> silhouetteEdges;	// Vertex indices and the first two adjacent Triangles of every Edge shared by two or more
+	vector<Vector2> texCoords;					// Per Vertex
+};
+
+/** Vertex and face data of a Mesh, which change with every edit */
+struct MeshGeometrySnapshot {
+	uint64_t version = 0;						// Mesh geometry version this was taken from
+	shared_ptr<const MeshTopologySnapshot> topology;
+
+	vector<Vector3> positions;					// Per Vertex
+	vector<Vector3> normals;
+	vector<Vector3> faceNormals;				// Per Triangle
+	vector<Vector3> centroids;
+	vector<uint8_t> degenerate;
+};
+
+/** Selected Vertices and the Triangles derived from them */
+struct MeshSelectionSnapshot {
+	uint64_t version = 0;						// MeshSelection version this was taken from
+	uint64_t topologyVersion = 0;
+
+	BitSet vertices;
+	BitSet faces;
+};
+
+
+/**
+ * Immutable copy of everything MeshRenderer draws of a Mesh, taken on the main thread and drawn on the
+ * render thread while the Mesh goes on changing.
+ *
+ * The three parts are cached by the Mesh and only retaken once their version moved on, so an unchanged
+ * Mesh costs a few reference counts per frame, and moving Vertices doesn't copy the index lists again.
+ */
+struct MeshSnapshot {
+	shared_ptr<const MeshGeometrySnapshot> geometry;
+	shared_ptr<const MeshSelectionSnapshot> selection;
+
+	shared_ptr<Texture> texture;
+	ShadingMode shadingMode{};
+
+	Color diffuse	= Colors::WHITE;
+	Color specular	= Colors::WHITE;
+	Color emission	= Colors::BLACK;
+	Color ambient	= Colors::WHITE;
+	float shininess	= 0.0f;
+
+	bool editOverlay = false;	// Vertices and Edges drawn on top (selected in Edit Mode)
+	bool silhouette  = false;	// Outline drawn (selected in Object Mode)
+
+	static MeshSnapshot capture(const Mesh &mesh, bool isMeshSelected, const Mode &selectionMode);
+
+private:
+	static shared_ptr<const MeshTopologySnapshot> captureTopology(const Mesh &mesh);
+	static shared_ptr<const MeshGeometrySnapshot> captureGeometry(const Mesh &mesh, shared_ptr<const MeshTopologySnapshot> topology);
+	static shared_ptr<const MeshSelectionSnapshot> captureSelection(const Mesh &mesh);
+};
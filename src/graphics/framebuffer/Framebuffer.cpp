@@ -0,0 +1,100 @@
+#include "Framebuffer.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+
+Framebuffer::Framebuffer(const int samples) : samples(samples) {
+	// Clamp the requested sample count to what the driver supports
+	GLint maxSamples = 0;
+	glGetIntegerv(GL_MAX_SAMPLES, &maxSamples);
+	this->samples = clamp(samples, 0, static_cast<int>(maxSamples));
+}
+
+Framebuffer::~Framebuffer() {
+	release();
+}
+
+/** Framebuffer objects are core since OpenGL 3.0 */
+bool Framebuffer::isSupported() {
+	return GLEW_VERSION_3_0 || GLEW_ARB_framebuffer_object;
+}
+
+
+/** (Re-)allocate the attachments if the requested size differs from the current one */
+void Framebuffer::resize(const int w, const int h) {
+	if (w == width && h == height) return;
+	release();
+
+	width  = w;
+	height = h;
+
+	// Multisampled color and depth attachments
+	glGenRenderbuffers(1, &msColorBuffer);
+	glBindRenderbuffer(GL_RENDERBUFFER, msColorBuffer);
+	glRenderbufferStorageMultisample(GL_RENDERBUFFER, samples, GL_RGBA8, width, height);
+
+	glGenRenderbuffers(1, &msDepthBuffer);
+	glBindRenderbuffer(GL_RENDERBUFFER, msDepthBuffer);
+	glRenderbufferStorageMultisample(GL_RENDERBUFFER, samples, GL_DEPTH_COMPONENT24, width, height);
+
+	glGenFramebuffers(1, &msFbo);
+	glBindFramebuffer(GL_FRAMEBUFFER, msFbo);
+	glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, msColorBuffer);
+	glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, msDepthBuffer);
+
+	if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE) {
+		glBindFramebuffer(GL_FRAMEBUFFER, 0);
+		throw runtime_error("Multisampled framebuffer is incomplete");
+	}
+
+	// Single-sampled resolve target
+	glGenRenderbuffers(1, &resolveBuffer);
+	glBindRenderbuffer(GL_RENDERBUFFER, resolveBuffer);
+	glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, width, height);
+
+	glGenFramebuffers(1, &resolveFbo);
+	glBindFramebuffer(GL_FRAMEBUFFER, resolveFbo);
+	glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, resolveBuffer);
+
+	if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE) {
+		glBindFramebuffer(GL_FRAMEBUFFER, 0);
+		throw runtime_error("Resolve framebuffer is incomplete");
+	}
+
+	glBindRenderbuffer(GL_RENDERBUFFER, 0);
+	glBindFramebuffer(GL_FRAMEBUFFER, 0);
+}
+
+void Framebuffer::bind() const {
+	glBindFramebuffer(GL_FRAMEBUFFER, msFbo);
+}
+
+/**
+ * Resolve the multisampled buffer and stretch the result over the whole default framebuffer.
+ * Leaves the default framebuffer bound afterwards.
+ */
+void Framebuffer::blitToScreen(const int screenW, const int screenH) const {
+	// Resolve samples at the internal resolution
+	glBindFramebuffer(GL_READ_FRAMEBUFFER, msFbo);
+	glBindFramebuffer(GL_DRAW_FRAMEBUFFER, resolveFbo);
+	glBlitFramebuffer(0, 0, width, height, 0, 0, width, height, GL_COLOR_BUFFER_BIT, GL_NEAREST);
+
+	// Upscale to the window resolution
+	glBindFramebuffer(GL_READ_FRAMEBUFFER, resolveFbo);
+	glBindFramebuffer(GL_DRAW_FRAMEBUFFER, 0);
+	glBlitFramebuffer(0, 0, width, height, 0, 0, screenW, screenH, GL_COLOR_BUFFER_BIT, GL_LINEAR);
+
+	glBindFramebuffer(GL_FRAMEBUFFER, 0);
+}
+
+void Framebuffer::release() {
+	if (msFbo)		   glDeleteFramebuffers(1, &msFbo);
+	if (resolveFbo)	   glDeleteFramebuffers(1, &resolveFbo);
+	if (msColorBuffer) glDeleteRenderbuffers(1, &msColorBuffer);
+	if (msDepthBuffer) glDeleteRenderbuffers(1, &msDepthBuffer);
+	if (resolveBuffer) glDeleteRenderbuffers(1, &resolveBuffer);
+
+	msFbo = resolveFbo = msColorBuffer = msDepthBuffer = resolveBuffer = 0;
+	width = height = 0;
+}
@@ -0,0 +1,46 @@
+#pragma once
+
+using namespace std;
+
+#include <GL/glew.h>
+
+
+/**
+ * Offscreen render target with a color and a depth attachment.
+ *
+ * Rendering goes into a multisampled FBO, which is resolved into a single-sampled FBO
+ * before being stretched onto the default framebuffer, since scaled blits from
+ * multisampled buffers aren't allowed.
+ */
+class Framebuffer {
+public:
+	explicit Framebuffer(int samples);
+	~Framebuffer();
+
+	Framebuffer(const Framebuffer&) = delete;
+	Framebuffer& operator=(const Framebuffer&) = delete;
+
+	void resize(int w, int h);
+
+	void bind() const;
+	void blitToScreen(int screenW, int screenH) const;
+
+	[[nodiscard]] int getWidth()  const { return width; }
+	[[nodiscard]] int getHeight() const { return height; }
+
+	[[nodiscard]] static bool isSupported();
+
+private:
+	int samples;
+	int width  = 0;
+	int height = 0;
+
+	GLuint msFbo		  = 0;	// Multisampled FBO that is rendered into
+	GLuint msColorBuffer  = 0;
+	GLuint msDepthBuffer  = 0;
+
+	GLuint resolveFbo	  = 0;	// Single-sampled FBO used as source for the upscaling blit
+	GLuint resolveBuffer  = 0;
+
+	void release();
+};
@@ -0,0 +1,283 @@
+#include "PickingBuffer.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+#include "objects/mesh/Mesh.h"
+
+// Constants
+constexpr float PICK_POINT_SIZE = 4.0f;	// Same as the Edit Mode vertex dots
+
+
+/** Set the current color to a 32-bit ID, one byte per channel */
+static void idColor(const uint32_t id) {
+	glColor4ub(id & 0xFF, id >> 8 & 0xFF, id >> 16 & 0xFF, id >> 24 & 0xFF);
+}
+
+static uint32_t decodeID(const uint8_t* rgba) {
+	return rgba[0] | rgba[1] << 8 | rgba[2] << 16 | static_cast<uint32_t>(rgba[3]) << 24;
+}
+
+static void renderFaces(const Mesh& mesh) {
+	for (const auto& t : mesh.triangles) {
+		glVertex3f(t->v0->position.x, t->v0->position.y, t->v0->position.z);
+		glVertex3f(t->v1->position.x, t->v1->position.y, t->v1->position.z);
+		glVertex3f(t->v2->position.x, t->v2->position.y, t->v2->position.z);
+	}
+}
+
+
+PickingBuffer::~PickingBuffer() {
+	release();
+}
+
+/** Framebuffer objects are core since OpenGL 3.0 */
+bool PickingBuffer::isSupported() {
+	return GLEW_VERSION_3_0 || GLEW_ARB_framebuffer_object;
+}
+
+
+optional<PickResult> PickingBuffer::pick(
+	const vector<shared_ptr<Mesh>>& targets,
+	const vector<shared_ptr<Mesh>>& occluders,
+	const PickTarget target,
+	const int x, const int y, const int radius,
+	const array<int, 4>& viewport,
+	const array<float, 16>& viewMatrix,
+	const array<float, 16>& projMatrix
+) {
+	resize(viewport[2], viewport[3]);
+
+	// Window around the cursor in GL coordinates (origin bottom left), clamped to the buffer
+	const int centerX = x;
+	const int centerY = height - 1 - y;
+	const int x0 = max(centerX - radius, 0), x1 = min(centerX + radius, width - 1);
+	const int y0 = max(centerY - radius, 0), y1 = min(centerY + radius, height - 1);
+	if (x0 > x1 || y0 > y1) return nullopt;
+	const int w = x1 - x0 + 1;
+	const int h = y1 - y0 + 1;
+
+	const auto offsets = elementOffsets(targets, target);
+	const auto ids = render(targets, occluders, target, offsets, x0, y0, w, h, viewMatrix, projMatrix);
+
+	// The ID closest to the cursor wins
+	uint32_t bestID = 0;
+	int bestDist = INT32_MAX;
+	for (int py = 0; py < h; py++) {
+		for (int px = 0; px < w; px++) {
+			const uint32_t id = ids[static_cast<size_t>(py) * w + px];
+			const int dx = x0 + px - centerX;
+			const int dy = y0 + py - centerY;
+			if (const int dist = dx * dx + dy * dy; id != 0 && dist < bestDist) {
+				bestDist = dist;
+				bestID = id;
+			}
+		}
+	}
+	return decode(bestID, offsets, target);
+}
+
+vector<PickResult> PickingBuffer::pickRegion(
+	const vector<shared_ptr<Mesh>>& targets,
+	const vector<shared_ptr<Mesh>>& occluders,
+	const PickTarget target,
+	const int left, const int top, const int right, const int bottom,
+	const function<bool(int, int)>& inside,
+	const array<int, 4>& viewport,
+	const array<float, 16>& viewMatrix,
+	const array<float, 16>& projMatrix
+) {
+	resize(viewport[2], viewport[3]);
+
+	// Bounding rectangle in GL coordinates, clamped to the buffer
+	const int x0 = max(left, 0), x1 = min(right, width - 1);
+	const int y0 = max(height - 1 - bottom, 0), y1 = min(height - 1 - top, height - 1);
+	if (x0 > x1 || y0 > y1) return {};
+	const int w = x1 - x0 + 1;
+	const int h = y1 - y0 + 1;
+
+	const auto offsets = elementOffsets(targets, target);
+	const auto ids = render(targets, occluders, target, offsets, x0, y0, w, h, viewMatrix, projMatrix);
+
+	// Every ID with at least one pixel inside the region; the predicate only runs for IDs not found yet
+	vector<bool> found(offsets.back(), false);
+	vector<PickResult> results;
+	for (int py = 0; py < h; py++) {
+		for (int px = 0; px < w; px++) {
+			const uint32_t id = ids[static_cast<size_t>(py) * w + px];
+			if (id == 0 || id >= found.size() || found[id]) continue;
+			if (!inside(x0 + px, height - 1 - (y0 + py))) continue;
+
+			found[id] = true;
+			results.emplace_back(*decode(id, offsets, target));
+		}
+	}
+	return results;
+}
+
+
+/** ID of the first element of every target Mesh, plus the end; 0 is reserved for the background */
+vector<uint32_t> PickingBuffer::elementOffsets(const vector<shared_ptr<Mesh>>& targets, const PickTarget target) {
+	vector<uint32_t> offsets(targets.size() + 1, 1);
+	for (size_t i = 0; i < targets.size(); i++) {
+		const size_t elements = target == PickTarget::OBJECT ? 1
+							  : target == PickTarget::FACE	 ? targets[i]->triangles.size()
+							  :								   targets[i]->vertices.size();
+		offsets[i + 1] = offsets[i] + static_cast<uint32_t>(elements);
+	}
+	return offsets;
+}
+
+optional<PickResult> PickingBuffer::decode(const uint32_t id, const vector<uint32_t>& offsets, const PickTarget target) {
+	if (id == 0 || id >= offsets.back()) return nullopt;
+
+	const auto mesh = static_cast<int>(ranges::upper_bound(offsets, id) - offsets.begin()) - 1;
+	const int element = target == PickTarget::OBJECT ? -1 : static_cast<int>(id - offsets[mesh]);
+	return PickResult{mesh, element};
+}
+
+/** Render the IDs into the window (GL coordinates) and read it back, one decoded ID per pixel, rows bottom up */
+vector<uint32_t> PickingBuffer::render(
+	const vector<shared_ptr<Mesh>>& targets,
+	const vector<shared_ptr<Mesh>>& occluders,
+	const PickTarget target,
+	const vector<uint32_t>& offsets,
+	const int x0, const int y0, const int w, const int h,
+	const array<float, 16>& viewMatrix,
+	const array<float, 16>& projMatrix
+) {
+	glPushAttrib(GL_ALL_ATTRIB_BITS);
+	glMatrixMode(GL_PROJECTION);
+	glPushMatrix();
+	glLoadMatrixf(projMatrix.data());
+	glMatrixMode(GL_MODELVIEW);
+	glPushMatrix();
+	glLoadMatrixf(viewMatrix.data());
+
+	glBindFramebuffer(GL_FRAMEBUFFER, fbo);
+	glViewport(0, 0, width, height);
+	glEnable(GL_SCISSOR_TEST);
+	glScissor(x0, y0, w, h);
+
+	// Every color must reach the buffer unchanged
+	glDisable(GL_LIGHTING);
+	glDisable(GL_TEXTURE_2D);
+	glDisable(GL_BLEND);
+	glDisable(GL_DITHER);
+	glDisable(GL_MULTISAMPLE);
+	glDisable(GL_ALPHA_TEST);
+	glDisable(GL_FOG);
+	glShadeModel(GL_FLAT);
+
+	glEnable(GL_DEPTH_TEST);
+	glDepthFunc(GL_LEQUAL);
+	glEnable(GL_CULL_FACE);
+
+	glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
+	glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+	// Occluders write depth only; pushed back slightly so vertices and faces on their surface still win
+	glColorMask(GL_FALSE, GL_FALSE, GL_FALSE, GL_FALSE);
+	glEnable(GL_POLYGON_OFFSET_FILL);
+	glPolygonOffset(1.0f, 1.0f);
+	glBegin(GL_TRIANGLES);
+	for (const auto& mesh : occluders) renderFaces(*mesh);
+	glEnd();
+	glDisable(GL_POLYGON_OFFSET_FILL);
+	glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
+
+	// Targets write their IDs
+	for (size_t i = 0; i < targets.size(); i++) {
+		const auto& mesh = *targets[i];
+		switch (target) {
+			case PickTarget::OBJECT: {
+				idColor(offsets[i]);
+				glBegin(GL_TRIANGLES);
+				renderFaces(mesh);
+				glEnd();
+				break;
+			}
+			case PickTarget::FACE: {
+				glBegin(GL_TRIANGLES);
+				for (size_t t = 0; t < mesh.triangles.size(); t++) {
+					idColor(offsets[i] + static_cast<uint32_t>(t));
+					const auto& tri = *mesh.triangles[t];
+					glVertex3f(tri.v0->position.x, tri.v0->position.y, tri.v0->position.z);
+					glVertex3f(tri.v1->position.x, tri.v1->position.y, tri.v1->position.z);
+					glVertex3f(tri.v2->position.x, tri.v2->position.y, tri.v2->position.z);
+				}
+				glEnd();
+				break;
+			}
+			case PickTarget::VERTEX: {
+				glPointSize(PICK_POINT_SIZE);
+				glBegin(GL_POINTS);
+				for (size_t v = 0; v < mesh.vertices.size(); v++) {
+					idColor(offsets[i] + static_cast<uint32_t>(v));
+					const auto& p = mesh.vertices[v]->position;
+					glVertex3f(p.x, p.y, p.z);
+				}
+				glEnd();
+				break;
+			}
+		}
+	}
+
+	// Read the window back into client memory
+	vector<uint8_t> pixels(static_cast<size_t>(w) * h * 4);
+	glPixelStorei(GL_PACK_ALIGNMENT, 1);
+	glReadPixels(x0, y0, w, h, GL_RGBA, GL_UNSIGNED_BYTE, pixels.data());
+
+	glBindFramebuffer(GL_FRAMEBUFFER, 0);
+	glMatrixMode(GL_PROJECTION);
+	glPopMatrix();
+	glMatrixMode(GL_MODELVIEW);
+	glPopMatrix();
+	glPopAttrib();
+
+	vector<uint32_t> ids(static_cast<size_t>(w) * h);
+	for (size_t i = 0; i < ids.size(); i++) {
+		ids[i] = decodeID(&pixels[i * 4]);
+	}
+	return ids;
+}
+
+
+/** (Re-)allocate the attachments if the requested size differs from the current one */
+void PickingBuffer::resize(const int w, const int h) {
+	if (w == width && h == height) return;
+	release();
+
+	width  = w;
+	height = h;
+
+	glGenRenderbuffers(1, &colorBuffer);
+	glBindRenderbuffer(GL_RENDERBUFFER, colorBuffer);
+	glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, width, height);
+
+	glGenRenderbuffers(1, &depthBuffer);
+	glBindRenderbuffer(GL_RENDERBUFFER, depthBuffer);
+	glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, width, height);
+
+	glGenFramebuffers(1, &fbo);
+	glBindFramebuffer(GL_FRAMEBUFFER, fbo);
+	glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, colorBuffer);
+	glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, depthBuffer);
+
+	if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE) {
+		glBindFramebuffer(GL_FRAMEBUFFER, 0);
+		throw runtime_error("Picking framebuffer is incomplete");
+	}
+
+	glBindRenderbuffer(GL_RENDERBUFFER, 0);
+	glBindFramebuffer(GL_FRAMEBUFFER, 0);
+}
+
+void PickingBuffer::release() {
+	if (fbo)		 glDeleteFramebuffers(1, &fbo);
+	if (colorBuffer) glDeleteRenderbuffers(1, &colorBuffer);
+	if (depthBuffer) glDeleteRenderbuffers(1, &depthBuffer);
+
+	fbo = colorBuffer = depthBuffer = 0;
+	width = height = 0;
+}
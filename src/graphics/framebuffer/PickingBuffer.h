@@ -0,0 +1,106 @@
+#pragma once
+
+using namespace std;
+
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <vector>
+
+#include <GL/glew.h>
+
+class Mesh;
+
+
+/** What the IDs rendered into the PickingBuffer refer to */
+enum class PickTarget {
+	OBJECT,		// Meshes
+	FACE,		// Triangles of the Meshes
+	VERTEX		// Vertices of the Meshes
+};
+
+struct PickResult {
+	int mesh;		// Index into the target Meshes
+	int element;	// Triangle or Vertex index within the Mesh (-1 for PickTarget::OBJECT)
+};
+
+
+/**
+ * Offscreen ID buffer for occlusion-aware picking on the GPU.
+ *
+ * The target Meshes are rendered with a unique 32-bit ID per object, triangle or vertex
+ * into a small scissored window around the cursor, on top of the depth of all occluders.
+ * The window is read back directly and the ID closest to its center wins, so the cost depends
+ * on the pixel count rather than on the complexity of the scene. Picks answer a click right away,
+ * so the read has to wait for the GPU either way; a pixel buffer object would only add a copy.
+ * Region picks render the bounding rectangle of the region instead and report every ID seen in it.
+ *
+ * The fixed-function pipeline can't write to integer color targets, so IDs are packed into
+ * an RGBA8 target instead, with lighting, texturing, blending and dithering disabled so
+ * every byte survives exactly.
+ */
+class PickingBuffer {
+public:
+	PickingBuffer() = default;
+	~PickingBuffer();
+
+	PickingBuffer(const PickingBuffer&) = delete;
+	PickingBuffer& operator=(const PickingBuffer&) = delete;
+
+	/**
+	 * Pick within radius pixels of (x, y) (window coordinates, origin top left).
+	 * Occluders only contribute depth; targets are usually also part of them.
+	 */
+	[[nodiscard]] optional<PickResult> pick(
+		const vector<shared_ptr<Mesh>> &targets,
+		const vector<shared_ptr<Mesh>> &occluders,
+		PickTarget target,
+		int x, int y, int radius,
+		const array<int, 4> &viewport,
+		const array<float, 16> &viewMatrix,
+		const array<float, 16> &projMatrix
+	);
+
+	/**
+	 * Every element with at least one visible pixel in the rectangle (window coordinates, inclusive)
+	 * for which inside(x, y) holds, in the same coordinates.
+	 */
+	[[nodiscard]] vector<PickResult> pickRegion(
+		const vector<shared_ptr<Mesh>> &targets,
+		const vector<shared_ptr<Mesh>> &occluders,
+		PickTarget target,
+		int left, int top, int right, int bottom,
+		const function<bool(int, int)> &inside,
+		const array<int, 4> &viewport,
+		const array<float, 16> &viewMatrix,
+		const array<float, 16> &projMatrix
+	);
+
+	[[nodiscard]] static bool isSupported();
+
+private:
+	int width  = 0;
+	int height = 0;
+
+	GLuint fbo			= 0;
+	GLuint colorBuffer	= 0;
+	GLuint depthBuffer	= 0;
+
+	[[nodiscard]] vector<uint32_t> render(
+		const vector<shared_ptr<Mesh>> &targets,
+		const vector<shared_ptr<Mesh>> &occluders,
+		PickTarget target,
+		const vector<uint32_t> &offsets,
+		int x0, int y0, int w, int h,
+		const array<float, 16> &viewMatrix,
+		const array<float, 16> &projMatrix
+	);
+
+	[[nodiscard]] static vector<uint32_t> elementOffsets(const vector<shared_ptr<Mesh>> &targets, PickTarget target);
+	[[nodiscard]] static optional<PickResult> decode(uint32_t id, const vector<uint32_t> &offsets, PickTarget target);
+
+	void resize(int w, int h);
+	void release();
+};
@@ -1,28 +1,30 @@
 #include "Texture.h"
 
-#include <stdexcept>
+#include "TextureLoader.h"
+#include "TextureRegistry.h"
 
-#define STB_IMAGE_IMPLEMENTATION
-#include "../libs/stb_image.h"
 
+TextureStorage::TextureStorage(const GLuint id, const size_t bytes, const uint64_t contentHash)
+	: id(id), bytes(bytes), contentHash(contentHash), lastUsed(TextureRegistry::getFrame()) {
+	TextureRegistry::residentBytes += bytes;
+}
+
+TextureStorage::~TextureStorage() {
+	TextureRegistry::residentBytes -= bytes;
+	if (TextureRegistry::contextAlive) glDeleteTextures(1, &id);
+}
 
-Texture::Texture(const string &filename) : filename(filename) { // NOLINT(*-pro-type-member-init)
-	glGenTextures(1, &id);
-	glBindTexture(GL_TEXTURE_2D, id);
 
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-	glTexParameteri(GL_TEXTURE_2D, GL_GENERATE_MIPMAP, GL_TRUE);
+Texture::Texture(const string &filename) : filename(filename) {}
 
-	int width, height, channels;
-	stbi_set_flip_vertically_on_load(1);
-	unsigned char *data = stbi_load(filename.c_str(), &width, &height, &channels, 0);
-	if (!data) {
-		stbi_image_free(data);
-		throw runtime_error("Failed to load texture " + filename);
+void Texture::bind() {
+	if (storage) {
+		storage->lastUsed = TextureRegistry::getFrame();
+		glBindTexture(GL_TEXTURE_2D, storage->id);
+		return;
 	}
-	glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, width, height, 0, GL_RGB, GL_UNSIGNED_BYTE, data);
-	stbi_image_free(data);
+
+	// Not streamed in yet or evicted: draw with the placeholder and (re)load the image
+	if (!loading && !failed) TextureLoader::enqueue(shared_from_this());
+	glBindTexture(GL_TEXTURE_2D, TextureRegistry::placeholder());
 }
@@ -2,20 +2,53 @@
 
 using namespace std;
 
+#include <cstdint>
+#include <memory>
 #include <string>
 
 #define GLFW_INCLUDE_GLEXT
 #include <GL/glew.h>
 
 
-class Texture {
+/**
+ * GL texture object holding a fully uploaded image.
+ * Shared by all Textures with identical content; the GL object is deleted with the last reference.
+ */
+struct TextureStorage {
+	GLuint id;
+	size_t bytes;			// Estimated VRAM footprint
+	uint64_t contentHash;	// Hash of the source file
+	uint64_t lastUsed = 0;	// Frame of the last bind, for LRU eviction
+
+	TextureStorage(GLuint id, size_t bytes, uint64_t contentHash);
+	~TextureStorage();
+
+	TextureStorage(const TextureStorage&) = delete;
+	TextureStorage& operator=(const TextureStorage&) = delete;
+};
+
+
+/**
+ * 2D texture whose image data is streamed in by the TextureLoader.
+ * Until the upload has finished (or after the image was evicted from VRAM), a 1x1 white
+ * placeholder is bound instead. Textures are handed out by the TextureRegistry.
+ */
+class Texture : public enable_shared_from_this<Texture> {
 public:
 	explicit Texture(const string &filename);
 
-	~Texture() = default;
+	/** Bind the image (or the placeholder) to GL_TEXTURE_2D; streams evicted images back in */
+	void bind();
 
-	GLuint id{};
+	[[nodiscard]] const string& getFilename() const { return filename; }
+	[[nodiscard]] bool isReady() const { return storage != nullptr; }
 
 private:
+	friend class TextureLoader;
+	friend class TextureRegistry;
+
 	string filename;
+	shared_ptr<TextureStorage> storage;	// Set by the TextureLoader, reset by the TextureRegistry on eviction
+	bool loading = false;				// Queued in the TextureLoader
+	bool failed = false;				// The file couldn't be loaded, don't retry
 };
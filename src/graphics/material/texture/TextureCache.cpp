@@ -0,0 +1,142 @@
+#include "TextureCache.h"
+
+#include <bit>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <thread>
+
+constexpr char CACHE_MAGIC[8] = {'Q', 'T', 'X', '2', '\r', '\n', '\x1A', '\n'};
+constexpr uint32_t CACHE_MAX_SIZE = 1 << 16;	// Largest texture edge a cache entry may claim
+
+
+struct CacheHeader {
+	char magic[8];
+	uint32_t version;
+	uint32_t format;
+	uint32_t width;
+	uint32_t height;
+	uint32_t levelCount;
+	uint32_t reserved;
+	uint64_t sourceHash;
+};
+
+struct LevelIndex {
+	uint64_t offset;
+	uint64_t size;
+};
+
+
+/** 64-bit FNV-1a */
+uint64_t TextureCache::hash(const vector<uint8_t>& bytes) {
+	uint64_t h = 0xCBF29CE484222325ull;
+	for (const uint8_t b : bytes) {
+		h ^= b;
+		h *= 0x100000001B3ull;
+	}
+	return h;
+}
+
+string TextureCache::path(const uint64_t sourceHash, const string& dir) {
+	ostringstream out;
+	out << dir << "/" << hex << setw(16) << setfill('0') << sourceHash << ".qtx";
+	return out.str();
+}
+
+vector<uint8_t> TextureCache::readFile(const string& filename) {
+	ifstream file(filename, ios::binary | ios::ate);
+	if (!file) return {};
+
+	vector<uint8_t> bytes(file.tellg());
+	file.seekg(0);
+	file.read(reinterpret_cast<char*>(bytes.data()), static_cast<streamsize>(bytes.size()));
+	return bytes;
+}
+
+
+optional<CompressedImage> TextureCache::read(const uint64_t sourceHash, const string& dir) {
+	ifstream file(path(sourceHash, dir), ios::binary);
+	if (!file) return nullopt;
+
+	CacheHeader header{};
+	if (!file.read(reinterpret_cast<char*>(&header), sizeof(header))) return nullopt;
+
+	// Reject files from other encoder versions or hash collisions in the file name
+	if (memcmp(header.magic, CACHE_MAGIC, sizeof(CACHE_MAGIC)) != 0
+		|| header.version != TEXTURE_CACHE_VERSION
+		|| header.sourceHash != sourceHash) {
+		return nullopt;
+	}
+
+	// The header is untrusted, so it's checked before anything is sized from it (a corrupt entry is a miss)
+	const auto format = static_cast<BlockFormat>(header.format);
+	if ((format != BlockFormat::BC1 && format != BlockFormat::BC3)
+		|| header.width == 0 || header.width > CACHE_MAX_SIZE
+		|| header.height == 0 || header.height > CACHE_MAX_SIZE
+		|| header.levelCount == 0 || header.levelCount > bit_width(max(header.width, header.height))) {
+		return nullopt;
+	}
+
+	vector<LevelIndex> index(header.levelCount);
+	if (!file.read(reinterpret_cast<char*>(index.data()), static_cast<streamsize>(index.size() * sizeof(LevelIndex)))) return nullopt;
+
+	CompressedImage image;
+	image.format = format;
+
+	int w = static_cast<int>(header.width);
+	int h = static_cast<int>(header.height);
+	for (const auto& [offset, size] : index) {
+		if (size != TextureCompressor::levelSize(image.format, w, h)) return nullopt;
+
+		MipLevel level{w, h, vector<uint8_t>(size)};
+		file.seekg(static_cast<streamoff>(offset));
+		if (!file.read(reinterpret_cast<char*>(level.data.data()), static_cast<streamsize>(size))) return nullopt;
+
+		image.levels.emplace_back(move(level));
+		w = max(1, w / 2);
+		h = max(1, h / 2);
+	}
+
+	return image;
+}
+
+bool TextureCache::write(const uint64_t sourceHash, const CompressedImage& image, const string& dir) {
+	error_code error;
+	filesystem::create_directories(dir, error);
+
+	// Write to a temporary file first so a crash never leaves a truncated cache entry behind
+	const string target = path(sourceHash, dir);
+	const string temp = target + "." + to_string(std::hash<thread::id>()(this_thread::get_id())) + ".tmp";
+	{
+		ofstream file(temp, ios::binary | ios::trunc);
+		if (!file) return false;
+
+		CacheHeader header{};
+		memcpy(header.magic, CACHE_MAGIC, sizeof(CACHE_MAGIC));
+		header.version	  = TEXTURE_CACHE_VERSION;
+		header.format	  = static_cast<uint32_t>(image.format);
+		header.width	  = static_cast<uint32_t>(image.width());
+		header.height	  = static_cast<uint32_t>(image.height());
+		header.levelCount = static_cast<uint32_t>(image.levels.size());
+		header.sourceHash = sourceHash;
+		file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+		uint64_t offset = sizeof(CacheHeader) + image.levels.size() * sizeof(LevelIndex);
+		for (const auto& level : image.levels) {
+			const LevelIndex entry{offset, level.data.size()};
+			file.write(reinterpret_cast<const char*>(&entry), sizeof(entry));
+			offset += level.data.size();
+		}
+
+		for (const auto& level : image.levels) {
+			file.write(reinterpret_cast<const char*>(level.data.data()), static_cast<streamsize>(level.data.size()));
+		}
+
+		if (!file) return false;
+	}
+
+	filesystem::rename(temp, target, error);
+	return !error;
+}
@@ -0,0 +1,32 @@
+#pragma once
+
+using namespace std;
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "TextureCompressor.h"
+
+// Constants
+constexpr auto TEXTURE_CACHE_DIR			= "../resources/cache/textures";
+constexpr uint32_t TEXTURE_CACHE_VERSION	= 1;	// Bump when the encoder output changes to invalidate old files
+
+
+/**
+ * On-disk cache of block-compressed, mipmapped textures, keyed by a hash of the source
+ * file's content. Files use a KTX2-style layout: a fixed header followed by an index of
+ * (offset, size) pairs, one per mip level, and the level data.
+ */
+class TextureCache {
+public:
+	static uint64_t hash(const vector<uint8_t>& bytes);
+
+	static string path(uint64_t sourceHash, const string& dir = TEXTURE_CACHE_DIR);
+
+	static optional<CompressedImage> read(uint64_t sourceHash, const string& dir = TEXTURE_CACHE_DIR);
+	static bool write(uint64_t sourceHash, const CompressedImage& image, const string& dir = TEXTURE_CACHE_DIR);
+
+	static vector<uint8_t> readFile(const string& filename);
+};
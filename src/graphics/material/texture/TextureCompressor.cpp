@@ -0,0 +1,244 @@
+#include "TextureCompressor.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+
+#include "jobs/JobSystem.h"
+
+
+/** Quantize an 8-bit RGB color to 5:6:5 */
+static uint16_t toRGB565(const float r, const float g, const float b) {
+	const auto r5 = static_cast<uint16_t>(clamp(lround(r * 31.0f / 255.0f), 0L, 31L));
+	const auto g6 = static_cast<uint16_t>(clamp(lround(g * 63.0f / 255.0f), 0L, 63L));
+	const auto b5 = static_cast<uint16_t>(clamp(lround(b * 31.0f / 255.0f), 0L, 31L));
+	return static_cast<uint16_t>(r5 << 11 | g6 << 5 | b5);
+}
+
+/** Expand a 5:6:5 color back to 8-bit RGB the way the GPU does */
+static array<int, 3> fromRGB565(const uint16_t c) {
+	const int r5 = c >> 11 & 0x1F;
+	const int g6 = c >> 5 & 0x3F;
+	const int b5 = c & 0x1F;
+	return {r5 << 3 | r5 >> 2, g6 << 2 | g6 >> 4, b5 << 3 | b5 >> 2};
+}
+
+
+size_t TextureCompressor::blockSize(const BlockFormat format) {
+	return format == BlockFormat::BC1 ? 8 : 16;
+}
+
+size_t TextureCompressor::levelSize(const BlockFormat format, const int width, const int height) {
+	const size_t blocksX = (width + 3) / 4;
+	const size_t blocksY = (height + 3) / 4;
+	return blocksX * blocksY * blockSize(format);
+}
+
+
+CompressedImage TextureCompressor::compress(const uint8_t* pixels, const int width, const int height, const int channels) {
+	CompressedImage image;
+	image.format = channels == 2 || channels == 4 ? BlockFormat::BC3 : BlockFormat::BC1;
+
+	auto rgba = toRGBA(pixels, width, height, channels);
+	int w = width, h = height;
+
+	while (true) {
+		image.levels.push_back({w, h, compressLevel(rgba, w, h, image.format)});
+		if (w == 1 && h == 1) break;
+
+		rgba = downsample(rgba, w, h);
+		w = max(1, w / 2);
+		h = max(1, h / 2);
+	}
+
+	return image;
+}
+
+vector<uint8_t> TextureCompressor::toRGBA(const uint8_t* pixels, const int width, const int height, const int channels) {
+	const size_t count = static_cast<size_t>(width) * height;
+	vector<uint8_t> rgba(count * 4);
+
+	for (size_t i = 0; i < count; i++) {
+		const uint8_t* p = pixels + i * channels;
+		uint8_t* q = rgba.data() + i * 4;
+		switch (channels) {
+			case 1:  q[0] = q[1] = q[2] = p[0]; q[3] = 255;  break;
+			case 2:  q[0] = q[1] = q[2] = p[0]; q[3] = p[1]; break;
+			case 3:  q[0] = p[0]; q[1] = p[1]; q[2] = p[2]; q[3] = 255; break;
+			default: memcpy(q, p, 4); break;
+		}
+	}
+	return rgba;
+}
+
+/** Halve an RGBA8 image with a 2x2 box filter (odd edges are clamped) */
+vector<uint8_t> TextureCompressor::downsample(const vector<uint8_t>& rgba, const int width, const int height) {
+	const int w = max(1, width / 2);
+	const int h = max(1, height / 2);
+	vector<uint8_t> result(static_cast<size_t>(w) * h * 4);
+
+	for (int y = 0; y < h; y++) {
+		const int y0 = min(2 * y, height - 1);
+		const int y1 = min(2 * y + 1, height - 1);
+		for (int x = 0; x < w; x++) {
+			const int x0 = min(2 * x, width - 1);
+			const int x1 = min(2 * x + 1, width - 1);
+			for (int c = 0; c < 4; c++) {
+				const int sum = rgba[(static_cast<size_t>(y0) * width + x0) * 4 + c]
+							  + rgba[(static_cast<size_t>(y0) * width + x1) * 4 + c]
+							  + rgba[(static_cast<size_t>(y1) * width + x0) * 4 + c]
+							  + rgba[(static_cast<size_t>(y1) * width + x1) * 4 + c];
+				result[(static_cast<size_t>(y) * w + x) * 4 + c] = static_cast<uint8_t>((sum + 2) / 4);
+			}
+		}
+	}
+	return result;
+}
+
+vector<uint8_t> TextureCompressor::compressLevel(const vector<uint8_t>& rgba, const int width, const int height, const BlockFormat format) {
+	const int blocksX = (width + 3) / 4;
+	const int blocksY = (height + 3) / 4;
+	const size_t size = blockSize(format);
+	vector<uint8_t> result(levelSize(format, width, height));
+
+	// Rows of blocks are independent, so large levels are split across threads
+	JobSystem::parallelFor(blocksY, COMPRESS_PARALLEL_THRESHOLD, [&](const size_t firstRow, const size_t lastRow) {
+		uint8_t block[64];
+		for (int by = static_cast<int>(firstRow); by < static_cast<int>(lastRow); by++) {
+			for (int bx = 0; bx < blocksX; bx++) {
+				// Gather the 4x4 block, clamping at the image border
+				for (int py = 0; py < 4; py++) {
+					const int y = min(by * 4 + py, height - 1);
+					for (int px = 0; px < 4; px++) {
+						const int x = min(bx * 4 + px, width - 1);
+						memcpy(block + (py * 4 + px) * 4, rgba.data() + (static_cast<size_t>(y) * width + x) * 4, 4);
+					}
+				}
+
+				uint8_t* out = result.data() + (static_cast<size_t>(by) * blocksX + bx) * size;
+				if (format == BlockFormat::BC3) {
+					encodeAlphaBlock(block, out);
+					out += 8;
+				}
+				encodeColorBlock(block, out);
+			}
+		}
+	});
+	return result;
+}
+
+/**
+ * Encode the color part of a block (BC1 layout).
+ * The endpoints are the extremes of the pixels projected onto their principal axis.
+ */
+void TextureCompressor::encodeColorBlock(const uint8_t block[64], uint8_t* out) {
+	// Mean color
+	float mean[3] = {0, 0, 0};
+	for (int i = 0; i < 16; i++) {
+		for (int c = 0; c < 3; c++) mean[c] += block[i * 4 + c];
+	}
+	for (float& m : mean) m /= 16.0f;
+
+	// Covariance matrix
+	float cov[6] = {0, 0, 0, 0, 0, 0};	// xx, xy, xz, yy, yz, zz
+	for (int i = 0; i < 16; i++) {
+		const float r = block[i * 4] - mean[0];
+		const float g = block[i * 4 + 1] - mean[1];
+		const float b = block[i * 4 + 2] - mean[2];
+		cov[0] += r * r; cov[1] += r * g; cov[2] += r * b;
+		cov[3] += g * g; cov[4] += g * b; cov[5] += b * b;
+	}
+
+	// Principal axis by power iteration
+	float axis[3] = {1.0f, 1.0f, 1.0f};
+	for (int it = 0; it < 4; it++) {
+		const float x = cov[0] * axis[0] + cov[1] * axis[1] + cov[2] * axis[2];
+		const float y = cov[1] * axis[0] + cov[3] * axis[1] + cov[4] * axis[2];
+		const float z = cov[2] * axis[0] + cov[4] * axis[1] + cov[5] * axis[2];
+		const float len = max({abs(x), abs(y), abs(z)});
+		if (len < 1e-6f) break;	// Uniform block
+		axis[0] = x / len; axis[1] = y / len; axis[2] = z / len;
+	}
+
+	// Project onto the axis to find the endpoints
+	float minT = 0.0f, maxT = 0.0f;
+	const float axisLen2 = axis[0] * axis[0] + axis[1] * axis[1] + axis[2] * axis[2];
+	for (int i = 0; i < 16; i++) {
+		const float t = ((block[i * 4] - mean[0]) * axis[0]
+					   + (block[i * 4 + 1] - mean[1]) * axis[1]
+					   + (block[i * 4 + 2] - mean[2]) * axis[2]) / axisLen2;
+		minT = min(minT, t);
+		maxT = max(maxT, t);
+	}
+
+	uint16_t c0 = toRGB565(mean[0] + axis[0] * maxT, mean[1] + axis[1] * maxT, mean[2] + axis[2] * maxT);
+	uint16_t c1 = toRGB565(mean[0] + axis[0] * minT, mean[1] + axis[1] * minT, mean[2] + axis[2] * minT);
+	if (c0 < c1) swap(c0, c1);	// c0 > c1 selects the 4-color mode
+
+	// Build the palette the GPU will reconstruct
+	const auto e0 = fromRGB565(c0);
+	const auto e1 = fromRGB565(c1);
+	int palette[4][3];
+	for (int c = 0; c < 3; c++) {
+		palette[0][c] = e0[c];
+		palette[1][c] = e1[c];
+		palette[2][c] = (2 * e0[c] + e1[c]) / 3;
+		palette[3][c] = (e0[c] + 2 * e1[c]) / 3;
+	}
+
+	// Pick the closest palette entry for every pixel
+	uint32_t indices = 0;
+	if (c0 != c1) {
+		for (int i = 0; i < 16; i++) {
+			int best = 0, bestDist = INT32_MAX;
+			for (int p = 0; p < 4; p++) {
+				const int dr = block[i * 4]		- palette[p][0];
+				const int dg = block[i * 4 + 1] - palette[p][1];
+				const int db = block[i * 4 + 2] - palette[p][2];
+				if (const int dist = dr * dr + dg * dg + db * db; dist < bestDist) {
+					bestDist = dist;
+					best = p;
+				}
+			}
+			indices |= static_cast<uint32_t>(best) << (2 * i);
+		}
+	}
+
+	out[0] = c0 & 0xFF; out[1] = c0 >> 8;
+	out[2] = c1 & 0xFF; out[3] = c1 >> 8;
+	for (int i = 0; i < 4; i++) out[4 + i] = indices >> (8 * i) & 0xFF;
+}
+
+/** Encode the alpha part of a block (BC3 layout, 8-value interpolation) */
+void TextureCompressor::encodeAlphaBlock(const uint8_t block[64], uint8_t* out) {
+	int a0 = 0, a1 = 255;
+	for (int i = 0; i < 16; i++) {
+		a0 = max(a0, static_cast<int>(block[i * 4 + 3]));
+		a1 = min(a1, static_cast<int>(block[i * 4 + 3]));
+	}
+
+	int palette[8] = {a0, a1};
+	for (int i = 1; i <= 6; i++) {
+		palette[i + 1] = ((7 - i) * a0 + i * a1) / 7;
+	}
+
+	uint64_t indices = 0;
+	if (a0 != a1) {
+		for (int i = 0; i < 16; i++) {
+			const int a = block[i * 4 + 3];
+			int best = 0, bestDist = INT32_MAX;
+			for (int p = 0; p < 8; p++) {
+				if (const int dist = abs(a - palette[p]); dist < bestDist) {
+					bestDist = dist;
+					best = p;
+				}
+			}
+			indices |= static_cast<uint64_t>(best) << (3 * i);
+		}
+	}
+
+	out[0] = static_cast<uint8_t>(a0);
+	out[1] = static_cast<uint8_t>(a1);
+	for (int i = 0; i < 6; i++) out[2 + i] = indices >> (8 * i) & 0xFF;
+}
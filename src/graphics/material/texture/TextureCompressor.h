@@ -0,0 +1,51 @@
+#pragma once
+
+using namespace std;
+
+#include <cstdint>
+#include <vector>
+
+// Constants
+constexpr size_t COMPRESS_PARALLEL_THRESHOLD = 64;	// Rows of blocks in a mip level before it's compressed on all threads
+
+
+/** GPU block compression formats (4x4 pixel blocks) */
+enum class BlockFormat : uint32_t {
+	BC1 = 1,	// RGB, 8 bytes per block (DXT1)
+	BC3 = 3		// RGBA, 16 bytes per block (DXT5)
+};
+
+struct MipLevel {
+	int width, height;
+	vector<uint8_t> data;
+};
+
+/** Block-compressed image with a full mip chain */
+struct CompressedImage {
+	BlockFormat format = BlockFormat::BC1;
+	vector<MipLevel> levels;
+
+	[[nodiscard]] int width()  const { return levels.empty() ? 0 : levels[0].width; }
+	[[nodiscard]] int height() const { return levels.empty() ? 0 : levels[0].height; }
+};
+
+
+/**
+ * CPU-side BC1/BC3 encoder. Images are converted to RGBA8, mipmapped down to 1x1
+ * with a box filter and every level is compressed block by block.
+ */
+class TextureCompressor {
+public:
+	static CompressedImage compress(const uint8_t* pixels, int width, int height, int channels);
+
+	static size_t blockSize(BlockFormat format);
+	static size_t levelSize(BlockFormat format, int width, int height);
+
+private:
+	static vector<uint8_t> toRGBA(const uint8_t* pixels, int width, int height, int channels);
+	static vector<uint8_t> downsample(const vector<uint8_t>& rgba, int width, int height);
+	static vector<uint8_t> compressLevel(const vector<uint8_t>& rgba, int width, int height, BlockFormat format);
+
+	static void encodeColorBlock(const uint8_t block[64], uint8_t* out);
+	static void encodeAlphaBlock(const uint8_t block[64], uint8_t* out);
+};
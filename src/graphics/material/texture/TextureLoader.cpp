@@ -0,0 +1,373 @@
+#include "TextureLoader.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+
+#include "Texture.h"
+#include "TextureCache.h"
+#include "TextureRegistry.h"
+#include "viewport/Redraw.h"
+
+#define STB_IMAGE_IMPLEMENTATION
+#include "../libs/stb_image.h"
+
+
+/** GL pixel format for a given stb_image channel count */
+static GLenum pixelFormat(const int channels) {
+	switch (channels) {
+		case 1:  return GL_LUMINANCE;
+		case 2:  return GL_LUMINANCE_ALPHA;
+		case 3:  return GL_RGB;
+		default: return GL_RGBA;
+	}
+}
+
+static GLint internalFormat(const int channels) {
+	switch (channels) {
+		case 1:  return GL_LUMINANCE8;
+		case 2:  return GL_LUMINANCE8_ALPHA8;
+		case 3:  return GL_RGB8;
+		default: return GL_RGBA8;
+	}
+}
+
+static GLenum compressedFormat(const BlockFormat format) {
+	return format == BlockFormat::BC1
+		? GL_COMPRESSED_RGB_S3TC_DXT1_EXT
+		: GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
+}
+
+
+size_t DecodedImage::byteSize() const {
+	if (isCompressed()) {
+		size_t size = 0;
+		for (const auto& level : compressed.levels) size += level.data.size();
+		return size;
+	}
+	const int bytesPerPixel = channels == 3 ? 4 : channels;	// Drivers pad RGB to RGBA
+	return static_cast<size_t>(width) * height * bytesPerPixel * 4 / 3;
+}
+
+
+void TextureLoader::start() {
+	{
+		lock_guard lock(queueMutex);
+		if (running) return;
+		running = true;
+	}
+
+	stbi_set_flip_vertically_on_load(1);	// Global setting, so set it before any decoding happens
+
+	if (GLEW_VERSION_2_1 || GLEW_ARB_pixel_buffer_object) {
+		glGenBuffers(1, &pbo);
+	}
+	compressionSupported = GLEW_EXT_texture_compression_s3tc;
+}
+
+void TextureLoader::stop() {
+	{
+		lock_guard lock(queueMutex);
+		running = false;
+		decodeQueue.clear();
+	}
+
+	// Images being decoded right now are finished, then the jobs see running and return.
+	// The handles are taken out first so that waiting doesn't hold the lock
+	vector<JobHandle> jobs;
+	{
+		lock_guard lock(decodeJobsMutex);
+		jobs.swap(decodeJobs);
+	}
+	for (const auto& job : jobs) {
+		try {
+			JobSystem::wait(job);
+		} catch (const exception& e) {
+			cerr << "Texture decoding failed: " << e.what() << endl;
+		}
+	}
+
+	decodedImages.clear();
+	for (const auto& image : uploads) {
+		if (image.target) glDeleteTextures(1, &image.target);
+	}
+	uploads.clear();
+
+	if (pbo) {
+		glDeleteBuffers(1, &pbo);
+		pbo = 0;
+	}
+}
+
+void TextureLoader::enqueue(const shared_ptr<Texture>& texture) {
+	start();
+
+	// Up to TEXTURE_DECODE_JOBS_MAX jobs drain the queue; a new one only starts if fewer are running
+	bool spawn = false;
+	{
+		lock_guard lock(queueMutex);
+		decodeQueue.emplace_back(texture);
+		if (decoders < TEXTURE_DECODE_JOBS_MAX) {
+			decoders++;
+			spawn = true;
+		}
+	}
+	if (spawn) {
+		lock_guard lock(decodeJobsMutex);
+		erase_if(decodeJobs, [](const JobHandle& job) { return job->finished.load(); });
+		decodeJobs.emplace_back(JobSystem::submit(decodeLoop));
+	}
+
+	// Keep the Viewport rendering (and thus uploading) until the Texture is done
+	texture->loading = true;
+	pending++;
+	Redraw::beginAnimation();
+}
+
+bool TextureLoader::isBusy() {
+	return pending > 0;
+}
+
+
+/** Decode job: decode queued image files into memory until the queue is empty */
+void TextureLoader::decodeLoop() {
+	while (true) {
+		weak_ptr<Texture> weakTexture;
+		{
+			lock_guard lock(queueMutex);
+			if (!running || decodeQueue.empty()) {
+				decoders--;
+				return;
+			}
+
+			weakTexture = decodeQueue.front();
+			decodeQueue.pop_front();
+		}
+
+		// Copy the filename so the Texture isn't kept alive during decoding
+		string filename;
+		if (const auto texture = weakTexture.lock()) {
+			filename = texture->getFilename();
+		}
+
+		auto image = decode(weakTexture, filename);
+
+		{
+			lock_guard lock(queueMutex);
+			decodedImages.emplace_back(move(image));
+		}
+		Redraw::request();
+	}
+}
+
+
+/**
+ * Decode job: Load the block-compressed image from the cache, or decode the source
+ * file (and compress it if the GPU supports S3TC, writing the result back to the cache).
+ */
+DecodedImage TextureLoader::decode(const weak_ptr<Texture>& texture, const string& filename) {
+	DecodedImage image;
+	image.texture = texture;
+	if (filename.empty()) return image;
+
+	const auto bytes = TextureCache::readFile(filename);
+	if (bytes.empty()) {
+		cerr << "Failed to load texture " << filename << ": file not found" << endl;
+		return image;
+	}
+
+	const uint64_t sourceHash = TextureCache::hash(bytes);
+	image.contentHash = sourceHash;
+	if (compressionSupported) {
+		if (auto cached = TextureCache::read(sourceHash)) {
+			image.compressed = move(*cached);
+			return image;
+		}
+	}
+
+	image.data = {
+		stbi_load_from_memory(bytes.data(), static_cast<int>(bytes.size()), &image.width, &image.height, &image.channels, 0),
+		stbi_image_free
+	};
+	if (!image.data) {
+		cerr << "Failed to load texture " << filename << ": " << stbi_failure_reason() << endl;
+		return image;
+	}
+
+	if (compressionSupported) {
+		image.compressed = TextureCompressor::compress(image.data.get(), image.width, image.height, image.channels);
+		image.data.reset();
+
+		if (!TextureCache::write(sourceHash, image.compressed)) {
+			cerr << "Failed to write texture cache entry for " << filename << endl;
+		}
+	}
+
+	return image;
+}
+
+
+/**
+ * Render thread: Move newly decoded images into the upload queue and upload
+ * chunks of rows until the time budget for this frame is used up.
+ */
+void TextureLoader::update() {
+	{
+		lock_guard lock(queueMutex);
+		while (!decodedImages.empty()) {
+			uploads.emplace_back(move(decodedImages.front()));
+			decodedImages.pop_front();
+		}
+	}
+
+	const auto start = chrono::steady_clock::now();
+	auto elapsed = [&start] {
+		return chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+	};
+
+	while (!uploads.empty() && elapsed() < TEXTURE_UPLOAD_BUDGET) {
+		auto& image = uploads.front();
+
+		const bool alive = !image.texture.expired();
+		if (!alive || !image.isValid()) {
+			finish(image, nullptr);
+			uploads.pop_front();
+			continue;
+		}
+
+		// Identical content is already resident under another path, share its GL texture
+		if (!image.target) {
+			if (auto storage = TextureRegistry::find(image.contentHash)) {
+				finish(image, move(storage));
+				uploads.pop_front();
+				continue;
+			}
+		}
+
+		if (uploadChunk(image)) {
+			auto storage = TextureRegistry::adopt(image.target, image.byteSize(), image.contentHash);
+			image.target = 0;
+			finish(image, move(storage));
+			uploads.pop_front();
+		}
+	}
+}
+
+/** Upload the next chunk of an image; returns true once the whole image is on the GPU */
+bool TextureLoader::uploadChunk(DecodedImage& image) {
+	// Stream into a separate texture object so the placeholder stays visible until the end
+	if (!image.target) {
+		glGenTextures(1, &image.target);
+		glBindTexture(GL_TEXTURE_2D, image.target);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+	}
+
+	glBindTexture(GL_TEXTURE_2D, image.target);
+	const bool done = image.isCompressed()
+		? uploadCompressedChunk(image)
+		: uploadRawChunk(image);
+	glBindTexture(GL_TEXTURE_2D, 0);
+	return done;
+}
+
+/** Upload rows of uncompressed pixels and build the mip chain on the GPU at the end */
+bool TextureLoader::uploadRawChunk(DecodedImage& image) {
+	const GLenum format = pixelFormat(image.channels);
+	glPixelStorei(GL_UNPACK_ALIGNMENT, 1);	// Rows are tightly packed
+
+	// Allocate storage for the full image on the first chunk
+	if (image.uploadedRows == 0) {
+		glTexImage2D(GL_TEXTURE_2D, 0, internalFormat(image.channels), image.width, image.height, 0, format, GL_UNSIGNED_BYTE, nullptr);
+	}
+
+	const size_t rowSize = static_cast<size_t>(image.width) * image.channels;
+	const int rows = clamp(static_cast<int>(TEXTURE_UPLOAD_CHUNK_SIZE / rowSize), 1, image.height - image.uploadedRows);
+	const unsigned char* source = image.data.get() + rowSize * image.uploadedRows;
+
+	stage(source, rowSize * rows);
+	glTexSubImage2D(GL_TEXTURE_2D, 0, 0, image.uploadedRows, image.width, rows, format, GL_UNSIGNED_BYTE, pbo ? nullptr : source);
+	glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+
+	image.uploadedRows += rows;
+	if (image.uploadedRows < image.height) return false;
+
+	// Build the mip chain and switch to trilinear filtering
+	if (GLEW_VERSION_3_0 || GLEW_ARB_framebuffer_object) {
+		glGenerateMipmap(GL_TEXTURE_2D);
+	} else {
+		glTexParameteri(GL_TEXTURE_2D, GL_GENERATE_MIPMAP, GL_TRUE);
+		glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, 1, 1, format, GL_UNSIGNED_BYTE, image.data.get());	// Triggers generation
+	}
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+	return true;
+}
+
+/** Upload rows of 4x4 blocks of the current mip level; levels are allocated as they are reached */
+bool TextureLoader::uploadCompressedChunk(DecodedImage& image) {
+	const auto& [width, height, data] = image.compressed.levels[image.uploadedLevels];
+	const GLenum format = compressedFormat(image.compressed.format);
+
+	if (image.uploadedRows == 0) {
+		glTexImage2D(GL_TEXTURE_2D, image.uploadedLevels, static_cast<GLint>(format), width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+	}
+
+	const size_t blockRowSize = (width + 3) / 4 * TextureCompressor::blockSize(image.compressed.format);
+	const int blockRows = max(1, static_cast<int>(TEXTURE_UPLOAD_CHUNK_SIZE / blockRowSize));
+	const int rows = min(blockRows * 4, height - image.uploadedRows);
+	const size_t size = (rows + 3) / 4 * blockRowSize;
+	const uint8_t* source = data.data() + image.uploadedRows / 4 * blockRowSize;
+
+	stage(source, size);
+	glCompressedTexSubImage2D(GL_TEXTURE_2D, image.uploadedLevels, 0, image.uploadedRows, width, rows, format, static_cast<GLsizei>(size), pbo ? nullptr : source);
+	glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+
+	image.uploadedRows += rows;
+	if (image.uploadedRows < height) return false;
+
+	// Continue with the next level
+	image.uploadedRows = 0;
+	image.uploadedLevels++;
+	if (image.uploadedLevels < static_cast<int>(image.compressed.levels.size())) return false;
+
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, image.uploadedLevels - 1);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+	return true;
+}
+
+/**
+ * Copy a chunk into the PBO (orphaning its previous storage) so the driver can transfer it
+ * asynchronously. Leaves the PBO bound as unpack buffer; without PBO support this is a no-op
+ * and the subsequent upload reads from client memory.
+ */
+void TextureLoader::stage(const void* source, const size_t size) {
+	if (!pbo) return;
+
+	glBindBuffer(GL_PIXEL_UNPACK_BUFFER, pbo);
+	glBufferData(GL_PIXEL_UNPACK_BUFFER, static_cast<GLsizeiptr>(size), nullptr, GL_STREAM_DRAW);
+	if (void* mapped = glMapBuffer(GL_PIXEL_UNPACK_BUFFER, GL_WRITE_ONLY)) {
+		memcpy(mapped, source, size);
+		glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+	} else {
+		glBufferSubData(GL_PIXEL_UNPACK_BUFFER, 0, static_cast<GLsizeiptr>(size), source);
+	}
+}
+
+/** Hand the uploaded storage to the Texture; without storage the image couldn't be loaded */
+void TextureLoader::finish(DecodedImage& image, shared_ptr<TextureStorage> storage) {
+	if (image.target) {
+		glDeleteTextures(1, &image.target);
+		image.target = 0;
+	}
+
+	if (const auto texture = image.texture.lock()) {
+		texture->failed  = !storage;
+		texture->storage = move(storage);
+		texture->loading = false;
+	}
+
+	pending--;
+	Redraw::endAnimation();
+}
@@ -0,0 +1,95 @@
+#pragma once
+
+using namespace std;
+
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <GL/glew.h>
+
+#include "TextureCompressor.h"
+#include "jobs/JobSystem.h"
+
+class Texture;
+struct TextureStorage;
+
+// Constants
+constexpr int TEXTURE_DECODE_JOBS_MAX		= 4;				// Images decoded at once, which bounds the memory they take up
+constexpr size_t TEXTURE_UPLOAD_CHUNK_SIZE	= 4 * 1024 * 1024;	// Bytes per glTexSubImage2D call
+constexpr double TEXTURE_UPLOAD_BUDGET		= 2.0;				// Time in ms per frame that may be spent uploading
+
+
+/**
+ * Image decoded by a decode job, waiting to be uploaded on the render thread.
+ * Holds either a block-compressed mip chain or, if the GPU can't sample S3TC textures, raw pixels.
+ */
+struct DecodedImage {
+	weak_ptr<Texture> texture;
+	uint64_t contentHash = 0;	// Hash of the source file, for deduplication in the TextureRegistry
+
+	CompressedImage compressed;
+	int width = 0, height = 0, channels = 0;
+	unique_ptr<unsigned char, void(*)(void*)> data{nullptr, nullptr};
+
+	GLuint target = 0;		// Texture object the image is streamed into
+	int uploadedLevels = 0;
+	int uploadedRows = 0;	// Within the current level
+
+	[[nodiscard]] bool isCompressed() const { return !compressed.levels.empty(); }
+	[[nodiscard]] bool isValid() const { return isCompressed() || data; }
+
+	/** Estimated VRAM footprint once uploaded (raw images include the generated mip chain) */
+	[[nodiscard]] size_t byteSize() const;
+};
+
+
+/**
+ * Decodes image files in jobs on the JobSystem and streams them to the GPU in time-sliced
+ * chunks through a pixel buffer object, so that loading large textures never blocks
+ * the render thread for more than TEXTURE_UPLOAD_BUDGET per frame.
+ *
+ * If S3TC is supported, images are uploaded block-compressed with a precomputed mip chain.
+ * Those are read from the TextureCache if possible; otherwise they are compressed on
+ * the decode job and written back to the cache for the next launch.
+ */
+class TextureLoader {
+public:
+	static void start();
+	static void stop();
+
+	static void enqueue(const shared_ptr<Texture> &texture);
+
+	/** Upload decoded images; call once per frame from the thread owning the GL context */
+	static void update();
+
+	[[nodiscard]] static bool isBusy();
+
+private:
+	inline static mutex decodeJobsMutex;				// enqueue() runs on the render thread too, when Texture::bind() re-decodes an evicted Texture
+	inline static vector<JobHandle> decodeJobs;			// Guarded by decodeJobsMutex
+	inline static bool running = false;					// Guarded by queueMutex
+
+	inline static mutex queueMutex;
+	inline static deque<weak_ptr<Texture>> decodeQueue;	// Guarded by queueMutex
+	inline static deque<DecodedImage> decodedImages;	// Guarded by queueMutex
+	inline static int decoders = 0;						// Decode jobs draining decodeQueue; guarded by queueMutex
+
+	inline static deque<DecodedImage> uploads;			// Thread owning the GL context only
+	inline static atomic<int> pending = 0;				// Textures enqueued but not yet finished
+
+	inline static GLuint pbo = 0;
+	inline static bool compressionSupported = false;	// Written before the first decode job starts
+
+	static void decodeLoop();
+	static DecodedImage decode(const weak_ptr<Texture> &texture, const string &filename);
+
+	static bool uploadChunk(DecodedImage &image);
+	static bool uploadRawChunk(DecodedImage &image);
+	static bool uploadCompressedChunk(DecodedImage &image);
+	static void stage(const void *source, size_t size);
+	static void finish(DecodedImage &image, shared_ptr<TextureStorage> storage);
+};
@@ -0,0 +1,119 @@
+#include "TextureRegistry.h"
+
+#include <algorithm>
+#include <filesystem>
+#include <ranges>
+#include <vector>
+
+#include "Texture.h"
+#include "TextureLoader.h"
+
+
+shared_ptr<Texture> TextureRegistry::acquire(const string& path) {
+	const string key = normalize(path);
+	if (const auto it = byPath.find(key); it != byPath.end()) {
+		if (auto texture = it->second.lock()) return texture;
+	}
+
+	auto texture = make_shared<Texture>(path);
+	byPath[key] = texture;
+	TextureLoader::enqueue(texture);
+	return texture;
+}
+
+shared_ptr<TextureStorage> TextureRegistry::find(const uint64_t contentHash) {
+	const auto it = byHash.find(contentHash);
+	return it != byHash.end() ? it->second.lock() : nullptr;
+}
+
+shared_ptr<TextureStorage> TextureRegistry::adopt(GLuint id, const size_t bytes, const uint64_t contentHash) {
+	// Two files with the same content were in flight at once; keep the first upload
+	if (auto existing = find(contentHash)) {
+		glDeleteTextures(1, &id);
+		return existing;
+	}
+
+	auto storage = make_shared<TextureStorage>(id, bytes, contentHash);
+	byHash[contentHash] = storage;
+	return storage;
+}
+
+
+/**
+ * Evict the least recently bound images until the resident size fits the budget.
+ * Images bound during the last frame are on screen and never evicted, so a scene
+ * that doesn't fit at all overshoots the budget instead of thrashing.
+ */
+void TextureRegistry::update() {
+	frame++;
+	if (residentBytes <= budget) return;
+
+	prune();
+
+	vector<shared_ptr<TextureStorage>> candidates;
+	for (const auto& storage : byHash | views::values) {
+		if (auto resident = storage.lock(); resident && resident->lastUsed + 1 < frame) {
+			candidates.emplace_back(move(resident));
+		}
+	}
+	ranges::sort(candidates, {}, &TextureStorage::lastUsed);
+
+	for (auto& candidate : candidates) {
+		if (residentBytes <= budget) break;
+		evict(candidate);
+		candidate.reset();	// Last reference, deletes the GL object
+	}
+}
+
+void TextureRegistry::cleanup() {
+	for (const auto& texture : byPath | views::values) {
+		if (const auto t = texture.lock()) t->storage.reset();
+	}
+	byHash.clear();
+
+	if (placeholderID) {
+		glDeleteTextures(1, &placeholderID);
+		placeholderID = 0;
+	}
+	contextAlive = false;
+}
+
+GLuint TextureRegistry::placeholder() {
+	if (!placeholderID) {
+		glGenTextures(1, &placeholderID);
+		glBindTexture(GL_TEXTURE_2D, placeholderID);
+
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+
+		constexpr unsigned char white[4] = {255, 255, 255, 255};
+		glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, 1, 1, 0, GL_RGBA, GL_UNSIGNED_BYTE, white);
+	}
+	return placeholderID;
+}
+
+size_t TextureRegistry::getTextureCount() {
+	return ranges::count_if(byPath | views::values, [](const auto& texture) { return !texture.expired(); });
+}
+
+
+/** Same file, same key: resolve relative parts and separators */
+string TextureRegistry::normalize(const string& path) {
+	error_code error;
+	auto normalized = filesystem::weakly_canonical(path, error);
+	if (error) normalized = filesystem::path(path).lexically_normal();
+	return normalized.generic_string();
+}
+
+/** Detach the storage from every Texture using it; they show the placeholder until it's streamed in again */
+void TextureRegistry::evict(const shared_ptr<TextureStorage>& storage) {
+	for (const auto& texture : byPath | views::values) {
+		if (const auto t = texture.lock(); t && t->storage == storage) t->storage.reset();
+	}
+	byHash.erase(storage->contentHash);
+}
+
+void TextureRegistry::prune() {
+	erase_if(byPath, [](const auto& entry) { return entry.second.expired(); });
+	erase_if(byHash, [](const auto& entry) { return entry.second.expired(); });
+}
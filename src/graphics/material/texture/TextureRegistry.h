@@ -0,0 +1,74 @@
+#pragma once
+
+using namespace std;
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+#include <GL/glew.h>
+
+class Texture;
+struct TextureStorage;
+
+// Constants
+constexpr size_t TEXTURE_VRAM_BUDGET = 512ull * 1024 * 1024;	// Default upper limit in bytes for resident textures
+
+
+/**
+ * Central owner of all Textures.
+ *
+ * Textures are deduplicated by path (the same file always yields the same shared handle)
+ * and by content hash (different files with identical bytes share one GL texture object).
+ * Handles are reference-counted; a texture's VRAM is released with its last reference.
+ *
+ * Resident textures are tracked against a VRAM budget. When it's exceeded, the least
+ * recently bound images are evicted; their Textures fall back to the placeholder and
+ * are streamed in again the next time they're bound.
+ */
+class TextureRegistry {
+public:
+	/**
+	 * Shared handle for the texture at path; loading starts on first acquisition.
+	 * Call with the GL context current, i.e. before the RenderThread starts or through RenderThread::invoke().
+	 */
+	static shared_ptr<Texture> acquire(const string &path);
+
+	/** GPU storage of an already resident image with this content hash */
+	static shared_ptr<TextureStorage> find(uint64_t contentHash);
+
+	/** Take ownership of a freshly uploaded GL texture object */
+	static shared_ptr<TextureStorage> adopt(GLuint id, size_t bytes, uint64_t contentHash);
+
+	/** Advance the LRU clock and enforce the budget; call once per frame before rendering */
+	static void update();
+
+	/** Release all GL objects; call before the context is destroyed */
+	static void cleanup();
+
+	/** 1x1 white texture bound while an image isn't resident */
+	static GLuint placeholder();
+
+	static void setBudget(const size_t bytes) { budget = bytes; }
+	[[nodiscard]] static size_t getBudget()		   { return budget; }
+	[[nodiscard]] static size_t getResidentBytes() { return residentBytes; }
+	[[nodiscard]] static uint64_t getFrame()	   { return frame; }
+	[[nodiscard]] static size_t getTextureCount();
+
+private:
+	friend struct TextureStorage;
+
+	inline static unordered_map<string, weak_ptr<Texture>> byPath;
+	inline static unordered_map<uint64_t, weak_ptr<TextureStorage>> byHash;
+
+	inline static size_t budget			= TEXTURE_VRAM_BUDGET;
+	inline static size_t residentBytes	= 0;		// Sum over all live TextureStorages
+	inline static uint64_t frame		= 0;
+	inline static GLuint placeholderID	= 0;
+	inline static bool contextAlive		= true;		// GL calls are skipped after cleanup()
+
+	static string normalize(const string &path);
+	static void evict(const shared_ptr<TextureStorage> &storage);
+	static void prune();
+};
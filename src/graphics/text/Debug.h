@@ -4,6 +4,7 @@ using namespace std;
 
 #include <iostream>
 
+#include "graphics/material/texture/TextureRegistry.h"
 #include "viewport/Viewport.h"
 
 // Options
@@ -13,9 +14,14 @@ constexpr float debugTextSize	= 24;
 const Color debugTextColor		= Colors::TEXT_COLOR;
 
 
+/**
+ * On-screen debug text. The Scene state lines are collected on the main thread along with every
+ * FrameSnapshot; the render statistics and texture residency belong to the render thread and are
+ * filled in while drawing.
+ */
 class Debug {
 public:
-	static void drawDebugText() {
+	static vector<string> collectDebugText() {
 		shared_ptr<Scene> foreground;
 		for (const auto& scene : SceneManager::scenes) {
 			if (scene->name == "Foreground") foreground = scene;
@@ -31,11 +37,11 @@ public:
 			vertexCount += dynamic_cast<Mesh*>(obj.get())->vertices.size();
 		}
 
-		for (int i = 0; i <= 11; i++) {
+		vector<string> lines;
+		for (int i = 1; i <= 11; i++) {
 			ostringstream out;
 
 			switch (i) {
-				case 0:  out << "FPS: " << fps; break;
 				case 1:  out << "Camera Pos: " << camera->camPos.toString(); break;
 				case 2:  out << "Camera Rot: " << fixed << setprecision(1) << camera->rotH << " / " << camera->rotV; break;
 				case 3:  out << "Zoom: " << fixed << setprecision(3) << camera->camDist; break;
@@ -45,13 +51,33 @@ public:
 				if (SceneManager::transformMode.mode    != Mode::NONE)    out << " " << SceneManager::transformMode.modeToString();
 				if (SceneManager::transformMode.subMode != SubMode::NONE) out << " " << SceneManager::transformMode.subModeToString(); break;
 				case 7:  out << "Cube:"; break;
-				case 8:  out << "    Pos: "   << cube->position.toString();  break;
-				case 9:  out << "    Scale: " << cube->scale.toString();     break;
-				case 10: out << "    Rot: "   << cube->rotationEuler.toString(); break;
+				case 8:  out << "    Pos: "   << cube->transform.position.toString();  break;
+				case 9:  out << "    Scale: " << cube->transform.scale.toString();     break;
+				case 10: out << "    Rot: "   << cube->transform.rotation.toEulerAngles().toString(); break;
 				default: out << "Vertex Count: " << vertexCount; break;
 			}
 
-			Text::renderText(out.str(), TextMode::LEFT, UI::firstLineX, Text::line(i, debugTextSize), debugTextSize, debugTextColor);
+			lines.emplace_back(out.str());
+		}
+		return lines;
+	}
+
+	static void drawDebugText(const vector<string>& sceneText) {
+		vector<string> lines;
+
+		ostringstream stats;
+		stats << "FPS: " << fps << " (" << fixed << setprecision(1) << frameTime << " ms, " << static_cast<int>(renderScale * 100.0f) << "% res)";
+		lines.emplace_back(stats.str());
+
+		lines.insert(lines.end(), sceneText.begin(), sceneText.end());
+
+		ostringstream textures;
+		textures << "Textures: " << TextureRegistry::getTextureCount() << " (" << TextureRegistry::getResidentBytes() / (1024 * 1024)
+				 << " / " << TextureRegistry::getBudget() / (1024 * 1024) << " MB)";
+		lines.emplace_back(textures.str());
+
+		for (int i = 0; i < static_cast<int>(lines.size()); i++) {
+			Text::renderText(lines[i], TextMode::LEFT, UI::firstLineX, Text::line(i, debugTextSize), debugTextSize, debugTextColor);
 		}
 	}
 };
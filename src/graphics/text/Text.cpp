@@ -5,6 +5,7 @@
 
 #include "graphics/color/Colors.h"
 #include "graphics/ui/UI.h"
+#include "viewport/Redraw.h"
 
 
 // Function to initialize FreeType and load the font
@@ -173,6 +174,7 @@ void Text::renderText(const string& text, TextMode textMode, const float x, cons
  */
 void Text::setErrorText(const string& text) {
     nonFatalErrorText = text;
+    Redraw::request();
 
     if (!errorTimerRunning) {
         errorTimerRunning = true;
@@ -182,6 +184,7 @@ void Text::setErrorText(const string& text) {
             this_thread::sleep_for(chrono::seconds(3));
             nonFatalErrorText = "";
             errorTimerRunning = false;
+            Redraw::request();  // Wake up the main loop to remove the text
         }).detach(); // Detach the thread so it runs independently
     }
 }
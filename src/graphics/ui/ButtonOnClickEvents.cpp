@@ -3,6 +3,8 @@
 #include <algorithm>
 #include <iostream>
 
+#include <GLFW/glfw3.h>
+
 #include "UIOption.h"
 #include "math/Util.h"
 #include "objects/mesh/cube/Cube.cpp"
@@ -67,8 +69,9 @@ void UI::setOptionButtonOnClickEvents(const shared_ptr<UIOptionList>& tab) {
 	if (!foreground) cerr << "Foreground Scene not found" << endl;
 
 
+	// Close the window instead of exiting right away, so the Viewport can stop the render thread first
 	setOnClickForOptionButton(tab, "Exit", [] {
-		exit(0);
+		glfwSetWindowShouldClose(window, GLFW_TRUE);
 	});
 
 	setOnClickForOptionButton(tab, "Cube", [foreground] {
@@ -9,6 +9,7 @@
 #include "graphics/text/Debug.h"
 
 
+GLFWwindow *UI::window;
 int *UI::width, *UI::height;
 
 int UI::boundLeft, UI::boundRight, UI::boundTop, UI::boundBottom;
@@ -16,13 +17,15 @@ float UI::firstLineX;
 float UI::firstLineY;
 float UI::bottomLineY;
 
-bool UI::unsavedChanges = false;
+atomic<bool> UI::unsavedChanges = false;
+recursive_mutex UI::uiMutex;
 
 vector<const Vector2*> UI::vertexPointers = vector<const Vector2*>();
 map<int, vector<shared_ptr<UIElement>>> UI::layers = map<int, vector<shared_ptr<UIElement>>>();
 
 
-void UI::setup(int* w, int* h) {
+void UI::setup(GLFWwindow* window, int* w, int* h) {
+	UI::window = window;
 	width = w;
 	height = h;
 
@@ -138,7 +141,9 @@ void UI::update() {
 	bottomLineY = 10.0f + static_cast<float>(boundBottom);
 }
 
-void UI::render() {
+void UI::render(const vector<string>& debugText) {
+	lock_guard lock(uiMutex);
+
 	glDisable(GL_DEPTH_TEST);	// Disable depth testing for 2D UI rendering
 	glEnable(GL_BLEND);			// Enable blending for transparency
 	glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
@@ -157,7 +162,7 @@ void UI::render() {
 
 	// Render text
 	#ifdef DEBUG
-		Debug::drawDebugText();
+		Debug::drawDebugText(debugText);
 	#endif
 	Text::drawErrorText(*height);
 
@@ -193,6 +198,8 @@ void UI::render() {
 
 
 void UI::checkButtonPressed() {
+	lock_guard lock(uiMutex);
+
 	for (const auto &elementsOnLayer: layers | views::values) {
 		for (const auto& element : elementsOnLayer) {
 			if (const auto buttonElement = dynamic_pointer_cast<const UIButtonElement>(element)) {
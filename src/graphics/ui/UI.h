@@ -2,7 +2,11 @@
 
 using namespace std;
 
+#include <atomic>
 #include <functional>
+#include <mutex>
+#include <string>
+#include <vector>
 
 #include "UIElement.h"
 #include "viewport/scene/Scene.h"
@@ -11,18 +15,28 @@ using namespace std;
 class UIBulletPoint;
 class Vector2;
 
+struct GLFWwindow;
+
 struct LabelNode;
 
 
 class UI {
 public:
+	static GLFWwindow *window;
 	static int *width, *height;
-	static bool unsavedChanges;
+	static atomic<bool> unsavedChanges;
+
+	/**
+	 * Guards the elements and their layout, and the window size and mouse position they're laid out with.
+	 * The render thread holds it while drawing the UI; the main thread while handling clicks or changing those.
+	 */
+	static recursive_mutex uiMutex;
 
-	static void setup(int *w, int *h);
+	static void setup(GLFWwindow *window, int *w, int *h);
 	static void update();
 
-	static void render();
+	/** Draw on top of the Scenes, with the Scene state lines of the debug text taken along with the frame */
+	static void render(const vector<string> &debugText);
 
 	static void addElement(const shared_ptr<UIElement> &element, int layer);
 
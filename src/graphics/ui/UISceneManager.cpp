@@ -67,6 +67,8 @@ void UISceneManager::render(const float xpos, const float ypos) {
 }
 
 void UISceneManager::update() {
+	lock_guard lock(UI::uiMutex);
+
 	for (const auto& scene : SceneManager::scenes) {
 		bpTree->addBulletPoint(scene->name, bpTree->bp->label, []{});
 
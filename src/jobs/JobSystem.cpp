@@ -0,0 +1,201 @@
+#include "JobSystem.h"
+
+#include <cstdlib>
+
+
+void JobSystem::start(const int workerCount) {
+	if (running) return;
+
+	lock_guard lock(startMutex);
+	if (running) return;
+
+	const int count = workerCount > 0
+		? min(workerCount, JOB_WORKERS_MAX)
+		: clamp(static_cast<int>(thread::hardware_concurrency()) - 1, 1, JOB_WORKERS_MAX);
+
+	// All Queues exist before any worker runs, so they can be indexed without locking the vector
+	queues.clear();
+	for (int i = 0; i <= count; i++) {
+		queues.emplace_back(make_unique<Queue>());
+	}
+
+	running = true;
+	for (int i = 1; i <= count; i++) {
+		workers.emplace_back(workerLoop, static_cast<size_t>(i));
+	}
+
+	// Joinable threads must not reach their destructors, so stop at exit if nobody did before
+	static bool registered = false;
+	if (!registered) {
+		atexit(stop);
+		registered = true;
+	}
+}
+
+void JobSystem::stop() {
+	lock_guard lock(startMutex);
+	if (!running) return;
+
+	{
+		lock_guard sleepLock(sleepMutex);
+		running = false;
+	}
+	wakeCondition.notify_all();
+
+	for (auto& worker : workers) {
+		worker.join();
+	}
+	workers.clear();
+}
+
+int JobSystem::getWorkerCount() {
+	start();
+	return static_cast<int>(workers.size());
+}
+
+
+JobHandle JobSystem::submit(function<void()> fn, const vector<JobHandle>& dependencies) {
+	start();
+
+	auto job = make_shared<Job>();
+	job->fn = move(fn);
+
+	for (const auto& dependency : dependencies) {
+		// finished is set under the same lock, so the dependency either sees this Job or is done already
+		lock_guard lock(dependency->dependentsMutex);
+		if (!dependency->finished) {
+			job->blockers++;
+			dependency->dependents.emplace_back(job);
+		} else if (dependency->error) {
+			lock_guard jobLock(job->dependentsMutex);
+			if (!job->error) job->error = dependency->error;
+		}
+	}
+
+	release(job);
+	return job;
+}
+
+void JobSystem::wait(const JobHandle& job) {
+	while (!job->finished.load(memory_order_acquire)) {
+		if (const auto other = take()) {
+			execute(other);
+		} else {
+			this_thread::yield();
+		}
+	}
+
+	if (job->error) rethrow_exception(job->error);
+}
+
+void JobSystem::waitAll(const vector<JobHandle>& jobs, exception_ptr error) {
+	for (const auto& job : jobs) {
+		try {
+			wait(job);
+		} catch (...) {
+			if (!error) error = current_exception();
+		}
+	}
+
+	if (error) rethrow_exception(error);
+}
+
+
+void JobSystem::workerLoop(const size_t index) {
+	queueIndex = index;
+
+	int idleRounds = 0;
+	while (true) {
+		if (const auto job = take()) {
+			execute(job);
+			idleRounds = 0;
+			continue;
+		}
+
+		if (!running && queued == 0) return;
+
+		if (++idleRounds < JOB_SPIN_ROUNDS) {
+			this_thread::yield();
+			continue;
+		}
+
+		// Announce the sleep before checking for work, so schedule() either sees it or the work is seen here
+		sleeping++;
+		{
+			unique_lock lock(sleepMutex);
+			wakeCondition.wait(lock, [] { return queued > 0 || !running; });
+		}
+		sleeping--;
+		idleRounds = 0;
+	}
+}
+
+/** Drop one blocker; the last one schedules the Job */
+void JobSystem::release(const JobHandle& job) {
+	if (job->blockers.fetch_sub(1) == 1) schedule(job);
+}
+
+void JobSystem::schedule(JobHandle job) {
+	auto& queue = *queues[queueIndex];
+	{
+		lock_guard lock(queue.queueMutex);
+		queue.jobs.emplace_back(move(job));
+	}
+	queued++;
+
+	if (sleeping > 0) {
+		lock_guard lock(sleepMutex);
+		wakeCondition.notify_one();
+	}
+}
+
+/** Newest job of the own Queue, or else the oldest of any other */
+JobHandle JobSystem::take() {
+	if (queued == 0) return nullptr;
+
+	const size_t count = queues.size();
+	for (size_t i = 0; i < count; i++) {
+		auto& queue = *queues[(queueIndex + i) % count];
+
+		lock_guard lock(queue.queueMutex);
+		if (queue.jobs.empty()) continue;
+
+		JobHandle job;
+		if (i == 0) {
+			job = move(queue.jobs.back());
+			queue.jobs.pop_back();
+		} else {
+			job = move(queue.jobs.front());
+			queue.jobs.pop_front();
+		}
+		queued--;
+		return job;
+	}
+	return nullptr;
+}
+
+void JobSystem::execute(const JobHandle& job) {
+	if (!job->error) {
+		try {
+			job->fn();
+		} catch (...) {
+			job->error = current_exception();
+		}
+	}
+	job->fn = nullptr;	// Release the captures right away
+
+	vector<JobHandle> dependents;
+	{
+		lock_guard lock(job->dependentsMutex);
+		job->finished.store(true, memory_order_release);
+		dependents.swap(job->dependents);
+	}
+
+	for (const auto& dependent : dependents) {
+		if (job->error) {
+			lock_guard lock(dependent->dependentsMutex);
+			if (!dependent->error) dependent->error = job->error;
+		}
+		release(dependent);
+	}
+}
@@ -0,0 +1,140 @@
+#pragma once
+
+using namespace std;
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Constants
+constexpr int JOB_WORKERS_MAX			= 63;	// Upper limit for worker threads (the calling thread helps as well)
+constexpr size_t JOB_CHUNKS_PER_THREAD	= 4;	// parallelFor() chunks per thread, so stealing can even out uneven chunks
+constexpr int JOB_SPIN_ROUNDS			= 64;	// Failed rounds of stealing before an idle worker goes to sleep
+
+
+/** Unit of work submitted to the JobSystem; runs once all of its dependencies have finished */
+struct Job {
+	function<void()> fn;
+	exception_ptr error;				// Thrown by fn, or by a dependency (then fn is skipped)
+
+	atomic<int> blockers = 1;			// Unfinished dependencies, plus one until submit() returns
+	atomic<bool> finished = false;
+
+	mutex dependentsMutex;
+	vector<shared_ptr<Job>> dependents;	// Released when this Job finishes; guarded by dependentsMutex
+};
+
+using JobHandle = shared_ptr<Job>;
+
+
+/**
+ * Fixed pool of worker threads with one work-stealing deque each.
+ *
+ * A worker pushes and pops the jobs it spawns at the back of its own deque (the most recent
+ * ones are the most likely still in cache) and steals from the front of the others' when it runs
+ * dry. Threads outside the pool share one more deque. Waiting for a job never blocks: the waiting
+ * thread runs other jobs meanwhile, so fork-join code may nest (e.g. recursive BVH builds).
+ *
+ * Started on first use with one worker per hardware thread but one.
+ */
+class JobSystem {
+public:
+	static void start(int workerCount = 0);
+
+	/** Finish all queued jobs and join the workers; call before tearing down what the jobs use */
+	static void stop();
+
+	[[nodiscard]] static int getWorkerCount();
+
+	/** Run fn on any thread once all dependencies have finished */
+	static JobHandle submit(function<void()> fn, const vector<JobHandle> &dependencies = {});
+
+	/** Block until the job has finished, running other jobs meanwhile. Rethrows the job's exception */
+	static void wait(const JobHandle &job);
+
+	/**
+	 * Run fn(begin, end) over [0, count) in chunks on all threads if count reaches threshold,
+	 * inline otherwise. Chunk sizes are multiples of alignment, so only the last one has a ragged end.
+	 */
+	template <typename F>
+	static void parallelFor(size_t count, size_t threshold, F &&fn, size_t alignment = 1);
+
+	/** Run a on another thread and b on this one, and return once both have finished */
+	template <typename A, typename B>
+	static void parallelInvoke(A &&a, B &&b);
+
+private:
+	/** Work-stealing deque; the owner takes from the back, thieves from the front */
+	struct Queue {
+		mutex queueMutex;
+		deque<JobHandle> jobs;
+	};
+
+	inline static vector<thread> workers;
+	inline static vector<unique_ptr<Queue>> queues;	// queues[0] is shared by all threads outside the pool
+	inline static atomic<bool> running = false;
+	inline static mutex startMutex;
+
+	inline static atomic<size_t> queued = 0;		// Jobs waiting in any Queue
+	inline static atomic<int> sleeping = 0;			// Workers blocked on wakeCondition
+	inline static mutex sleepMutex;
+	inline static condition_variable wakeCondition;
+
+	inline static thread_local size_t queueIndex = 0;	// Own Queue of the current thread
+
+	static void workerLoop(size_t index);
+
+	static void release(const JobHandle &job);
+	static void schedule(JobHandle job);
+	static JobHandle take();
+	static void execute(const JobHandle &job);
+
+	/** Wait for every job, even if some fail, so none outlives what it references. Then rethrow the first error */
+	static void waitAll(const vector<JobHandle> &jobs, exception_ptr error);
+};
+
+
+template <typename F>
+void JobSystem::parallelFor(const size_t count, const size_t threshold, F&& fn, const size_t alignment) {
+	const size_t threads = static_cast<size_t>(getWorkerCount()) + 1;
+	if (count < threshold || count == 0) {
+		fn(size_t{0}, count);
+		return;
+	}
+
+	const size_t chunks = threads * JOB_CHUNKS_PER_THREAD;
+	const size_t chunk  = ((count + chunks - 1) / chunks + alignment - 1) / alignment * alignment;
+
+	vector<JobHandle> jobs;
+	for (size_t begin = chunk; begin < count; begin += chunk) {
+		jobs.emplace_back(submit([&fn, begin, end = min(begin + chunk, count)] { fn(begin, end); }));
+	}
+
+	exception_ptr error;
+	try {
+		fn(size_t{0}, min(chunk, count));
+	} catch (...) {
+		error = current_exception();
+	}
+	waitAll(jobs, error);
+}
+
+template <typename A, typename B>
+void JobSystem::parallelInvoke(A&& a, B&& b) {
+	const auto job = submit([&a] { a(); });
+
+	exception_ptr error;
+	try {
+		b();
+	} catch (...) {
+		error = current_exception();
+	}
+	waitAll({job}, error);
+}
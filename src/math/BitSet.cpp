@@ -0,0 +1,128 @@
+#include "BitSet.h"
+
+#include <algorithm>
+
+#include "Simd.h"
+
+
+void BitSet::assign(const size_t size, const bool value) {
+	bits = size;
+	words.assign((size + 63) / 64, value ? ~uint64_t{0} : 0);
+	trim();
+}
+
+void BitSet::resize(const size_t size, const bool value) {
+	if (value && bits % 64 != 0 && size > bits) {
+		words.back() |= ~uint64_t{0} << (bits % 64);	// Set the tail of the current last word
+	}
+	bits = size;
+	words.resize((size + 63) / 64, value ? ~uint64_t{0} : 0);
+	trim();
+}
+
+void BitSet::trim() {
+	if (bits % 64 != 0) words.back() &= ~uint64_t{0} >> (64 - bits % 64);
+}
+
+
+/** Apply op to every word, two at a time in an SSE register */
+template <typename VectorOp, typename ScalarOp>
+static void forEachWord(uint64_t* words, const uint64_t* other, const size_t count, [[maybe_unused]] VectorOp vectorOp, ScalarOp scalarOp) {
+	size_t i = 0;
+#ifdef USE_SSE
+	for (; i + 2 <= count; i += 2) {
+		const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(words + i));
+		const __m128i b = other ? _mm_loadu_si128(reinterpret_cast<const __m128i*>(other + i)) : _mm_setzero_si128();
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(words + i), vectorOp(a, b));
+	}
+#endif
+	for (; i < count; i++) {
+		words[i] = scalarOp(words[i], other ? other[i] : 0);
+	}
+}
+
+// Not every op reads both operands
+#ifdef USE_SSE
+	#define WORD_OP(vector, scalar) \
+		[]([[maybe_unused]] const __m128i a, [[maybe_unused]] const __m128i b) { return vector; }, \
+		[]([[maybe_unused]] const uint64_t a, [[maybe_unused]] const uint64_t b) { return scalar; }
+#else
+	#define WORD_OP(vector, scalar) nullptr, []([[maybe_unused]] const uint64_t a, [[maybe_unused]] const uint64_t b) { return scalar; }
+#endif
+
+void BitSet::setAll() {
+	forEachWord(words.data(), nullptr, words.size(), WORD_OP(_mm_set1_epi32(-1), ~uint64_t{0}));
+	trim();
+}
+
+void BitSet::resetAll() {
+	forEachWord(words.data(), nullptr, words.size(), WORD_OP(_mm_setzero_si128(), uint64_t{0}));
+}
+
+void BitSet::flipAll() {
+	forEachWord(words.data(), nullptr, words.size(), WORD_OP(_mm_xor_si128(a, _mm_set1_epi32(-1)), ~a));
+	trim();
+}
+
+BitSet& BitSet::operator&=(const BitSet& other) {
+	forEachWord(words.data(), other.words.data(), min(words.size(), other.words.size()), WORD_OP(_mm_and_si128(a, b), a & b));
+	for (size_t i = other.words.size(); i < words.size(); i++) words[i] = 0;
+	return *this;
+}
+
+BitSet& BitSet::operator|=(const BitSet& other) {
+	forEachWord(words.data(), other.words.data(), min(words.size(), other.words.size()), WORD_OP(_mm_or_si128(a, b), a | b));
+	trim();
+	return *this;
+}
+
+#undef WORD_OP
+
+
+#ifdef USE_SSE
+/**
+ * Population count of 4 words at a time: every byte is split into nibbles that index a 16-entry
+ * lookup table through PSHUFB, and the byte counts are summed per word through PSADBW.
+ */
+TARGET_AVX2 static size_t countAVX2(const uint64_t* words, const size_t count) {
+	const __m256i lookup = _mm256_setr_epi8(
+		0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+		0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4
+	);
+	const __m256i low = _mm256_set1_epi8(0x0F);
+
+	__m256i total = _mm256_setzero_si256();
+	size_t i = 0;
+	for (; i + 4 <= count; i += 4) {
+		const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(words + i));
+		const __m256i bytes = _mm256_add_epi8(
+			_mm256_shuffle_epi8(lookup, _mm256_and_si256(v, low)),
+			_mm256_shuffle_epi8(lookup, _mm256_and_si256(_mm256_srli_epi16(v, 4), low))
+		);
+		total = _mm256_add_epi64(total, _mm256_sad_epu8(bytes, _mm256_setzero_si256()));
+	}
+
+	alignas(32) uint64_t lanes[4];
+	_mm256_store_si256(reinterpret_cast<__m256i*>(lanes), total);
+	size_t result = lanes[0] + lanes[1] + lanes[2] + lanes[3];
+	for (; i < count; i++) result += popcount(words[i]);
+	return result;
+}
+#endif
+
+size_t BitSet::count() const {
+#ifdef USE_SSE
+	if (detectSimdLevel() >= SimdLevel::AVX2) return countAVX2(words.data(), words.size());
+#endif
+
+	size_t result = 0;
+	for (const uint64_t word : words) result += popcount(word);
+	return result;
+}
+
+bool BitSet::any() const {
+	for (const uint64_t word : words) {
+		if (word != 0) return true;
+	}
+	return false;
+}
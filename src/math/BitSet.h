@@ -0,0 +1,74 @@
+#pragma once
+
+using namespace std;
+
+#include <bit>
+#include <cstdint>
+#include <vector>
+
+
+/**
+ * Dynamically sized set of bits, packed into 64-bit words.
+ *
+ * Bulk operations work on whole words at a time (two per SSE register), and counting uses an
+ * AVX2 nibble lookup if the CPU supports it. The bits past size() in the last word are always zero,
+ * so counting and comparing never have to mask them out.
+ */
+class BitSet {
+public:
+	BitSet() = default;
+	explicit BitSet(size_t size, bool value = false) { assign(size, value); }
+
+	/** Resize to size bits, all set to value */
+	void assign(size_t size, bool value);
+
+	/** Resize to size bits, keeping the existing ones and setting new ones to value */
+	void resize(size_t size, bool value = false);
+
+	[[nodiscard]] size_t size() const { return bits; }
+
+	[[nodiscard]] bool test(const size_t i) const { return words[i >> 6] >> (i & 63) & 1; }
+	void set(const size_t i) { words[i >> 6] |= uint64_t{1} << (i & 63); }
+	void reset(const size_t i) { words[i >> 6] &= ~(uint64_t{1} << (i & 63)); }
+	void set(const size_t i, const bool value) { value ? set(i) : reset(i); }
+	void flip(const size_t i) { words[i >> 6] ^= uint64_t{1} << (i & 63); }
+
+	// Bulk operations
+	void setAll();
+	void resetAll();
+	void flipAll();
+	BitSet& operator&=(const BitSet &other);
+	BitSet& operator|=(const BitSet &other);
+
+	[[nodiscard]] size_t count() const;
+	[[nodiscard]] bool any() const;
+	[[nodiscard]] bool none() const { return !any(); }
+	[[nodiscard]] bool all() const { return count() == bits; }
+
+	bool operator==(const BitSet &other) const = default;
+
+	/** Call fn(index) for every set bit, in ascending order */
+	template <typename F>
+	void forEachSet(F&& fn) const;
+
+	[[nodiscard]] size_t wordCount() const { return words.size(); }
+	[[nodiscard]] uint64_t* data() { return words.data(); }
+	[[nodiscard]] const uint64_t* data() const { return words.data(); }
+
+	/** Clear the bits past size() after writing whole words */
+	void trim();
+
+private:
+	vector<uint64_t> words;
+	size_t bits = 0;
+};
+
+
+template <typename F>
+void BitSet::forEachSet(F&& fn) const {
+	for (size_t w = 0; w < words.size(); w++) {
+		for (uint64_t word = words[w]; word != 0; word &= word - 1) {
+			fn(w * 64 + countr_zero(word));
+		}
+	}
+}
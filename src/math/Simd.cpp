@@ -0,0 +1,55 @@
+#include "Simd.h"
+
+#if defined(_MSC_VER) && defined(USE_SSE)
+	#include <intrin.h>
+#endif
+
+
+/** CPUID feature bits, plus XCR0 to check that the OS saves the wider registers on context switches */
+static SimdLevel querySimdLevel() {
+#if defined(_MSC_VER) && defined(USE_SSE)
+	int info[4];
+	__cpuid(info, 0);
+	const int maxLeaf = info[0];
+
+	__cpuid(info, 1);
+	const bool osxsave = info[2] & 1 << 27;
+	const bool avx	   = info[2] & 1 << 28;
+	const unsigned long long xcr0 = osxsave ? _xgetbv(0) : 0;
+
+	bool avx2 = false, avx512 = false;
+	if (maxLeaf >= 7) {
+		__cpuidex(info, 7, 0);
+		avx2   = info[1] & 1 << 5;
+		avx512 = info[1] & 1 << 16;
+	}
+
+	if (avx512 && (xcr0 & 0xE6) == 0xE6) return SimdLevel::AVX512;		// XMM, YMM, opmask and ZMM state
+	if (avx && avx2 && (xcr0 & 0x6) == 0x6) return SimdLevel::AVX2;	// XMM and YMM state
+	return SimdLevel::SSE;
+
+#elif defined(USE_SSE)
+	// Also checks XCR0
+	__builtin_cpu_init();
+	if (__builtin_cpu_supports("avx512f")) return SimdLevel::AVX512;
+	if (__builtin_cpu_supports("avx2")) return SimdLevel::AVX2;
+	return SimdLevel::SSE;
+
+#else
+	return SimdLevel::SCALAR;
+#endif
+}
+
+SimdLevel detectSimdLevel() {
+	static const SimdLevel level = querySimdLevel();
+	return level;
+}
+
+const char* simdLevelName(const SimdLevel level) {
+	switch (level) {
+		case SimdLevel::SSE:	return "SSE";
+		case SimdLevel::AVX2:	return "AVX2";
+		case SimdLevel::AVX512: return "AVX-512";
+		default:				return "Scalar";
+	}
+}
@@ -0,0 +1,39 @@
+#pragma once
+
+/**
+ * SSE2 is part of every x86-64 target, so the vectorized code paths are enabled whenever
+ * the compiler targets one. Everything guarded by USE_SSE has a scalar fallback, which
+ * defining FORCE_SCALAR selects instead (the tests are built both ways).
+ *
+ * Wider instruction sets can't be assumed, so their code paths are compiled for them explicitly
+ * (TARGET_AVX2, TARGET_AVX512) and only called if detectSimdLevel() found them at runtime.
+ */
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64)
+	#ifndef FORCE_SCALAR
+		#define USE_SSE
+	#endif
+	#include <immintrin.h>
+#endif
+
+// MSVC accepts any intrinsic in any function, GCC and Clang need the target per function
+#if defined(__GNUC__) || defined(__clang__)
+	#define TARGET_AVX2		__attribute__((target("avx2")))
+	#define TARGET_AVX512	__attribute__((target("avx512f")))
+#else
+	#define TARGET_AVX2
+	#define TARGET_AVX512
+#endif
+
+
+/** Widest vector instruction set usable on this CPU (and enabled by the OS) */
+enum class SimdLevel {
+	SCALAR,
+	SSE,		// 4 floats
+	AVX2,		// 8 floats
+	AVX512		// 16 floats
+};
+
+/** Queried through CPUID once, then cached */
+[[nodiscard]] SimdLevel detectSimdLevel();
+
+[[nodiscard]] const char* simdLevelName(SimdLevel level);
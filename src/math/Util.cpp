@@ -9,19 +9,8 @@ Vector2 project(
 	const array<float, 16>& viewMatrix,
 	const array<float, 16>& projMatrix
 ) {
-	// TODO Make this better
-	auto clip = Vector4(
-       viewMatrix[0] * worldPoint.x + viewMatrix[4] * worldPoint.y + viewMatrix[8] * worldPoint.z + viewMatrix[12],
-       viewMatrix[1] * worldPoint.x + viewMatrix[5] * worldPoint.y + viewMatrix[9] * worldPoint.z + viewMatrix[13],
-       -(viewMatrix[2] * worldPoint.x + viewMatrix[6] * worldPoint.y + viewMatrix[10] * worldPoint.z + viewMatrix[14]),
-       viewMatrix[3] * worldPoint.x + viewMatrix[7] * worldPoint.y + viewMatrix[11] * worldPoint.z + viewMatrix[15]
-	);
-
-	// Step 2: Apply the projection matrix (this transforms from camera space to clip space)
-	clip.x = projMatrix[0] * clip.x + projMatrix[4] * clip.y + projMatrix[8]  * clip.z + projMatrix[12] * clip.w;
-	clip.y = projMatrix[1] * clip.x + projMatrix[5] * clip.y + projMatrix[9]  * clip.z + projMatrix[13] * clip.w;
-	clip.z = projMatrix[2] * clip.x + projMatrix[6] * clip.y + projMatrix[10] * clip.z + projMatrix[14] * clip.w;
-	clip.w = projMatrix[3] * clip.x + projMatrix[7] * clip.y + projMatrix[11] * clip.z + projMatrix[15] * clip.w;
+	// Same mapping as projectPoints(), for a single point
+	const auto clip = Matrix4(projMatrix) * Matrix4(viewMatrix) * Vector4(worldPoint.x, worldPoint.y, worldPoint.z, 1.0f);
 
 	if (abs(clip.w) < EPSILON) throw runtime_error("Cannot project point: w component is zero.");
 	const float ndcX = clip.x / clip.w;
@@ -38,6 +27,15 @@ Vector3 unproject(
 	const array<int, 4>* viewport,
 	const array<float, 16>& viewMatrix,
 	const array<float, 16>& projMatrix
+) {
+	return unproject(screenPoint, viewport, Matrix4(viewMatrix).invert(), Matrix4(projMatrix).invert());
+}
+
+Vector3 unproject(
+	const Vector2& screenPoint,
+	const array<int, 4>* viewport,
+	const Matrix4& inverseView,
+	const Matrix4& inverseProj
 ) {
 	// Convert mouse coordinates to normalized device coordinates (NDC)
 	const auto x = static_cast<float>(2.0 * screenPoint.x / (*viewport)[2] - 1.0);
@@ -47,13 +45,13 @@ Vector3 unproject(
 	const auto viewSpace = Vector4(x, y, 1.0f, 1.0f);
 
 	// Transform from clip space to view space by applying the inverse of the projection matrix
-	const auto clipSpace = Matrix4(projMatrix).invert() * viewSpace;
+	const auto clipSpace = inverseProj * viewSpace;
 
 	// Set the Z to -1 for proper unprojection and W to 0 for direction vector in the case of a ray
 	const auto unprojectedClipSpace = Vector4(clipSpace.x, clipSpace.y, -1.0f, 0.0f);
 
 	// Transform from clip space to world space by applying the inverse of the view matrix
-	const auto worldSpace = Matrix4(viewMatrix).invert() * unprojectedClipSpace;
+	const auto worldSpace = inverseView * unprojectedClipSpace;
 
 	return {worldSpace.x, worldSpace.y, worldSpace.z};
 }
@@ -7,6 +7,7 @@
 #include "vector/Vector4.h"
 #include "viewport/scene/Mode.h"
 
+class Matrix4;
 class UIOptionBase;
 class UITab;
 class Object;
@@ -51,6 +52,9 @@ Vector2 project(const Vector3& worldPoint, const array<int, 4>* viewport, const
 /** Map 2D screen space to 3D world space */
 Vector3 unproject(const Vector2& screenPoint, const array<int, 4>* viewport, const array<float, 16>& viewMatrix, const array<float, 16>& projMatrix);
 
+/** Map 2D screen space to 3D world space with precomputed inverse matrices (see Camera::getInverseView()) */
+Vector3 unproject(const Vector2& screenPoint, const array<int, 4>* viewport, const Matrix4& inverseView, const Matrix4& inverseProj);
+
 
 /** Helper to get all Meshes from a given vector of Objects */
 inline vector<shared_ptr<Mesh>> filterMeshes(const vector<shared_ptr<Object>>& objects) {
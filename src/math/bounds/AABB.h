@@ -0,0 +1,122 @@
+#pragma once
+
+using namespace std;
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "math/Simd.h"
+#include "math/matrix/Matrix4.h"
+#include "math/vector/Vector3.h"
+
+// Constants
+constexpr float INF = numeric_limits<float>::infinity();
+
+
+/** Axis-aligned bounding box; default-constructed boxes are empty and absorb the first point or box */
+struct AABB {
+	Vector3 min = { INF,  INF,  INF};
+	Vector3 max = {-INF, -INF, -INF};
+
+	// Constructors
+	AABB() = default;
+	AABB(const Vector3& min, const Vector3& max) : min(min), max(max) {}
+
+	void expand(const Vector3& p) {
+		min = {std::min(min.x, p.x), std::min(min.y, p.y), std::min(min.z, p.z)};
+		max = {std::max(max.x, p.x), std::max(max.y, p.y), std::max(max.z, p.z)};
+	}
+
+	void expand(const AABB& other) {
+		min = {std::min(min.x, other.min.x), std::min(min.y, other.min.y), std::min(min.z, other.min.z)};
+		max = {std::max(max.x, other.max.x), std::max(max.y, other.max.y), std::max(max.z, other.max.z)};
+	}
+
+	[[nodiscard]] bool isEmpty() const { return min.x > max.x || min.y > max.y || min.z > max.z; }
+
+	[[nodiscard]] Vector3 center() const { return (min + max) * 0.5f; }
+	[[nodiscard]] Vector3 extent() const { return max - min; }
+
+	[[nodiscard]] float surfaceArea() const {
+		if (isEmpty()) return 0.0f;
+		const auto e = extent();
+		return 2.0f * (e.x * e.y + e.y * e.z + e.z * e.x);
+	}
+
+	[[nodiscard]] bool contains(const Vector3& p) const {
+		return p.x >= min.x && p.x <= max.x && p.y >= min.y && p.y <= max.y && p.z >= min.z && p.z <= max.z;
+	}
+
+	[[nodiscard]] bool overlaps(const AABB& other) const {
+	#ifdef USE_SSE
+		// All six separating-axis comparisons at once; the fourth lanes compare 0 <= 0
+		const __m128 lo = _mm_setr_ps(other.min.x, other.min.y, other.min.z, 0.0f);
+		const __m128 hi = _mm_setr_ps(max.x, max.y, max.z, 0.0f);
+		const __m128 lo2 = _mm_setr_ps(min.x, min.y, min.z, 0.0f);
+		const __m128 hi2 = _mm_setr_ps(other.max.x, other.max.y, other.max.z, 0.0f);
+		return _mm_movemask_ps(_mm_and_ps(_mm_cmple_ps(lo, hi), _mm_cmple_ps(lo2, hi2))) == 0xF;
+	#else
+		return min.x <= other.max.x && other.min.x <= max.x
+			&& min.y <= other.max.y && other.min.y <= max.y
+			&& min.z <= other.max.z && other.min.z <= max.z;
+	#endif
+	}
+
+	/** Squared distance from p to the closest point of the box (0 inside) */
+	[[nodiscard]] float distanceSquared(const Vector3& p) const {
+		const Vector3 d = {
+			std::max({min.x - p.x, 0.0f, p.x - max.x}),
+			std::max({min.y - p.y, 0.0f, p.y - max.y}),
+			std::max({min.z - p.z, 0.0f, p.z - max.z})
+		};
+		return d.dot(d);
+	}
+
+	/** Box around this box transformed by m, from its center and the extents spread by |m| (Arvo) */
+	[[nodiscard]] AABB transform(const Matrix4& m) const {
+		if (isEmpty()) return {};
+
+		const auto c = m.transformPoint(center());
+		const auto h = extent() * 0.5f;
+		const Vector3 r = {
+			abs(m(0, 0)) * h.x + abs(m(0, 1)) * h.y + abs(m(0, 2)) * h.z,
+			abs(m(1, 0)) * h.x + abs(m(1, 1)) * h.y + abs(m(1, 2)) * h.z,
+			abs(m(2, 0)) * h.x + abs(m(2, 1)) * h.y + abs(m(2, 2)) * h.z
+		};
+		return {c - r, c + r};
+	}
+
+	/**
+	 * Slab test against a ray given by its origin and inverse direction.
+	 * Returns the entry distance, or INF if the box is missed or further away than maxDistance.
+	 */
+	[[nodiscard]] float intersect(const Vector3& origin, const Vector3& invDirection, const float maxDistance) const {
+	#ifdef USE_SSE
+		// The fourth lanes form the slab [0, maxDistance], which clamps the interval like the scalar version
+		const __m128 o	 = _mm_setr_ps(origin.x, origin.y, origin.z, 0.0f);
+		const __m128 inv = _mm_setr_ps(invDirection.x, invDirection.y, invDirection.z, 1.0f);
+		const __m128 t0	 = _mm_mul_ps(_mm_sub_ps(_mm_setr_ps(min.x, min.y, min.z, 0.0f), o), inv);
+		const __m128 t1	 = _mm_mul_ps(_mm_sub_ps(_mm_setr_ps(max.x, max.y, max.z, maxDistance), o), inv);
+
+		__m128 tNear = _mm_min_ps(t0, t1);
+		__m128 tFar	 = _mm_max_ps(t0, t1);
+		tNear = _mm_max_ps(tNear, _mm_shuffle_ps(tNear, tNear, _MM_SHUFFLE(1, 0, 3, 2)));
+		tNear = _mm_max_ps(tNear, _mm_shuffle_ps(tNear, tNear, _MM_SHUFFLE(2, 3, 0, 1)));
+		tFar  = _mm_min_ps(tFar,  _mm_shuffle_ps(tFar,  tFar,  _MM_SHUFFLE(1, 0, 3, 2)));
+		tFar  = _mm_min_ps(tFar,  _mm_shuffle_ps(tFar,  tFar,  _MM_SHUFFLE(2, 3, 0, 1)));
+
+		const float nearDistance = _mm_cvtss_f32(tNear);
+		return nearDistance <= _mm_cvtss_f32(tFar) ? nearDistance : INF;
+	#else
+		const float tx0 = (min.x - origin.x) * invDirection.x, tx1 = (max.x - origin.x) * invDirection.x;
+		const float ty0 = (min.y - origin.y) * invDirection.y, ty1 = (max.y - origin.y) * invDirection.y;
+		const float tz0 = (min.z - origin.z) * invDirection.z, tz1 = (max.z - origin.z) * invDirection.z;
+
+		const float tNear = std::max({std::min(tx0, tx1), std::min(ty0, ty1), std::min(tz0, tz1), 0.0f});
+		const float tFar  = std::min({std::max(tx0, tx1), std::max(ty0, ty1), std::max(tz0, tz1), maxDistance});
+
+		return tNear <= tFar ? tNear : INF;
+	#endif
+	}
+};
@@ -0,0 +1,74 @@
+#pragma once
+
+using namespace std;
+
+#include <cmath>
+
+#include "AABB.h"
+#include "math/vector/Vector3.h"
+
+
+/** Sphere around a set of points; a negative radius means empty. Cheaper to test than a box, but looser */
+struct BoundingSphere {
+	Vector3 center = Vector3::ZERO;
+	float radius   = -1.0f;
+
+	// Constructors
+	BoundingSphere() = default;
+	BoundingSphere(const Vector3& center, const float radius) : center(center), radius(radius) {}
+
+	/** Circumscribed sphere of a box */
+	static BoundingSphere fromAABB(const AABB& box) {
+		if (box.isEmpty()) return {};
+		return {box.center(), box.extent().length() * 0.5f};
+	}
+
+	[[nodiscard]] bool isEmpty() const { return radius < 0.0f; }
+
+	/** Grow just enough to contain p, moving the center towards it (Ritter) */
+	void expand(const Vector3& p) {
+		if (isEmpty()) {
+			center = p;
+			radius = 0.0f;
+			return;
+		}
+		const float d = center.distance(p);
+		if (d <= radius) return;
+
+		const float newRadius = (radius + d) * 0.5f;
+		center = center + (p - center) * ((newRadius - radius) / d);
+		radius = newRadius;
+	}
+
+	[[nodiscard]] bool contains(const Vector3& p) const {
+		const auto d = p - center;
+		return d.dot(d) <= radius * radius;
+	}
+
+	[[nodiscard]] bool overlaps(const BoundingSphere& other) const {
+		const auto d = other.center - center;
+		const float r = radius + other.radius;
+		return !isEmpty() && !other.isEmpty() && d.dot(d) <= r * r;
+	}
+
+	[[nodiscard]] bool overlaps(const AABB& box) const {
+		return !isEmpty() && box.distanceSquared(center) <= radius * radius;
+	}
+
+	/**
+	 * Ray test with a normalized direction.
+	 * Returns the entry distance (0 if the origin is inside), or INF if missed or further away than maxDistance.
+	 */
+	[[nodiscard]] float intersect(const Vector3& origin, const Vector3& direction, const float maxDistance) const {
+		const auto m = origin - center;
+		const float b = m.dot(direction);
+		const float c = m.dot(m) - radius * radius;
+		if (c > 0.0f && b > 0.0f) return INF;	// Outside and pointing away
+
+		const float discriminant = b * b - c;
+		if (discriminant < 0.0f) return INF;
+
+		const float t = std::max(-b - sqrt(discriminant), 0.0f);
+		return t <= maxDistance ? t : INF;
+	}
+};
@@ -0,0 +1,134 @@
+#pragma once
+
+using namespace std;
+
+#include <array>
+#include <vector>
+
+#include "AABB.h"
+#include "BoundingSphere.h"
+#include "OBB.h"
+#include "math/Simd.h"
+#include "math/vector/Vector3.h"
+
+
+/** Plane with normal · p + d = 0; positive distances lie on the side the normal points to */
+struct Plane {
+	Vector3 normal;
+	float d = 0.0f;
+
+	// Constructors
+	Plane() = default;
+	Plane(const Vector3& normal, const Vector3& point) : normal(normal), d(-normal.dot(point)) {}
+
+	[[nodiscard]] float distance(const Vector3& p) const { return normal.dot(p) + d; }
+};
+
+enum class Containment {
+	OUTSIDE,
+	INTERSECTS,
+	INSIDE
+};
+
+
+/** Convex volume bounded by planes whose normals point inwards */
+struct Frustum {
+	vector<Plane> planes;
+
+	/**
+	 * Infinite pyramid with its apex at the origin, spanned by the rays towards its corners (in winding order).
+	 * The planes through the apex already bound it to the front, so it needs no near or far plane.
+	 */
+	static Frustum fromCorners(const Vector3& apex, const array<Vector3, 4>& directions) {
+		const auto center = directions[0] + directions[1] + directions[2] + directions[3];
+
+		Frustum frustum;
+		for (size_t i = 0; i < directions.size(); i++) {
+			auto normal = directions[i].cross(directions[(i + 1) % directions.size()]).normalize();
+			if (normal.dot(center) < 0.0f) normal = normal * -1.0f;	// Either winding works
+			frustum.planes.emplace_back(normal, apex);
+		}
+		return frustum;
+	}
+
+	/**
+	 * Test the corners closest to and farthest from each plane (the "n-" and "p-vertex"), which lie
+	 * the projected half extent |normal| · extent / 2 below and above the center. With SSE, four planes
+	 * are tested at once; missing planes in the last group are padded with ones that contain everything.
+	 */
+	[[nodiscard]] Containment classify(const AABB& box) const {
+		if (box.isEmpty()) return Containment::OUTSIDE;
+
+		const auto c = box.center();
+		const auto h = box.extent() * 0.5f;
+		bool inside = true;
+
+		size_t i = 0;
+	#ifdef USE_SSE
+		const __m128 cx = _mm_set1_ps(c.x), cy = _mm_set1_ps(c.y), cz = _mm_set1_ps(c.z);
+		const __m128 hx = _mm_set1_ps(h.x), hy = _mm_set1_ps(h.y), hz = _mm_set1_ps(h.z);
+		const __m128 signMask = _mm_set1_ps(-0.0f);
+
+		for (; i < planes.size(); i += 4) {
+			alignas(16) float nx[4] = {}, ny[4] = {}, nz[4] = {}, d[4] = {1.0f, 1.0f, 1.0f, 1.0f};
+			for (size_t k = 0; k < 4 && i + k < planes.size(); k++) {
+				nx[k] = planes[i + k].normal.x;
+				ny[k] = planes[i + k].normal.y;
+				nz[k] = planes[i + k].normal.z;
+				d[k]  = planes[i + k].d;
+			}
+			const __m128 px = _mm_load_ps(nx), py = _mm_load_ps(ny), pz = _mm_load_ps(nz);
+
+			const __m128 distance = _mm_add_ps(_mm_add_ps(_mm_mul_ps(px, cx), _mm_mul_ps(py, cy)), _mm_add_ps(_mm_mul_ps(pz, cz), _mm_load_ps(d)));
+			const __m128 radius	  = _mm_add_ps(_mm_add_ps(
+				_mm_mul_ps(_mm_andnot_ps(signMask, px), hx),
+				_mm_mul_ps(_mm_andnot_ps(signMask, py), hy)),
+				_mm_mul_ps(_mm_andnot_ps(signMask, pz), hz)
+			);
+
+			const __m128 zero = _mm_setzero_ps();
+			if (_mm_movemask_ps(_mm_cmplt_ps(_mm_add_ps(distance, radius), zero))) return Containment::OUTSIDE;
+			if (_mm_movemask_ps(_mm_cmplt_ps(_mm_sub_ps(distance, radius), zero))) inside = false;
+		}
+	#endif
+
+		for (; i < planes.size(); i++) {
+			const auto& n = planes[i].normal;
+			const float distance = planes[i].distance(c);
+			const float radius	 = abs(n.x) * h.x + abs(n.y) * h.y + abs(n.z) * h.z;
+
+			if (distance + radius < 0.0f) return Containment::OUTSIDE;
+			if (distance - radius < 0.0f) inside = false;
+		}
+		return inside ? Containment::INSIDE : Containment::INTERSECTS;
+	}
+
+	[[nodiscard]] Containment classify(const BoundingSphere& sphere) const {
+		if (sphere.isEmpty()) return Containment::OUTSIDE;
+
+		bool inside = true;
+		for (const auto& plane : planes) {
+			const float distance = plane.distance(sphere.center);
+			if (distance < -sphere.radius) return Containment::OUTSIDE;
+			if (distance < sphere.radius) inside = false;
+		}
+		return inside ? Containment::INSIDE : Containment::INTERSECTS;
+	}
+
+	/** Like the AABB test, with the half extent projected onto each of the box's own axes */
+	[[nodiscard]] Containment classify(const OBB& box) const {
+		if (box.isEmpty()) return Containment::OUTSIDE;
+
+		bool inside = true;
+		for (const auto& plane : planes) {
+			const float distance = plane.distance(box.center);
+			const float radius	 = abs(plane.normal.dot(box.axes[0])) * box.halfExtents.x
+								 + abs(plane.normal.dot(box.axes[1])) * box.halfExtents.y
+								 + abs(plane.normal.dot(box.axes[2])) * box.halfExtents.z;
+
+			if (distance + radius < 0.0f) return Containment::OUTSIDE;
+			if (distance - radius < 0.0f) inside = false;
+		}
+		return inside ? Containment::INSIDE : Containment::INTERSECTS;
+	}
+};
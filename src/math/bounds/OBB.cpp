@@ -0,0 +1,81 @@
+#include "OBB.h"
+
+#include <cmath>
+
+
+OBB::OBB(const AABB& local, const Vector3& origin, const Quaternion& rotation) {
+	if (local.isEmpty()) return;
+
+	center		= origin + rotation.rotate(local.center());
+	axes		= {rotation.rotate(Vector3(1, 0, 0)), rotation.rotate(Vector3(0, 1, 0)), rotation.rotate(Vector3(0, 0, 1))};
+	halfExtents = local.extent() * 0.5f;
+}
+
+AABB OBB::toAABB() const {
+	if (isEmpty()) return {};
+
+	const Vector3 r = {
+		abs(axes[0].x) * halfExtents.x + abs(axes[1].x) * halfExtents.y + abs(axes[2].x) * halfExtents.z,
+		abs(axes[0].y) * halfExtents.x + abs(axes[1].y) * halfExtents.y + abs(axes[2].y) * halfExtents.z,
+		abs(axes[0].z) * halfExtents.x + abs(axes[1].z) * halfExtents.y + abs(axes[2].z) * halfExtents.z
+	};
+	return {center - r, center + r};
+}
+
+/** Slab test in the box's own frame */
+float OBB::intersect(const Vector3& origin, const Vector3& direction, const float maxDistance) const {
+	if (isEmpty()) return INF;
+
+	const auto d = origin - center;
+	const Vector3 localOrigin	 = {d.dot(axes[0]), d.dot(axes[1]), d.dot(axes[2])};
+	const Vector3 localDirection = {direction.dot(axes[0]), direction.dot(axes[1]), direction.dot(axes[2])};
+	const Vector3 invDirection	 = {1.0f / localDirection.x, 1.0f / localDirection.y, 1.0f / localDirection.z};
+
+	return AABB(-halfExtents, halfExtents).intersect(localOrigin, invDirection, maxDistance);
+}
+
+bool OBB::overlaps(const OBB& other) const {
+	if (isEmpty() || other.isEmpty()) return false;
+
+	const float a[3] = {halfExtents.x, halfExtents.y, halfExtents.z};
+	const float b[3] = {other.halfExtents.x, other.halfExtents.y, other.halfExtents.z};
+
+	// Rotation of the other box into this one's frame, and the translation between them
+	float r[3][3], absR[3][3];
+	for (int i = 0; i < 3; i++) {
+		for (int j = 0; j < 3; j++) {
+			r[i][j]	   = axes[i].dot(other.axes[j]);
+			absR[i][j] = abs(r[i][j]) + 1e-6f;	// Keeps near-parallel edge pairs from producing zero cross products
+		}
+	}
+	const auto d = other.center - center;
+	const float t[3] = {d.dot(axes[0]), d.dot(axes[1]), d.dot(axes[2])};
+
+	// This box's face normals
+	for (int i = 0; i < 3; i++) {
+		if (abs(t[i]) > a[i] + b[0] * absR[i][0] + b[1] * absR[i][1] + b[2] * absR[i][2]) return false;
+	}
+
+	// The other box's face normals
+	for (int j = 0; j < 3; j++) {
+		const float distance = abs(t[0] * r[0][j] + t[1] * r[1][j] + t[2] * r[2][j]);
+		if (distance > a[0] * absR[0][j] + a[1] * absR[1][j] + a[2] * absR[2][j] + b[j]) return false;
+	}
+
+	// Cross products of edge directions
+	for (int i = 0; i < 3; i++) {
+		const int i1 = (i + 1) % 3, i2 = (i + 2) % 3;
+		for (int j = 0; j < 3; j++) {
+			const int j1 = (j + 1) % 3, j2 = (j + 2) % 3;
+			const float ra = a[i1] * absR[i2][j] + a[i2] * absR[i1][j];
+			const float rb = b[j1] * absR[i][j2] + b[j2] * absR[i][j1];
+			if (abs(t[i2] * r[i1][j] - t[i1] * r[i2][j]) > ra + rb) return false;
+		}
+	}
+
+	return true;
+}
+
+bool OBB::overlaps(const AABB& box) const {
+	return overlaps(OBB(box, Vector3::ZERO, Quaternion()));
+}
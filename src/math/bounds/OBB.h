@@ -0,0 +1,35 @@
+#pragma once
+
+using namespace std;
+
+#include <array>
+
+#include "AABB.h"
+#include "math/transform/Quaternion.h"
+#include "math/vector/Vector3.h"
+
+
+/** Oriented bounding box: a box in a rotated frame, tight around rotated geometry where an AABB isn't */
+struct OBB {
+	Vector3 center		= Vector3::ZERO;
+	array<Vector3, 3> axes = {Vector3(1, 0, 0), Vector3(0, 1, 0), Vector3(0, 0, 1)};	// Orthonormal
+	Vector3 halfExtents = Vector3::MINUS_ONE;	// Negative: empty
+
+	// Constructors
+	OBB() = default;
+
+	/** Box given in the frame rotated by rotation around origin */
+	OBB(const AABB& local, const Vector3& origin, const Quaternion& rotation);
+
+	[[nodiscard]] bool isEmpty() const { return halfExtents.x < 0.0f; }
+
+	/** Smallest AABB containing the box */
+	[[nodiscard]] AABB toAABB() const;
+
+	/** Same contract as AABB::intersect(), but with the ray direction itself */
+	[[nodiscard]] float intersect(const Vector3& origin, const Vector3& direction, float maxDistance) const;
+
+	/** Separating axis test over the 15 candidate axes (Gottschalk) */
+	[[nodiscard]] bool overlaps(const OBB& other) const;
+	[[nodiscard]] bool overlaps(const AABB& box) const;
+};
@@ -0,0 +1,167 @@
+#include "BVH.h"
+
+#include <algorithm>
+#include <atomic>
+
+#include "jobs/JobSystem.h"
+
+
+/** Per-primitive data only needed while building; partitioned in place so each node's range stays contiguous in memory */
+struct BuildRef {
+	AABB bounds;
+	Vector3 centroid;
+	uint32_t primitive;
+};
+
+struct BVH::BuildState {
+	vector<BuildRef> refs;
+	int leafSize, leafSizeMax;
+	atomic<uint32_t> nodeCount = 1;
+};
+
+
+/** Branch-free alternative to Vector3::operator[], which range-checks */
+static float component(const Vector3& v, const int axis) {
+	return axis == 0 ? v.x : axis == 1 ? v.y : v.z;
+}
+
+
+void BVH::build(const vector<AABB>& bounds, const int leafSize, const int leafSizeMax) {
+	const auto count = static_cast<uint32_t>(bounds.size());
+	nodes.clear();
+	order.resize(count);
+	if (count == 0) return;
+
+	BuildState state;
+	state.leafSize	  = leafSize;
+	state.leafSizeMax = leafSizeMax;
+	state.refs.resize(count);
+	for (uint32_t i = 0; i < count; i++) {
+		state.refs[i] = {bounds[i], bounds[i].center(), i};
+	}
+
+	// A binary tree with n leaves has at most 2n - 1 nodes; allocate up front so worker threads never reallocate
+	nodes.resize(2 * static_cast<size_t>(count) - 1);
+	buildNode(0, 0, count, 0, state);
+	nodes.resize(state.nodeCount);
+	nodes.shrink_to_fit();
+
+	for (uint32_t i = 0; i < count; i++) {
+		order[i] = state.refs[i].primitive;
+	}
+}
+
+void BVH::buildNode(const uint32_t nodeIndex, const uint32_t begin, const uint32_t end, const int depth, BuildState& state) {
+	Node& node = nodes[nodeIndex];
+	const uint32_t count = end - begin;
+
+	AABB centroidBounds;
+	node.bounds = {};
+	for (uint32_t i = begin; i < end; i++) {
+		node.bounds.expand(state.refs[i].bounds);
+		centroidBounds.expand(state.refs[i].centroid);
+	}
+
+	node.first = begin;
+	node.count = count;
+	if (count <= static_cast<uint32_t>(state.leafSize) || depth >= BVH_MAX_DEPTH - 1) return;
+
+	// Bin the centroids along all three axes in a single pass
+	struct Bin { AABB bounds; uint32_t count = 0; } bins[3][BVH_SAH_BINS];
+	float low[3], scale[3];
+	for (int axis = 0; axis < 3; axis++) {
+		low[axis] = component(centroidBounds.min, axis);
+		const float extent = component(centroidBounds.max, axis) - low[axis];
+		scale[axis] = extent > 0.0f ? BVH_SAH_BINS / extent : 0.0f;
+	}
+
+	for (uint32_t i = begin; i < end; i++) {
+		const auto& ref = state.refs[i];
+		for (int axis = 0; axis < 3; axis++) {
+			const int b = min(static_cast<int>((component(ref.centroid, axis) - low[axis]) * scale[axis]), BVH_SAH_BINS - 1);
+			bins[axis][b].count++;
+			bins[axis][b].bounds.expand(ref.bounds);
+		}
+	}
+
+	// Evaluate the surface area heuristic at every bin boundary
+	int bestAxis = -1, bestSplit = 0;
+	float bestCost = INF;
+	for (int axis = 0; axis < 3; axis++) {
+		if (scale[axis] == 0.0f) continue;
+
+		// Sweep from the left, then evaluate while sweeping from the right
+		float leftArea[BVH_SAH_BINS - 1];
+		uint32_t leftCount[BVH_SAH_BINS - 1];
+		AABB accumulated;
+		uint32_t n = 0;
+		for (int b = 0; b < BVH_SAH_BINS - 1; b++) {
+			accumulated.expand(bins[axis][b].bounds);
+			n += bins[axis][b].count;
+			leftArea[b] = accumulated.surfaceArea();
+			leftCount[b] = n;
+		}
+
+		accumulated = {};
+		n = 0;
+		for (int b = BVH_SAH_BINS - 1; b > 0; b--) {
+			accumulated.expand(bins[axis][b].bounds);
+			n += bins[axis][b].count;
+			if (leftCount[b - 1] == 0 || n == 0) continue;
+
+			if (const float c = leftArea[b - 1] * leftCount[b - 1] + accumulated.surfaceArea() * n; c < bestCost) {
+				bestCost = c;
+				bestAxis = axis;
+				bestSplit = b;
+			}
+		}
+	}
+
+	// Keep small nodes as leaves if splitting wouldn't pay off (traversal cost 1, intersection cost 1)
+	const float area = node.bounds.surfaceArea();
+	const float splitCost = area > 0.0f ? 1.0f + bestCost / area : INF;
+	if (count <= static_cast<uint32_t>(state.leafSizeMax) && splitCost >= static_cast<float>(count)) return;
+
+	const auto first = state.refs.begin() + begin;
+	const auto last  = state.refs.begin() + end;
+	auto middle = first;
+	if (bestAxis >= 0) {
+		middle = partition(first, last, [&](const BuildRef& ref) {
+			const float c = component(ref.centroid, bestAxis);
+			return min(static_cast<int>((c - low[bestAxis]) * scale[bestAxis]), BVH_SAH_BINS - 1) < bestSplit;
+		});
+	}
+
+	// All centroids coincide (or the split failed): split in the middle of the list
+	if (middle == first || middle == last) {
+		middle = first + count / 2;
+	}
+	const auto split = static_cast<uint32_t>(middle - state.refs.begin());
+
+	const uint32_t left = state.nodeCount.fetch_add(2);
+	node.first = left;
+	node.count = 0;
+
+	if (count >= BVH_PARALLEL_THRESHOLD) {
+		JobSystem::parallelInvoke(
+			[&] { buildNode(left, begin, split, depth + 1, state); },
+			[&] { buildNode(left + 1, split, end, depth + 1, state); }
+		);
+	} else {
+		buildNode(left, begin, split, depth + 1, state);
+		buildNode(left + 1, split, end, depth + 1, state);
+	}
+}
+
+float BVH::cost() const {
+	if (nodes.empty()) return 0.0f;
+
+	const float rootArea = nodes.front().bounds.surfaceArea();
+	if (rootArea <= 0.0f) return 0.0f;
+
+	float total = 0.0f;
+	for (const auto& node : nodes) {
+		total += node.bounds.surfaceArea() * (node.count ? static_cast<float>(node.count) : 1.0f);
+	}
+	return total / rootArea;
+}
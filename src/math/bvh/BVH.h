@@ -0,0 +1,119 @@
+#pragma once
+
+using namespace std;
+
+#include <cstdint>
+#include <vector>
+
+#include "math/bounds/AABB.h"
+
+// Constants
+constexpr int BVH_SAH_BINS				= 16;		// Split candidates per axis
+constexpr int BVH_MAX_DEPTH				= 64;		// Also the size of the traversal stack
+constexpr size_t BVH_PARALLEL_THRESHOLD	= 1 << 16;	// Primitives in a subtree (or a Mesh) before the work is split across threads
+constexpr float BVH_REBUILD_RATIO		= 1.5f;		// Rebuild instead of refit once the SAH cost grew by this factor
+
+
+/**
+ * Binary bounding volume hierarchy over abstract primitives, given only by their bounds.
+ * MeshBVH (triangles) and SceneBVH (Meshes) put their own leaf tests on top of it.
+ *
+ * Built top-down with binned SAH; large subtrees are built in parallel.
+ * Leaves reference ranges of slots; getOrder() maps every slot back to its primitive.
+ */
+class BVH {
+public:
+	/** 32 bytes; inner nodes have count 0 and their children at first and first + 1 */
+	struct Node {
+		AABB bounds;
+		uint32_t first = 0;		// Left child, or first slot of a leaf
+		uint32_t count = 0;		// Number of primitives in a leaf
+	};
+
+	/** Leaves get at most leafSize primitives, or up to leafSizeMax if splitting them wouldn't pay off */
+	void build(const vector<AABB> &bounds, int leafSize, int leafSizeMax);
+
+	/** Recompute all bounds bottom-up; leafBounds(first, count) returns the bounds of a leaf's slots */
+	template <typename LeafBounds>
+	void refit(LeafBounds&& leafBounds);
+
+	/**
+	 * Visit the leaves hit by a ray, nearest first. leaf(first, count) tests its slots and
+	 * lowers maxDistance on a hit, which prunes everything further away.
+	 */
+	template <typename Leaf>
+	void traverse(const Vector3 &origin, const Vector3 &direction, float &maxDistance, Leaf&& leaf) const;
+
+	/** SAH cost relative to the root, independent of the scale of the primitives */
+	[[nodiscard]] float cost() const;
+
+	[[nodiscard]] bool isEmpty() const { return nodes.empty(); }
+	[[nodiscard]] AABB getBounds() const { return nodes.empty() ? AABB{} : nodes.front().bounds; }
+	[[nodiscard]] const vector<uint32_t>& getOrder() const { return order; }
+
+private:
+	struct BuildState;
+
+	vector<Node> nodes;
+	vector<uint32_t> order;	// Primitive index for every slot
+
+	void buildNode(uint32_t nodeIndex, uint32_t begin, uint32_t end, int depth, BuildState &state);
+};
+
+
+template <typename LeafBounds>
+void BVH::refit(LeafBounds&& leafBounds) {
+	// Children are always allocated after their parent, so a reverse sweep visits them first
+	for (size_t i = nodes.size(); i-- > 0;) {
+		Node& node = nodes[i];
+		if (node.count) {
+			node.bounds = leafBounds(node.first, node.count);
+		} else {
+			node.bounds = nodes[node.first].bounds;
+			node.bounds.expand(nodes[node.first + 1].bounds);
+		}
+	}
+}
+
+template <typename Leaf>
+void BVH::traverse(const Vector3& origin, const Vector3& direction, float& maxDistance, Leaf&& leaf) const {
+	if (nodes.empty()) return;
+
+	const Vector3 invDirection = {1.0f / direction.x, 1.0f / direction.y, 1.0f / direction.z};
+	if (nodes[0].bounds.intersect(origin, invDirection, maxDistance) == INF) return;
+
+	uint32_t stack[BVH_MAX_DEPTH];
+	int stackSize = 0;
+	uint32_t current = 0;
+
+	while (true) {
+		const Node& node = nodes[current];
+
+		if (node.count) {
+			leaf(node.first, node.count);
+		} else {
+			// Descend into the nearer child first and defer the other one
+			uint32_t nearChild = node.first, farChild = node.first + 1;
+			float nearDist = nodes[nearChild].bounds.intersect(origin, invDirection, maxDistance);
+			float farDist  = nodes[farChild].bounds.intersect(origin, invDirection, maxDistance);
+			if (farDist < nearDist) {
+				swap(nearChild, farChild);
+				swap(nearDist, farDist);
+			}
+
+			if (nearDist != INF) {
+				if (farDist != INF) stack[stackSize++] = farChild;
+				current = nearChild;
+				continue;
+			}
+		}
+
+		// Pop deferred nodes, skipping those beyond the closest hit found since
+		bool found = false;
+		while (stackSize > 0 && !found) {
+			current = stack[--stackSize];
+			found = nodes[current].bounds.intersect(origin, invDirection, maxDistance) != INF;
+		}
+		if (!found) return;
+	}
+}
@@ -0,0 +1,60 @@
+#include "MeshBVH.h"
+
+#include "jobs/JobSystem.h"
+#include "math/ray/Ray.h"
+#include "objects/mesh/Mesh.h"
+
+
+void MeshBVH::build(const Mesh& mesh) {
+	vector<AABB> bounds(mesh.triangles.size());
+	JobSystem::parallelFor(bounds.size(), BVH_PARALLEL_THRESHOLD, [&](const size_t begin, const size_t end) {
+		for (size_t i = begin; i < end; i++) {
+			const auto& t = *mesh.triangles[i];
+			bounds[i].expand(t.v0->position);
+			bounds[i].expand(t.v1->position);
+			bounds[i].expand(t.v2->position);
+		}
+	});
+
+	tree.build(bounds, MESH_BVH_LEAF_SIZE, MESH_BVH_LEAF_SIZE_MAX);
+	gatherTriangles(mesh);
+	buildCost = tree.cost();
+}
+
+bool MeshBVH::refit(const Mesh& mesh) {
+	if (tree.isEmpty() || mesh.triangles.size() != tree.getOrder().size()) return false;
+
+	gatherTriangles(mesh);
+	tree.refit([this](const uint32_t first, const uint32_t count) {
+		return triangles.bounds(first, count);
+	});
+
+	return tree.cost() <= buildCost * BVH_REBUILD_RATIO;
+}
+
+/** Copy the triangles into leaf order */
+void MeshBVH::gatherTriangles(const Mesh& mesh) {
+	const auto& order = tree.getOrder();
+	triangles.resize(order.size());
+	JobSystem::parallelFor(order.size(), BVH_PARALLEL_THRESHOLD, [&](const size_t begin, const size_t end) {
+		for (size_t i = begin; i < end; i++) {
+			const auto& t = *mesh.triangles[order[i]];
+			triangles.set(i, t.v0->position, t.v1->position, t.v2->position);
+		}
+	});
+}
+
+
+RayHit MeshBVH::intersect(const Ray& ray, const float maxDistance) const {
+	RayHit hit;
+	hit.distance = maxDistance;
+
+	const auto& order = tree.getOrder();
+	tree.traverse(ray.origin, ray.direction, hit.distance, [&](const uint32_t first, const uint32_t count) {
+		if (const int slot = triangles.intersect(ray.origin, ray.direction, first, count, hit); slot >= 0) {
+			hit.triangle = static_cast<int>(order[slot]);
+		}
+	});
+
+	return hit;
+}
@@ -0,0 +1,43 @@
+#pragma once
+
+using namespace std;
+
+#include <vector>
+
+#include "BVH.h"
+#include "TrianglePackets.h"
+
+class Mesh;
+class Ray;
+
+// Constants
+constexpr int MESH_BVH_LEAF_SIZE		= 4;	// Leaves with at most this many triangles are never split
+constexpr int MESH_BVH_LEAF_SIZE_MAX	= 16;	// Leaves with more triangles are always split
+
+
+/**
+ * Bounding volume hierarchy over the triangles of a Mesh, for fast ray queries.
+ *
+ * Triangles are copied into leaf order as TrianglePackets, so traversal never touches the Mesh
+ * and every leaf is tested with one vectorized kernel call.
+ * After vertex edits the tree can be refit bottom-up in O(n) instead of being rebuilt.
+ */
+class MeshBVH {
+public:
+	void build(const Mesh &mesh);
+
+	/** Update the bounds for moved vertices; returns false if the tree degraded enough to warrant a rebuild */
+	bool refit(const Mesh &mesh);
+
+	[[nodiscard]] RayHit intersect(const Ray &ray, float maxDistance = INF) const;
+
+	[[nodiscard]] bool isEmpty() const { return tree.isEmpty(); }
+	[[nodiscard]] AABB getBounds() const { return tree.getBounds(); }
+
+private:
+	BVH tree;
+	TrianglePackets triangles;	// In leaf order
+	float buildCost = 0.0f;
+
+	void gatherTriangles(const Mesh &mesh);
+};
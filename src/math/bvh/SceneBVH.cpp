@@ -0,0 +1,123 @@
+#include "SceneBVH.h"
+
+#include "jobs/JobSystem.h"
+#include "math/ray/Ray.h"
+#include "objects/mesh/Mesh.h"
+
+
+bool SceneBVH::contains(const Mesh& mesh) const {
+	const auto id = static_cast<size_t>(mesh.getID());
+	return id < slots.size() && slots[id] != 0;
+}
+
+bool SceneBVH::add(const shared_ptr<Mesh>& mesh) {
+	if (contains(*mesh)) return false;
+
+	const auto id = static_cast<size_t>(mesh->getID());
+	if (id >= slots.size()) slots.resize(id + 1, 0);
+
+	meshes.emplace_back(mesh);
+	marked.emplace_back(false);
+	slots[id] = static_cast<uint32_t>(meshes.size());
+	outdated = true;
+	return true;
+}
+
+bool SceneBVH::remove(const Mesh& mesh) {
+	if (!contains(mesh)) return false;
+
+	// Move the last Mesh into the gap (mesh may be owned by nothing but this, so it's not touched after)
+	const auto id = mesh.getID();
+	const uint32_t position = slots[id] - 1;
+	slots[id] = 0;
+	if (position + 1 != meshes.size()) {
+		meshes[position] = move(meshes.back());
+		slots[meshes[position]->getID()] = position + 1;
+	}
+	meshes.pop_back();
+	marked.pop_back();
+	outdated = true;
+	return true;
+}
+
+void SceneBVH::clear() {
+	for (const auto& mesh : meshes) slots[mesh->getID()] = 0;
+	meshes.clear();
+	marked.clear();
+	moved.clear();
+	outdated = true;
+}
+
+void SceneBVH::markMoved(const Mesh& mesh) {
+	// A rebuild is pending anyway
+	if (outdated || !contains(mesh)) return;
+
+	const uint32_t position = slots[mesh.getID()] - 1;
+	if (marked[position]) return;
+	marked[position] = true;
+	moved.emplace_back(position);
+}
+
+void SceneBVH::update() {
+	if (outdated) {
+		build();
+		return;
+	}
+	if (moved.empty()) return;
+
+	// Bring the cached bounds of the moved Meshes up to date first, so the refit below only reads them
+	JobSystem::parallelFor(moved.size(), SCENE_PARALLEL_THRESHOLD, [this](const size_t begin, const size_t end) {
+		for (size_t i = begin; i < end; i++) {
+			(void) meshes[moved[i]]->getLocalBounds();
+		}
+	});
+	for (const auto position : moved) marked[position] = false;
+	moved.clear();
+
+	const auto& order = tree.getOrder();
+	tree.refit([this, &order](const uint32_t first, const uint32_t count) {
+		AABB bounds;
+		for (uint32_t i = first; i < first + count; i++) {
+			bounds.expand(meshes[order[i]]->getWorldBounds());
+		}
+		return bounds;
+	});
+
+	if (tree.cost() > buildCost * BVH_REBUILD_RATIO) build();
+}
+
+void SceneBVH::build() {
+	vector<AABB> bounds(meshes.size());
+	JobSystem::parallelFor(meshes.size(), SCENE_PARALLEL_THRESHOLD, [&](const size_t begin, const size_t end) {
+		for (size_t i = begin; i < end; i++) {
+			bounds[i] = meshes[i]->getWorldBounds();
+		}
+	});
+
+	// Positions in moved may be stale after remove()
+	marked.assign(meshes.size(), false);
+	moved.clear();
+	outdated = false;
+
+	tree.build(bounds, SCENE_BVH_LEAF_SIZE, SCENE_BVH_LEAF_SIZE_MAX);
+	buildCost = tree.cost();
+}
+
+
+SceneHit SceneBVH::intersect(const Ray& ray, const float maxDistance) const {
+	SceneHit result;
+	float closest = maxDistance;
+
+	const auto& order = tree.getOrder();
+	tree.traverse(ray.origin, ray.direction, closest, [&](const uint32_t first, const uint32_t count) {
+		for (uint32_t i = first; i < first + count; i++) {
+			const auto& mesh = meshes[order[i]];
+			if (const auto hit = mesh->getBVH().intersect(ray, closest)) {
+				closest = hit.distance;
+				result = {mesh, hit};
+			}
+		}
+	});
+
+	return result;
+}
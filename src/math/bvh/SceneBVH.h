@@ -0,0 +1,67 @@
+#pragma once
+
+using namespace std;
+
+#include <memory>
+#include <vector>
+
+#include "BVH.h"
+#include "MeshBVH.h"
+
+class Mesh;
+class Ray;
+
+// Constants
+constexpr int SCENE_BVH_LEAF_SIZE		= 1;	// Leaves with at most this many Meshes are never split
+constexpr int SCENE_BVH_LEAF_SIZE_MAX	= 4;	// Leaves with more Meshes are always split
+constexpr size_t SCENE_PARALLEL_THRESHOLD	= 64;	// Meshes before their bounds are gathered on all threads
+
+
+/** Closest intersection of a Ray with any Mesh in the SceneBVH */
+struct SceneHit {
+	shared_ptr<Mesh> mesh;
+	RayHit hit;
+
+	explicit operator bool() const { return mesh != nullptr; }
+};
+
+
+/**
+ * Top level of the two-level acceleration structure used for picking:
+ * a BVH over the world-space bounds of Meshes, each with its own MeshBVH underneath.
+ *
+ * The set of Meshes is kept incrementally through add() and remove(), indexed by Object ID, and
+ * transformed Meshes are reported through markMoved(). update() then rebuilds the tree after the
+ * set changed, or refits it if only some Meshes moved, so a query without changes costs nothing extra.
+ * The leaves use Mesh::getWorldBounds(), which Object Mode transformations update without touching the MeshBVHs.
+ */
+class SceneBVH {
+public:
+	/** Returns false if the Mesh was already tracked */
+	bool add(const shared_ptr<Mesh> &mesh);
+	/** Returns false if the Mesh wasn't tracked */
+	bool remove(const Mesh &mesh);
+	void clear();
+
+	/** Call after transforming or editing a tracked Mesh, so its leaf is refit by the next update() */
+	void markMoved(const Mesh &mesh);
+
+	/** Apply the changes since the last update, before querying */
+	void update();
+
+	[[nodiscard]] bool contains(const Mesh &mesh) const;
+	[[nodiscard]] const vector<shared_ptr<Mesh>>& getMeshes() const { return meshes; }
+
+	[[nodiscard]] SceneHit intersect(const Ray &ray, float maxDistance = INF) const;
+
+private:
+	BVH tree;
+	vector<shared_ptr<Mesh>> meshes;	// Tracked Meshes, in no particular order
+	vector<uint32_t> slots;				// By Object ID: position in meshes + 1, or 0 if not tracked
+	vector<uint32_t> moved;				// Positions of the Meshes marked since the last update
+	vector<bool> marked;				// By position: whether it's in moved already
+	bool outdated = false;				// The set of Meshes changed since the last build
+	float buildCost = 0.0f;
+
+	void build();
+};
@@ -0,0 +1,278 @@
+#include "TrianglePackets.h"
+
+#include <bit>
+
+#include "math/Util.h"
+
+using Lanes	 = const float* const*;
+using Kernel = int (*)(Lanes lanes, size_t first, size_t n, const Vector3& origin, const Vector3& direction, RayHit& hit);
+
+// Lane order
+enum { V0X, V0Y, V0Z, E0X, E0Y, E0Z, E1X, E1Y, E1Z };
+
+
+/** Möller–Trumbore, one triangle at a time */
+static int intersectScalar(const Lanes lanes, const size_t first, const size_t n, const Vector3& origin, const Vector3& direction, RayHit& hit) {
+	int best = -1;
+	for (size_t k = first; k < first + n; k++) {
+		const Vector3 e0 = {lanes[E0X][k], lanes[E0Y][k], lanes[E0Z][k]};
+		const Vector3 e1 = {lanes[E1X][k], lanes[E1Y][k], lanes[E1Z][k]};
+
+		const auto h = direction.cross(e1);
+		const auto a = e0.dot(h);
+		if (a > -EPSILON && a < EPSILON) continue;	// Parallel to the triangle
+
+		const auto f = 1.0f / a;
+		const auto s = origin - Vector3(lanes[V0X][k], lanes[V0Y][k], lanes[V0Z][k]);
+		const auto u = f * s.dot(h);
+		if (u < 0.0f || u > 1.0f) continue;
+
+		const auto q = s.cross(e0);
+		const auto v = f * direction.dot(q);
+		if (v < 0.0f || u + v > 1.0f) continue;
+
+		const auto t = f * e1.dot(q);
+		if (t <= EPSILON || t >= hit.distance) continue;
+
+		hit.distance = t;
+		hit.u = u;
+		hit.v = v;
+		best = static_cast<int>(k);
+	}
+	return best;
+}
+
+
+#ifdef USE_SSE
+
+/** Four triangles per iteration; the closest hit among them lowers the distance for the next four */
+static int intersectSSE(const Lanes lanes, const size_t first, const size_t n, const Vector3& origin, const Vector3& direction, RayHit& hit) {
+	const __m128 ox = _mm_set1_ps(origin.x), oy = _mm_set1_ps(origin.y), oz = _mm_set1_ps(origin.z);
+	const __m128 dx = _mm_set1_ps(direction.x), dy = _mm_set1_ps(direction.y), dz = _mm_set1_ps(direction.z);
+	const __m128 zero = _mm_setzero_ps(), one = _mm_set1_ps(1.0f), inf = _mm_set1_ps(INF);
+	const __m128 eps = _mm_set1_ps(EPSILON), negEps = _mm_set1_ps(-EPSILON);
+	const __m128 laneIndex = _mm_setr_ps(0.0f, 1.0f, 2.0f, 3.0f);
+	__m128 tMax = _mm_set1_ps(hit.distance);
+
+	int best = -1;
+	for (size_t i = 0; i < n; i += 4) {
+		const size_t k = first + i;
+		const __m128 e0x = _mm_loadu_ps(lanes[E0X] + k), e0y = _mm_loadu_ps(lanes[E0Y] + k), e0z = _mm_loadu_ps(lanes[E0Z] + k);
+		const __m128 e1x = _mm_loadu_ps(lanes[E1X] + k), e1y = _mm_loadu_ps(lanes[E1Y] + k), e1z = _mm_loadu_ps(lanes[E1Z] + k);
+
+		// h = direction x e1, a = e0 . h
+		const __m128 hx = _mm_sub_ps(_mm_mul_ps(dy, e1z), _mm_mul_ps(dz, e1y));
+		const __m128 hy = _mm_sub_ps(_mm_mul_ps(dz, e1x), _mm_mul_ps(dx, e1z));
+		const __m128 hz = _mm_sub_ps(_mm_mul_ps(dx, e1y), _mm_mul_ps(dy, e1x));
+		const __m128 a  = _mm_add_ps(_mm_add_ps(_mm_mul_ps(e0x, hx), _mm_mul_ps(e0y, hy)), _mm_mul_ps(e0z, hz));
+		const __m128 f  = _mm_div_ps(one, a);
+
+		// s = origin - v0, u = f * (s . h)
+		const __m128 sx = _mm_sub_ps(ox, _mm_loadu_ps(lanes[V0X] + k));
+		const __m128 sy = _mm_sub_ps(oy, _mm_loadu_ps(lanes[V0Y] + k));
+		const __m128 sz = _mm_sub_ps(oz, _mm_loadu_ps(lanes[V0Z] + k));
+		const __m128 u  = _mm_mul_ps(f, _mm_add_ps(_mm_add_ps(_mm_mul_ps(sx, hx), _mm_mul_ps(sy, hy)), _mm_mul_ps(sz, hz)));
+
+		// q = s x e0, v = f * (direction . q), t = f * (e1 . q)
+		const __m128 qx = _mm_sub_ps(_mm_mul_ps(sy, e0z), _mm_mul_ps(sz, e0y));
+		const __m128 qy = _mm_sub_ps(_mm_mul_ps(sz, e0x), _mm_mul_ps(sx, e0z));
+		const __m128 qz = _mm_sub_ps(_mm_mul_ps(sx, e0y), _mm_mul_ps(sy, e0x));
+		const __m128 v  = _mm_mul_ps(f, _mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, qx), _mm_mul_ps(dy, qy)), _mm_mul_ps(dz, qz)));
+		const __m128 t  = _mm_mul_ps(f, _mm_add_ps(_mm_add_ps(_mm_mul_ps(e1x, qx), _mm_mul_ps(e1y, qy)), _mm_mul_ps(e1z, qz)));
+
+		__m128 mask = _mm_or_ps(_mm_cmpgt_ps(a, eps), _mm_cmplt_ps(a, negEps));
+		mask = _mm_and_ps(mask, _mm_and_ps(_mm_cmpge_ps(u, zero), _mm_cmple_ps(u, one)));
+		mask = _mm_and_ps(mask, _mm_and_ps(_mm_cmpge_ps(v, zero), _mm_cmple_ps(_mm_add_ps(u, v), one)));
+		mask = _mm_and_ps(mask, _mm_and_ps(_mm_cmpgt_ps(t, eps), _mm_cmplt_ps(t, tMax)));
+		mask = _mm_and_ps(mask, _mm_cmplt_ps(laneIndex, _mm_set1_ps(static_cast<float>(n - i))));
+		if (!_mm_movemask_ps(mask)) continue;
+
+		// Closest lane
+		const __m128 masked = _mm_or_ps(_mm_and_ps(mask, t), _mm_andnot_ps(mask, inf));
+		__m128 minimum = _mm_min_ps(masked, _mm_shuffle_ps(masked, masked, _MM_SHUFFLE(1, 0, 3, 2)));
+		minimum = _mm_min_ps(minimum, _mm_shuffle_ps(minimum, minimum, _MM_SHUFFLE(2, 3, 0, 1)));
+		const int lane = countr_zero(static_cast<unsigned>(_mm_movemask_ps(_mm_and_ps(mask, _mm_cmpeq_ps(masked, minimum)))));
+
+		alignas(16) float ts[4], us[4], vs[4];
+		_mm_store_ps(ts, t); _mm_store_ps(us, u); _mm_store_ps(vs, v);
+		hit.distance = ts[lane];
+		hit.u = us[lane];
+		hit.v = vs[lane];
+		best = static_cast<int>(k) + lane;
+		tMax = minimum;
+	}
+	return best;
+}
+
+TARGET_AVX2
+static int intersectAVX2(const Lanes lanes, const size_t first, const size_t n, const Vector3& origin, const Vector3& direction, RayHit& hit) {
+	const __m256 ox = _mm256_set1_ps(origin.x), oy = _mm256_set1_ps(origin.y), oz = _mm256_set1_ps(origin.z);
+	const __m256 dx = _mm256_set1_ps(direction.x), dy = _mm256_set1_ps(direction.y), dz = _mm256_set1_ps(direction.z);
+	const __m256 zero = _mm256_setzero_ps(), one = _mm256_set1_ps(1.0f), inf = _mm256_set1_ps(INF);
+	const __m256 eps = _mm256_set1_ps(EPSILON), negEps = _mm256_set1_ps(-EPSILON);
+	const __m256 laneIndex = _mm256_setr_ps(0.0f, 1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 7.0f);
+	__m256 tMax = _mm256_set1_ps(hit.distance);
+
+	int best = -1;
+	for (size_t i = 0; i < n; i += 8) {
+		const size_t k = first + i;
+		const __m256 e0x = _mm256_loadu_ps(lanes[E0X] + k), e0y = _mm256_loadu_ps(lanes[E0Y] + k), e0z = _mm256_loadu_ps(lanes[E0Z] + k);
+		const __m256 e1x = _mm256_loadu_ps(lanes[E1X] + k), e1y = _mm256_loadu_ps(lanes[E1Y] + k), e1z = _mm256_loadu_ps(lanes[E1Z] + k);
+
+		const __m256 hx = _mm256_sub_ps(_mm256_mul_ps(dy, e1z), _mm256_mul_ps(dz, e1y));
+		const __m256 hy = _mm256_sub_ps(_mm256_mul_ps(dz, e1x), _mm256_mul_ps(dx, e1z));
+		const __m256 hz = _mm256_sub_ps(_mm256_mul_ps(dx, e1y), _mm256_mul_ps(dy, e1x));
+		const __m256 a  = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(e0x, hx), _mm256_mul_ps(e0y, hy)), _mm256_mul_ps(e0z, hz));
+		const __m256 f  = _mm256_div_ps(one, a);
+
+		const __m256 sx = _mm256_sub_ps(ox, _mm256_loadu_ps(lanes[V0X] + k));
+		const __m256 sy = _mm256_sub_ps(oy, _mm256_loadu_ps(lanes[V0Y] + k));
+		const __m256 sz = _mm256_sub_ps(oz, _mm256_loadu_ps(lanes[V0Z] + k));
+		const __m256 u  = _mm256_mul_ps(f, _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(sx, hx), _mm256_mul_ps(sy, hy)), _mm256_mul_ps(sz, hz)));
+
+		const __m256 qx = _mm256_sub_ps(_mm256_mul_ps(sy, e0z), _mm256_mul_ps(sz, e0y));
+		const __m256 qy = _mm256_sub_ps(_mm256_mul_ps(sz, e0x), _mm256_mul_ps(sx, e0z));
+		const __m256 qz = _mm256_sub_ps(_mm256_mul_ps(sx, e0y), _mm256_mul_ps(sy, e0x));
+		const __m256 v  = _mm256_mul_ps(f, _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(dx, qx), _mm256_mul_ps(dy, qy)), _mm256_mul_ps(dz, qz)));
+		const __m256 t  = _mm256_mul_ps(f, _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(e1x, qx), _mm256_mul_ps(e1y, qy)), _mm256_mul_ps(e1z, qz)));
+
+		__m256 mask = _mm256_or_ps(_mm256_cmp_ps(a, eps, _CMP_GT_OQ), _mm256_cmp_ps(a, negEps, _CMP_LT_OQ));
+		mask = _mm256_and_ps(mask, _mm256_and_ps(_mm256_cmp_ps(u, zero, _CMP_GE_OQ), _mm256_cmp_ps(u, one, _CMP_LE_OQ)));
+		mask = _mm256_and_ps(mask, _mm256_and_ps(_mm256_cmp_ps(v, zero, _CMP_GE_OQ), _mm256_cmp_ps(_mm256_add_ps(u, v), one, _CMP_LE_OQ)));
+		mask = _mm256_and_ps(mask, _mm256_and_ps(_mm256_cmp_ps(t, eps, _CMP_GT_OQ), _mm256_cmp_ps(t, tMax, _CMP_LT_OQ)));
+		mask = _mm256_and_ps(mask, _mm256_cmp_ps(laneIndex, _mm256_set1_ps(static_cast<float>(n - i)), _CMP_LT_OQ));
+		if (!_mm256_movemask_ps(mask)) continue;
+
+		const __m256 masked = _mm256_blendv_ps(inf, t, mask);
+		__m256 minimum = _mm256_min_ps(masked, _mm256_permute2f128_ps(masked, masked, 1));
+		minimum = _mm256_min_ps(minimum, _mm256_shuffle_ps(minimum, minimum, _MM_SHUFFLE(1, 0, 3, 2)));
+		minimum = _mm256_min_ps(minimum, _mm256_shuffle_ps(minimum, minimum, _MM_SHUFFLE(2, 3, 0, 1)));
+		const int lane = countr_zero(static_cast<unsigned>(_mm256_movemask_ps(_mm256_and_ps(mask, _mm256_cmp_ps(masked, minimum, _CMP_EQ_OQ)))));
+
+		alignas(32) float ts[8], us[8], vs[8];
+		_mm256_store_ps(ts, t); _mm256_store_ps(us, u); _mm256_store_ps(vs, v);
+		hit.distance = ts[lane];
+		hit.u = us[lane];
+		hit.v = vs[lane];
+		best = static_cast<int>(k) + lane;
+		tMax = minimum;
+	}
+	return best;
+}
+
+TARGET_AVX512
+static int intersectAVX512(const Lanes lanes, const size_t first, const size_t n, const Vector3& origin, const Vector3& direction, RayHit& hit) {
+	const __m512 ox = _mm512_set1_ps(origin.x), oy = _mm512_set1_ps(origin.y), oz = _mm512_set1_ps(origin.z);
+	const __m512 dx = _mm512_set1_ps(direction.x), dy = _mm512_set1_ps(direction.y), dz = _mm512_set1_ps(direction.z);
+	const __m512 zero = _mm512_setzero_ps(), one = _mm512_set1_ps(1.0f), inf = _mm512_set1_ps(INF);
+	const __m512 eps = _mm512_set1_ps(EPSILON), negEps = _mm512_set1_ps(-EPSILON);
+	__m512 tMax = _mm512_set1_ps(hit.distance);
+
+	int best = -1;
+	for (size_t i = 0; i < n; i += 16) {
+		const size_t k = first + i;
+		const __m512 e0x = _mm512_loadu_ps(lanes[E0X] + k), e0y = _mm512_loadu_ps(lanes[E0Y] + k), e0z = _mm512_loadu_ps(lanes[E0Z] + k);
+		const __m512 e1x = _mm512_loadu_ps(lanes[E1X] + k), e1y = _mm512_loadu_ps(lanes[E1Y] + k), e1z = _mm512_loadu_ps(lanes[E1Z] + k);
+
+		const __m512 hx = _mm512_sub_ps(_mm512_mul_ps(dy, e1z), _mm512_mul_ps(dz, e1y));
+		const __m512 hy = _mm512_sub_ps(_mm512_mul_ps(dz, e1x), _mm512_mul_ps(dx, e1z));
+		const __m512 hz = _mm512_sub_ps(_mm512_mul_ps(dx, e1y), _mm512_mul_ps(dy, e1x));
+		const __m512 a  = _mm512_add_ps(_mm512_add_ps(_mm512_mul_ps(e0x, hx), _mm512_mul_ps(e0y, hy)), _mm512_mul_ps(e0z, hz));
+		const __m512 f  = _mm512_div_ps(one, a);
+
+		const __m512 sx = _mm512_sub_ps(ox, _mm512_loadu_ps(lanes[V0X] + k));
+		const __m512 sy = _mm512_sub_ps(oy, _mm512_loadu_ps(lanes[V0Y] + k));
+		const __m512 sz = _mm512_sub_ps(oz, _mm512_loadu_ps(lanes[V0Z] + k));
+		const __m512 u  = _mm512_mul_ps(f, _mm512_add_ps(_mm512_add_ps(_mm512_mul_ps(sx, hx), _mm512_mul_ps(sy, hy)), _mm512_mul_ps(sz, hz)));
+
+		const __m512 qx = _mm512_sub_ps(_mm512_mul_ps(sy, e0z), _mm512_mul_ps(sz, e0y));
+		const __m512 qy = _mm512_sub_ps(_mm512_mul_ps(sz, e0x), _mm512_mul_ps(sx, e0z));
+		const __m512 qz = _mm512_sub_ps(_mm512_mul_ps(sx, e0y), _mm512_mul_ps(sy, e0x));
+		const __m512 v  = _mm512_mul_ps(f, _mm512_add_ps(_mm512_add_ps(_mm512_mul_ps(dx, qx), _mm512_mul_ps(dy, qy)), _mm512_mul_ps(dz, qz)));
+		const __m512 t  = _mm512_mul_ps(f, _mm512_add_ps(_mm512_add_ps(_mm512_mul_ps(e1x, qx), _mm512_mul_ps(e1y, qy)), _mm512_mul_ps(e1z, qz)));
+
+		__mmask16 mask = n - i >= 16 ? 0xFFFF : static_cast<__mmask16>((1u << (n - i)) - 1);
+		mask &= _mm512_cmp_ps_mask(a, eps, _CMP_GT_OQ) | _mm512_cmp_ps_mask(a, negEps, _CMP_LT_OQ);
+		mask &= _mm512_cmp_ps_mask(u, zero, _CMP_GE_OQ) & _mm512_cmp_ps_mask(u, one, _CMP_LE_OQ);
+		mask &= _mm512_cmp_ps_mask(v, zero, _CMP_GE_OQ) & _mm512_cmp_ps_mask(_mm512_add_ps(u, v), one, _CMP_LE_OQ);
+		mask &= _mm512_cmp_ps_mask(t, eps, _CMP_GT_OQ) & _mm512_cmp_ps_mask(t, tMax, _CMP_LT_OQ);
+		if (!mask) continue;
+
+		const float minimum = _mm512_reduce_min_ps(_mm512_mask_blend_ps(mask, inf, t));
+		const int lane = countr_zero(static_cast<unsigned>(mask & _mm512_cmp_ps_mask(t, _mm512_set1_ps(minimum), _CMP_EQ_OQ)));
+
+		alignas(64) float us[16], vs[16];
+		_mm512_store_ps(us, u); _mm512_store_ps(vs, v);
+		hit.distance = minimum;
+		hit.u = us[lane];
+		hit.v = vs[lane];
+		best = static_cast<int>(k) + lane;
+		tMax = _mm512_set1_ps(minimum);
+	}
+	return best;
+}
+
+#endif
+
+
+static Kernel kernelFor(const SimdLevel level) {
+#ifdef USE_SSE
+	switch (level) {
+		case SimdLevel::AVX512: return intersectAVX512;
+		case SimdLevel::AVX2:	return intersectAVX2;
+		case SimdLevel::SSE:	return intersectSSE;
+		default: break;
+	}
+#endif
+	return intersectScalar;
+}
+
+static SimdLevel kernelLevel = detectSimdLevel();
+static Kernel kernel		 = kernelFor(kernelLevel);
+
+
+void TrianglePackets::setKernel(const SimdLevel level) {
+	kernelLevel = min(level, detectSimdLevel());
+	kernel		= kernelFor(kernelLevel);
+}
+
+SimdLevel TrianglePackets::getKernel() {
+	return kernelLevel;
+}
+
+
+/** Lanes past count stay allocated, so the widest kernel can always load a full packet */
+void TrianglePackets::resize(const size_t n) {
+	count = n;
+	for (auto& lane : lanes) {
+		lane.resize(n + TRIANGLE_PACKET_WIDTH);
+	}
+}
+
+void TrianglePackets::set(const size_t index, const Vector3& v0, const Vector3& v1, const Vector3& v2) {
+	const auto e0 = v1 - v0;
+	const auto e1 = v2 - v0;
+	lanes[V0X][index] = v0.x; lanes[V0Y][index] = v0.y; lanes[V0Z][index] = v0.z;
+	lanes[E0X][index] = e0.x; lanes[E0Y][index] = e0.y; lanes[E0Z][index] = e0.z;
+	lanes[E1X][index] = e1.x; lanes[E1Y][index] = e1.y; lanes[E1Z][index] = e1.z;
+}
+
+AABB TrianglePackets::bounds(const size_t first, const size_t n) const {
+	AABB box;
+	for (size_t k = first; k < first + n; k++) {
+		const Vector3 v0 = {lanes[V0X][k], lanes[V0Y][k], lanes[V0Z][k]};
+		box.expand(v0);
+		box.expand(v0 + Vector3(lanes[E0X][k], lanes[E0Y][k], lanes[E0Z][k]));
+		box.expand(v0 + Vector3(lanes[E1X][k], lanes[E1Y][k], lanes[E1Z][k]));
+	}
+	return box;
+}
+
+int TrianglePackets::intersect(const Vector3& origin, const Vector3& direction, const size_t first, const size_t n, RayHit& hit) const {
+	const float* const pointers[] = {
+		lanes[V0X].data(), lanes[V0Y].data(), lanes[V0Z].data(),
+		lanes[E0X].data(), lanes[E0Y].data(), lanes[E0Z].data(),
+		lanes[E1X].data(), lanes[E1Y].data(), lanes[E1Z].data()
+	};
+	return kernel(pointers, first, n, origin, direction, hit);
+}
@@ -0,0 +1,53 @@
+#pragma once
+
+using namespace std;
+
+#include <array>
+#include <vector>
+
+#include "math/Simd.h"
+#include "math/bounds/AABB.h"
+
+// Constants
+constexpr size_t TRIANGLE_PACKET_WIDTH = 16;	// Triangles per AVX-512 test, also the padding of the lanes
+
+
+/** Closest intersection of a Ray with a Mesh */
+struct RayHit {
+	float distance = INF;		// Along the ray, in multiples of its direction
+	int triangle = -1;			// Index into Mesh::triangles
+	float u = 0.0f, v = 0.0f;	// Barycentric coordinates of the hit point
+
+	explicit operator bool() const { return triangle >= 0; }
+};
+
+
+/**
+ * Triangles in structure-of-arrays layout (first vertex and both edges, one array per component),
+ * so one Möller–Trumbore test covers 4 (SSE), 8 (AVX2) or 16 (AVX-512) triangles at once.
+ *
+ * The kernel is picked once from the instruction sets the CPU supports. Any range of triangles can
+ * be tested, lanes past its end are masked out; the arrays are padded so those lanes stay readable.
+ */
+class TrianglePackets {
+public:
+	void resize(size_t count);
+	void set(size_t index, const Vector3 &v0, const Vector3 &v1, const Vector3 &v2);
+
+	[[nodiscard]] size_t size() const { return count; }
+	[[nodiscard]] AABB bounds(size_t first, size_t n) const;
+
+	/**
+	 * Closest hit among the triangles [first, first + n) that's closer than hit.distance.
+	 * Updates distance and barycentrics of the hit and returns the triangle's index, or -1 on a miss.
+	 */
+	int intersect(const Vector3 &origin, const Vector3 &direction, size_t first, size_t n, RayHit &hit) const;
+
+	/** Force a narrower kernel, e.g. to compare them; levels the CPU doesn't support are clamped */
+	static void setKernel(SimdLevel level);
+	[[nodiscard]] static SimdLevel getKernel();
+
+private:
+	size_t count = 0;
+	array<vector<float>, 9> lanes;	// v0.xyz, e0.xyz, e1.xyz
+};
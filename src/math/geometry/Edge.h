@@ -23,9 +23,10 @@ struct Edge {
 template<>
 struct std::hash<Edge> {
 	size_t operator()(const Edge& edge) const noexcept {
-		// Combine the two vertex indices in a symmetric way
-		const size_t h1 = std::hash<Vertex>()(*edge.v0);
-		const size_t h2 = std::hash<Vertex>()(*edge.v1);
+		// Hash the Vertex identities like operator== compares them, so the hash
+		// stays valid while Vertices are moved
+		const size_t h1 = std::hash<Vertex*>()(edge.v0.get());
+		const size_t h2 = std::hash<Vertex*>()(edge.v1.get());
 
 		// Combine the two hash values using XOR and bit shifting
 		return h1 ^ h2 << 1;
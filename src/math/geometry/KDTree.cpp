@@ -0,0 +1,109 @@
+#include "KDTree.h"
+
+#include <algorithm>
+#include <numeric>
+
+/** Coordinate of a Vector3 by axis, without the bounds check of operator[] */
+static constexpr float Vector3::* AXES[] = {&Vector3::x, &Vector3::y, &Vector3::z};
+
+
+void KDTree::build(const vector<Vector3>& source) {
+	const auto n = static_cast<uint32_t>(source.size());
+
+	indices.resize(n);
+	iota(indices.begin(), indices.end(), 0u);
+	points = source;	// Read by buildRange() in original order, permuted afterwards
+	axes.assign(n, 0);
+
+	bounds = AABB();
+	for (const auto& p : source) bounds.expand(p);
+
+	buildRange(0, n);
+
+	for (uint32_t i = 0; i < n; i++) {
+		points[i] = source[indices[i]];
+	}
+	slots.resize(n);
+	for (uint32_t i = 0; i < n; i++) {
+		slots[indices[i]] = i;
+	}
+}
+
+void KDTree::clear() {
+	points.clear();
+	indices.clear();
+	slots.clear();
+	axes.clear();
+	bounds = AABB();
+}
+
+/** Split at the median along the widest axis, then recurse into both halves */
+void KDTree::buildRange(const uint32_t first, const uint32_t last) {
+	if (last - first <= KD_TREE_LEAF_SIZE) return;
+
+	AABB range;
+	for (uint32_t i = first; i < last; i++) range.expand(points[indices[i]]);
+	const auto extent = range.extent();
+	const uint8_t axis = extent.x >= extent.y && extent.x >= extent.z ? 0 : extent.y >= extent.z ? 1 : 2;
+	const auto member = AXES[axis];
+
+	const uint32_t mid = first + (last - first) / 2;
+	nth_element(indices.begin() + first, indices.begin() + mid, indices.begin() + last, [&](const uint32_t a, const uint32_t b) {
+		return points[a].*member < points[b].*member;
+	});
+	axes[mid] = axis;
+
+	buildRange(first, mid);
+	buildRange(mid + 1, last);
+}
+
+
+optional<KDTree::Hit> KDTree::nearest(const Vector3& p, const float maxDistance) const {
+	if (points.empty()) return nullopt;
+
+	optional<Hit> best;
+	float bestSquared = maxDistance == INF ? INF : maxDistance * maxDistance;
+
+	// Ranges with a lower bound on the squared distance of their points; the near side is visited first
+	struct Range { uint32_t first, last; float bound; };
+	Range stack[64];
+	int top = 0;
+	stack[top++] = {0, static_cast<uint32_t>(points.size()), 0.0f};
+
+	while (top > 0) {
+		const auto [first, last, bound] = stack[--top];
+		if (bound > bestSquared) continue;
+
+		if (last - first <= KD_TREE_LEAF_SIZE) {
+			for (uint32_t i = first; i < last; i++) {
+				const auto d = points[i] - p;
+				if (const float d2 = d.dot(d); d2 <= bestSquared) {
+					bestSquared = d2;
+					best = Hit{indices[i], d2};
+				}
+			}
+			continue;
+		}
+
+		const uint32_t mid = first + (last - first) / 2;
+		const auto d = points[mid] - p;
+		if (const float d2 = d.dot(d); d2 <= bestSquared) {
+			bestSquared = d2;
+			best = Hit{indices[mid], d2};
+		}
+
+		const auto member = AXES[axes[mid]];
+		const float delta = p.*member - points[mid].*member;
+		const Range lower = {first, mid, delta > 0.0f ? delta * delta : 0.0f};
+		const Range upper = {mid + 1, last, delta < 0.0f ? delta * delta : 0.0f};
+		if (delta < 0.0f) {
+			stack[top++] = upper;
+			stack[top++] = lower;
+		} else {
+			stack[top++] = lower;
+			stack[top++] = upper;
+		}
+	}
+
+	return best;
+}
@@ -0,0 +1,83 @@
+#pragma once
+
+using namespace std;
+
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+#include "math/bounds/AABB.h"
+
+// Constants
+constexpr uint32_t KD_TREE_LEAF_SIZE = 8;	// Ranges this small are scanned instead of split
+
+
+/**
+ * Balanced k-d tree over a point set, for nearest-neighbor and radius queries in O(log n).
+ *
+ * The tree is implicit: the points are reordered so every range [first, last) has its splitting point
+ * at the middle, with smaller coordinates (along the widest axis of the range) before it and larger
+ * ones after it. Only the split axis of every range is stored besides the points themselves.
+ */
+class KDTree {
+public:
+	struct Hit {
+		uint32_t index;				// Into the points passed to build()
+		float distanceSquared;
+	};
+
+	void build(const vector<Vector3> &points);
+	void clear();
+
+	/** Closest point within maxDistance of p */
+	[[nodiscard]] optional<Hit> nearest(const Vector3 &p, float maxDistance = INF) const;
+
+	/** Call fn(Hit) for every point within radius of p */
+	template <typename F>
+	void forEachInRadius(const Vector3 &p, float radius, F&& fn) const;
+
+	[[nodiscard]] bool isEmpty() const { return points.empty(); }
+	[[nodiscard]] size_t size() const { return points.size(); }
+	[[nodiscard]] const AABB& getBounds() const { return bounds; }
+	[[nodiscard]] const Vector3& getPoint(const uint32_t index) const { return points[slots[index]]; }
+
+private:
+	vector<Vector3> points;		// In tree order
+	vector<uint32_t> indices;	// Original index of every point in tree order
+	vector<uint32_t> slots;		// Tree position of every original index
+	vector<uint8_t> axes;		// Split axis of the range whose middle is at this position
+	AABB bounds;
+
+	void buildRange(uint32_t first, uint32_t last);
+};
+
+
+template <typename F>
+void KDTree::forEachInRadius(const Vector3& p, const float radius, F&& fn) const {
+	const float radiusSquared = radius * radius;
+
+	struct Range { uint32_t first, last; };
+	Range stack[64];
+	int top = 0;
+	if (!points.empty()) stack[top++] = {0, static_cast<uint32_t>(points.size())};
+
+	while (top > 0) {
+		const auto [first, last] = stack[--top];
+
+		if (last - first <= KD_TREE_LEAF_SIZE) {
+			for (uint32_t i = first; i < last; i++) {
+				const auto d = points[i] - p;
+				if (const float d2 = d.dot(d); d2 <= radiusSquared) fn(Hit{indices[i], d2});
+			}
+			continue;
+		}
+
+		const uint32_t mid = first + (last - first) / 2;
+		const auto d = points[mid] - p;
+		if (const float d2 = d.dot(d); d2 <= radiusSquared) fn(Hit{indices[mid], d2});
+
+		const float delta = p[axes[mid]] - points[mid][axes[mid]];
+		if (delta - radius <= 0.0f) stack[top++] = {first, mid};
+		if (delta + radius >= 0.0f) stack[top++] = {mid + 1, last};
+	}
+}
@@ -0,0 +1,30 @@
+#include "SpatialHash.h"
+
+#include <bit>
+
+
+SpatialHash::SpatialHash(const float cellSize) : cellSize(cellSize) {}
+
+void SpatialHash::build(const vector<Vector3>& points) {
+	this->points = &points;
+
+	const uint64_t tableSize = bit_ceil(max<uint64_t>(points.size() * 2, 1));
+	mask = tableSize - 1;
+
+	vector<uint32_t> buckets(points.size());
+	bucketStart.assign(tableSize + 1, 0);
+	for (size_t i = 0; i < points.size(); i++) {
+		const auto& p = points[i];
+		buckets[i] = static_cast<uint32_t>(bucket(cell(p.x), cell(p.y), cell(p.z)));
+		bucketStart[buckets[i] + 1]++;
+	}
+	for (uint64_t b = 0; b < tableSize; b++) {
+		bucketStart[b + 1] += bucketStart[b];
+	}
+
+	bucketPoints.resize(points.size());
+	vector<uint32_t> fill(bucketStart.begin(), bucketStart.end() - 1);
+	for (size_t i = 0; i < points.size(); i++) {
+		bucketPoints[fill[buckets[i]]++] = static_cast<uint32_t>(i);
+	}
+}
@@ -0,0 +1,83 @@
+#pragma once
+
+using namespace std;
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+#include "math/vector/Vector3.h"
+
+
+/**
+ * Uniform grid over a point set, stored as a hash table of cells so empty space costs nothing.
+ *
+ * Points are counting-sorted into buckets (cells hashed to a power-of-two table with about two
+ * buckets per point), so building is O(n) with no per-cell allocations. A radius query visits the
+ * cells overlapped by the query box, at most 8 if the cells are twice as large as the radius;
+ * bucket collisions only cost extra distance checks.
+ */
+class SpatialHash {
+public:
+	explicit SpatialHash(float cellSize);
+
+	void build(const vector<Vector3> &points);
+
+	/** Call fn(index) for every point within radius of p; fastest if radius is at most the cell size */
+	template <typename F>
+	void forEachNear(const Vector3 &p, float radius, F&& fn) const;
+
+private:
+	float cellSize;
+	const vector<Vector3>* points = nullptr;
+
+	uint64_t mask = 0;					// Table size - 1
+	vector<uint32_t> bucketStart;		// The points of bucket b are bucketPoints[bucketStart[b] .. bucketStart[b + 1])
+	vector<uint32_t> bucketPoints;
+
+	[[nodiscard]] int64_t cell(const float coordinate) const { return static_cast<int64_t>(floor(coordinate / cellSize)); }
+
+	[[nodiscard]] uint64_t bucket(const int64_t x, const int64_t y, const int64_t z) const {
+		return (static_cast<uint64_t>(x) * 73856093u ^ static_cast<uint64_t>(y) * 19349663u ^ static_cast<uint64_t>(z) * 83492791u) & mask;
+	}
+};
+
+
+template <typename F>
+void SpatialHash::forEachNear(const Vector3& p, const float radius, F&& fn) const {
+	if (!points || bucketStart.empty()) return;
+
+	const int64_t x0 = cell(p.x - radius), x1 = cell(p.x + radius);
+	const int64_t y0 = cell(p.y - radius), y1 = cell(p.y + radius);
+	const int64_t z0 = cell(p.z - radius), z1 = cell(p.z + radius);
+	const float radiusSquared = radius * radius;
+
+	// Up to 3 cells per axis if radius <= cellSize; larger radii need a buffer sized to the query box
+	const auto cellCount = static_cast<size_t>((x1 - x0 + 1) * (y1 - y0 + 1) * (z1 - z0 + 1));
+	uint64_t nearby[27];
+	vector<uint64_t> distant;
+	uint64_t* visited = nearby;
+	if (cellCount > size(nearby)) {
+		distant.resize(cellCount);
+		visited = distant.data();
+	}
+	size_t visitedCount = 0;
+
+	for (int64_t z = z0; z <= z1; z++) {
+		for (int64_t y = y0; y <= y1; y++) {
+			for (int64_t x = x0; x <= x1; x++) {
+				// Neighboring cells can share a bucket, which must only be visited once
+				const uint64_t b = bucket(x, y, z);
+				if (find(visited, visited + visitedCount, b) != visited + visitedCount) continue;
+				visited[visitedCount++] = b;
+
+				for (uint32_t k = bucketStart[b]; k < bucketStart[b + 1]; k++) {
+					const uint32_t index = bucketPoints[k];
+					const auto d = (*points)[index] - p;
+					if (d.dot(d) <= radiusSquared) fn(index);
+				}
+			}
+		}
+	}
+}
@@ -0,0 +1,175 @@
+#include "BatchTransform.h"
+
+#include <algorithm>
+
+#include "Matrix4.h"
+#include "jobs/JobSystem.h"
+#include "math/Simd.h"
+#include "math/geometry/Vertex.h"
+
+
+void PointBatch::gather(const vector<shared_ptr<Vertex>>& vertices) {
+	resize(vertices.size());
+	for (size_t i = 0; i < vertices.size(); i++) {
+		const auto& p = vertices[i]->position;
+		x[i] = p.x; y[i] = p.y; z[i] = p.z;
+	}
+}
+
+void PointBatch::scatter(const vector<shared_ptr<Vertex>>& vertices) const {
+	for (size_t i = 0; i < vertices.size(); i++) {
+		vertices[i]->position = Vector3(x[i], y[i], z[i]);
+	}
+}
+
+
+/*
+ * Kernels over [i, end) of a batch, with m column-major. The vector ones return where they stopped,
+ * the next narrower kernel finishes the rest. All coordinates of a point are loaded before any are
+ * stored, so the input and output batches may alias.
+ */
+
+static void transformScalar(const float* m, const PointBatch& in, PointBatch& out, size_t i, const size_t end) {
+	for (; i < end; i++) {
+		const float x = in.x[i], y = in.y[i], z = in.z[i];
+		out.x[i] = m[0] * x + m[4] * y + m[8]  * z + m[12];
+		out.y[i] = m[1] * x + m[5] * y + m[9]  * z + m[13];
+		out.z[i] = m[2] * x + m[6] * y + m[10] * z + m[14];
+	}
+}
+
+static void projectScalar(const float* m, const float hw, const float hh, const PointBatch& in, ScreenBatch& out, size_t i, const size_t end) {
+	for (; i < end; i++) {
+		const float x = in.x[i], y = in.y[i], z = in.z[i];
+		const float cx = m[0] * x + m[4] * y + m[8]  * z + m[12];
+		const float cy = m[1] * x + m[5] * y + m[9]  * z + m[13];
+		const float w  = m[3] * x + m[7] * y + m[11] * z + m[15];
+
+		out.x[i] = (cx / w + 1.0f) * hw;
+		out.y[i] = (1.0f - cy / w) * hh;
+		out.w[i] = w;
+	}
+}
+
+#ifdef USE_SSE
+static size_t transformSSE(const float* m, const PointBatch& in, PointBatch& out, size_t i, const size_t end) {
+	const __m128 m0 = _mm_set1_ps(m[0]), m4 = _mm_set1_ps(m[4]), m8  = _mm_set1_ps(m[8]),  m12 = _mm_set1_ps(m[12]);
+	const __m128 m1 = _mm_set1_ps(m[1]), m5 = _mm_set1_ps(m[5]), m9  = _mm_set1_ps(m[9]),  m13 = _mm_set1_ps(m[13]);
+	const __m128 m2 = _mm_set1_ps(m[2]), m6 = _mm_set1_ps(m[6]), m10 = _mm_set1_ps(m[10]), m14 = _mm_set1_ps(m[14]);
+
+	for (; i + 4 <= end; i += 4) {
+		const __m128 x = _mm_loadu_ps(&in.x[i]);
+		const __m128 y = _mm_loadu_ps(&in.y[i]);
+		const __m128 z = _mm_loadu_ps(&in.z[i]);
+
+		_mm_storeu_ps(&out.x[i], _mm_add_ps(_mm_add_ps(_mm_mul_ps(m0, x), _mm_mul_ps(m4, y)), _mm_add_ps(_mm_mul_ps(m8,  z), m12)));
+		_mm_storeu_ps(&out.y[i], _mm_add_ps(_mm_add_ps(_mm_mul_ps(m1, x), _mm_mul_ps(m5, y)), _mm_add_ps(_mm_mul_ps(m9,  z), m13)));
+		_mm_storeu_ps(&out.z[i], _mm_add_ps(_mm_add_ps(_mm_mul_ps(m2, x), _mm_mul_ps(m6, y)), _mm_add_ps(_mm_mul_ps(m10, z), m14)));
+	}
+	return i;
+}
+
+static size_t projectSSE(const float* m, const float hw, const float hh, const PointBatch& in, ScreenBatch& out, size_t i, const size_t end) {
+	const __m128 m0 = _mm_set1_ps(m[0]), m4 = _mm_set1_ps(m[4]), m8  = _mm_set1_ps(m[8]),  m12 = _mm_set1_ps(m[12]);
+	const __m128 m1 = _mm_set1_ps(m[1]), m5 = _mm_set1_ps(m[5]), m9  = _mm_set1_ps(m[9]),  m13 = _mm_set1_ps(m[13]);
+	const __m128 m3 = _mm_set1_ps(m[3]), m7 = _mm_set1_ps(m[7]), m11 = _mm_set1_ps(m[11]), m15 = _mm_set1_ps(m[15]);
+	const __m128 one = _mm_set1_ps(1.0f);
+	const __m128 halfWidth = _mm_set1_ps(hw), halfHeight = _mm_set1_ps(hh);
+
+	for (; i + 4 <= end; i += 4) {
+		const __m128 x = _mm_loadu_ps(&in.x[i]);
+		const __m128 y = _mm_loadu_ps(&in.y[i]);
+		const __m128 z = _mm_loadu_ps(&in.z[i]);
+
+		const __m128 cx = _mm_add_ps(_mm_add_ps(_mm_mul_ps(m0, x), _mm_mul_ps(m4, y)), _mm_add_ps(_mm_mul_ps(m8,  z), m12));
+		const __m128 cy = _mm_add_ps(_mm_add_ps(_mm_mul_ps(m1, x), _mm_mul_ps(m5, y)), _mm_add_ps(_mm_mul_ps(m9,  z), m13));
+		const __m128 w  = _mm_add_ps(_mm_add_ps(_mm_mul_ps(m3, x), _mm_mul_ps(m7, y)), _mm_add_ps(_mm_mul_ps(m11, z), m15));
+
+		const __m128 invW = _mm_div_ps(one, w);
+		_mm_storeu_ps(&out.x[i], _mm_mul_ps(_mm_add_ps(_mm_mul_ps(cx, invW), one), halfWidth));
+		_mm_storeu_ps(&out.y[i], _mm_mul_ps(_mm_sub_ps(one, _mm_mul_ps(cy, invW)), halfHeight));
+		_mm_storeu_ps(&out.w[i], w);
+	}
+	return i;
+}
+
+TARGET_AVX2
+static size_t transformAVX2(const float* m, const PointBatch& in, PointBatch& out, size_t i, const size_t end) {
+	const __m256 m0 = _mm256_set1_ps(m[0]), m4 = _mm256_set1_ps(m[4]), m8  = _mm256_set1_ps(m[8]),  m12 = _mm256_set1_ps(m[12]);
+	const __m256 m1 = _mm256_set1_ps(m[1]), m5 = _mm256_set1_ps(m[5]), m9  = _mm256_set1_ps(m[9]),  m13 = _mm256_set1_ps(m[13]);
+	const __m256 m2 = _mm256_set1_ps(m[2]), m6 = _mm256_set1_ps(m[6]), m10 = _mm256_set1_ps(m[10]), m14 = _mm256_set1_ps(m[14]);
+
+	for (; i + 8 <= end; i += 8) {
+		const __m256 x = _mm256_loadu_ps(&in.x[i]);
+		const __m256 y = _mm256_loadu_ps(&in.y[i]);
+		const __m256 z = _mm256_loadu_ps(&in.z[i]);
+
+		_mm256_storeu_ps(&out.x[i], _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(m0, x), _mm256_mul_ps(m4, y)), _mm256_add_ps(_mm256_mul_ps(m8,  z), m12)));
+		_mm256_storeu_ps(&out.y[i], _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(m1, x), _mm256_mul_ps(m5, y)), _mm256_add_ps(_mm256_mul_ps(m9,  z), m13)));
+		_mm256_storeu_ps(&out.z[i], _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(m2, x), _mm256_mul_ps(m6, y)), _mm256_add_ps(_mm256_mul_ps(m10, z), m14)));
+	}
+	return i;
+}
+
+TARGET_AVX2
+static size_t projectAVX2(const float* m, const float hw, const float hh, const PointBatch& in, ScreenBatch& out, size_t i, const size_t end) {
+	const __m256 m0 = _mm256_set1_ps(m[0]), m4 = _mm256_set1_ps(m[4]), m8  = _mm256_set1_ps(m[8]),  m12 = _mm256_set1_ps(m[12]);
+	const __m256 m1 = _mm256_set1_ps(m[1]), m5 = _mm256_set1_ps(m[5]), m9  = _mm256_set1_ps(m[9]),  m13 = _mm256_set1_ps(m[13]);
+	const __m256 m3 = _mm256_set1_ps(m[3]), m7 = _mm256_set1_ps(m[7]), m11 = _mm256_set1_ps(m[11]), m15 = _mm256_set1_ps(m[15]);
+	const __m256 one = _mm256_set1_ps(1.0f);
+	const __m256 halfWidth = _mm256_set1_ps(hw), halfHeight = _mm256_set1_ps(hh);
+
+	for (; i + 8 <= end; i += 8) {
+		const __m256 x = _mm256_loadu_ps(&in.x[i]);
+		const __m256 y = _mm256_loadu_ps(&in.y[i]);
+		const __m256 z = _mm256_loadu_ps(&in.z[i]);
+
+		const __m256 cx = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(m0, x), _mm256_mul_ps(m4, y)), _mm256_add_ps(_mm256_mul_ps(m8,  z), m12));
+		const __m256 cy = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(m1, x), _mm256_mul_ps(m5, y)), _mm256_add_ps(_mm256_mul_ps(m9,  z), m13));
+		const __m256 w  = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(m3, x), _mm256_mul_ps(m7, y)), _mm256_add_ps(_mm256_mul_ps(m11, z), m15));
+
+		const __m256 invW = _mm256_div_ps(one, w);
+		_mm256_storeu_ps(&out.x[i], _mm256_mul_ps(_mm256_add_ps(_mm256_mul_ps(cx, invW), one), halfWidth));
+		_mm256_storeu_ps(&out.y[i], _mm256_mul_ps(_mm256_sub_ps(one, _mm256_mul_ps(cy, invW)), halfHeight));
+		_mm256_storeu_ps(&out.w[i], w);
+	}
+	return i;
+}
+#endif
+
+
+void transformPoints(const Matrix4& m, const PointBatch& in, PointBatch& out) {
+	const size_t n = in.size();
+	out.resize(n);
+
+	const float* e = m.data();
+	[[maybe_unused]] const bool avx2 = detectSimdLevel() >= SimdLevel::AVX2;
+	// Chunks are multiples of 8 points, so only the last one ends in a scalar tail
+	JobSystem::parallelFor(n, BATCH_PARALLEL_THRESHOLD, [&](const size_t begin, const size_t end) {
+		size_t i = begin;
+	#ifdef USE_SSE
+		if (avx2) i = transformAVX2(e, in, out, i, end);
+		i = transformSSE(e, in, out, i, end);
+	#endif
+		transformScalar(e, in, out, i, end);
+	}, 8);
+}
+
+void projectPoints(const Matrix4& viewProj, const array<int, 4>& viewport, const PointBatch& in, ScreenBatch& out) {
+	const size_t n = in.size();
+	out.resize(n);
+
+	const float* e = viewProj.data();
+	const float hw = static_cast<float>(viewport[2]) * 0.5f;
+	const float hh = static_cast<float>(viewport[3]) * 0.5f;
+	[[maybe_unused]] const bool avx2 = detectSimdLevel() >= SimdLevel::AVX2;
+	// Chunks are multiples of 8 points, so only the last one ends in a scalar tail
+	JobSystem::parallelFor(n, BATCH_PARALLEL_THRESHOLD, [&](const size_t begin, const size_t end) {
+		size_t i = begin;
+	#ifdef USE_SSE
+		if (avx2) i = projectAVX2(e, hw, hh, in, out, i, end);
+		i = projectSSE(e, hw, hh, in, out, i, end);
+	#endif
+		projectScalar(e, hw, hh, in, out, i, end);
+	}, 8);
+}
@@ -0,0 +1,42 @@
+#pragma once
+
+using namespace std;
+
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+class Matrix4;
+struct Vertex;
+
+// Constants
+constexpr size_t BATCH_PARALLEL_THRESHOLD = 1 << 16;	// Batches this large are split across all cores
+
+
+/** Positions as a structure of arrays, so the kernels below can load 4 (SSE) or 8 (AVX2) coordinates at once */
+struct PointBatch {
+	vector<float> x, y, z;
+
+	void resize(const size_t n) { x.resize(n); y.resize(n); z.resize(n); }
+	[[nodiscard]] size_t size() const { return x.size(); }
+
+	/** Copy the positions of the Vertices in, or write them back */
+	void gather(const vector<shared_ptr<Vertex>> &vertices);
+	void scatter(const vector<shared_ptr<Vertex>> &vertices) const;
+};
+
+/** Window coordinates (top-left origin) and clip-space w, which is the view depth and <= 0 behind the camera */
+struct ScreenBatch {
+	vector<float> x, y, w;
+
+	void resize(const size_t n) { x.resize(n); y.resize(n); w.resize(n); }
+	[[nodiscard]] size_t size() const { return x.size(); }
+};
+
+
+/** out[i] = m * (in[i], 1), ignoring the resulting w. in and out may be the same batch */
+void transformPoints(const Matrix4 &m, const PointBatch &in, PointBatch &out);
+
+/** Transform by the view-projection matrix, divide by w and map to the viewport size in one pass */
+void projectPoints(const Matrix4 &viewProj, const array<int, 4> &viewport, const PointBatch &in, ScreenBatch &out);
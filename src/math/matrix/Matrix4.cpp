@@ -2,139 +2,103 @@
 
 #include <array>
 #include <cmath>
+#include <cstring>
 
+#include "math/Simd.h"
 #include "math/Util.h"
 
 
-// Constructor with array
-Matrix4::Matrix4(const float* arr) {
-	m11 = arr[0];  m21 = arr[4];  m31 = arr[8];   m41 = arr[12];
-	m12 = arr[1];  m22 = arr[5];  m32 = arr[9];   m42 = arr[13];
-	m13 = arr[2];  m23 = arr[6];  m33 = arr[10];  m43 = arr[14];
-	m14 = arr[3];  m24 = arr[7];  m34 = arr[11];  m44 = arr[15];
-}
-
-// Constructor with array
-Matrix4::Matrix4(const array<float, 16>& arr) {
-	m11 = arr[0];  m21 = arr[4];  m31 = arr[8];   m41 = arr[12];
-	m12 = arr[1];  m22 = arr[5];  m32 = arr[9];   m42 = arr[13];
-	m13 = arr[2];  m23 = arr[6];  m33 = arr[10];  m43 = arr[14];
-	m14 = arr[3];  m24 = arr[7];  m34 = arr[11];  m44 = arr[15];
-}
-
-// Constructor with initializer list
-Matrix4::Matrix4(const initializer_list<float> list) {
-	if (list.size() != 16) {
-		throw invalid_argument("Initializer list must have exactly 16 elements.");
-	}
-	auto it = list.begin();
-	m11 = *it++; m21 = *it++; m31 = *it++; m41 = *it++;
-	m12 = *it++; m22 = *it++; m32 = *it++; m42 = *it++;
-	m13 = *it++; m23 = *it++; m33 = *it++; m43 = *it++;
-	m14 = *it++; m24 = *it++; m34 = *it++; m44 = *it++;
-}
-
 // Helper function to convert the matrix to a float array
 void Matrix4::toFloatArray(float out[16]) const {
-	out[0] = m11;  out[4] = m21;  out[8]  = m31;  out[12] = m41;
-	out[1] = m12;  out[5] = m22;  out[9]  = m32;  out[13] = m42;
-	out[2] = m13;  out[6] = m23;  out[10] = m33;  out[14] = m43;
-	out[3] = m14;  out[7] = m24;  out[11] = m34;  out[15] = m44;
+	memcpy(out, m, sizeof(m));
 }
 
 Matrix4 Matrix4::operator-(const Matrix4& other) const {
 	Matrix4 result;
-	result.m11 = m11 - other.m11;
-	result.m21 = m21 - other.m21;
-	result.m31 = m31 - other.m31;
-	result.m41 = m41 - other.m41;
-
-	result.m12 = m12 - other.m12;
-	result.m22 = m22 - other.m22;
-	result.m32 = m32 - other.m32;
-	result.m42 = m42 - other.m42;
-
-	result.m13 = m13 - other.m13;
-	result.m23 = m23 - other.m23;
-	result.m33 = m33 - other.m33;
-	result.m43 = m43 - other.m43;
-
-	result.m14 = m14 - other.m14;
-	result.m24 = m24 - other.m24;
-	result.m34 = m34 - other.m34;
-	result.m44 = m44 - other.m44;
-
+#ifdef USE_SSE
+	for (int col = 0; col < 16; col += 4) {
+		_mm_store_ps(result.m + col, _mm_sub_ps(_mm_load_ps(m + col), _mm_load_ps(other.m + col)));
+	}
+#else
+	for (int i = 0; i < 16; i++) result.m[i] = m[i] - other.m[i];
+#endif
 	return result;
 }
 
 /**
  * @brief Multiplies this matrix by a given Vector4.
  *
- * This operator performs matrix-vector multiplication, resulting in a new Vector4.
- * Each component of the resulting vector is computed as the dot product of the
- * corresponding row of the matrix and the input vector.
+ * The result is the sum of the columns of the matrix, each weighted by the corresponding
+ * component of the vector, which maps directly to 4 SSE multiply-adds.
  *
  * @param v The Vector4 to be multiplied by this matrix.
  * @return A new Vector4 that is the result of the matrix-vector multiplication.
  */
 Vector4 Matrix4::operator*(const Vector4 &v) const {
-	return Vector4({
-        m11 * v.x + m21 * v.y + m31 * v.z + m41 * v.w,
-        m12 * v.x + m22 * v.y + m32 * v.z + m42 * v.w,
-        m13 * v.x + m23 * v.y + m33 * v.z + m43 * v.w,
-        m14 * v.x + m24 * v.y + m34 + v.z + m44 * v.w
-    });
+#ifdef USE_SSE
+	__m128 r = _mm_mul_ps(_mm_load_ps(m), _mm_set1_ps(v.x));
+	r = _mm_add_ps(r, _mm_mul_ps(_mm_load_ps(m + 4),  _mm_set1_ps(v.y)));
+	r = _mm_add_ps(r, _mm_mul_ps(_mm_load_ps(m + 8),  _mm_set1_ps(v.z)));
+	r = _mm_add_ps(r, _mm_mul_ps(_mm_load_ps(m + 12), _mm_set1_ps(v.w)));
+
+	alignas(16) float out[4];
+	_mm_store_ps(out, r);
+	return {out[0], out[1], out[2], out[3]};
+#else
+	return {
+		m[0] * v.x + m[4] * v.y + m[8]  * v.z + m[12] * v.w,
+		m[1] * v.x + m[5] * v.y + m[9]  * v.z + m[13] * v.w,
+		m[2] * v.x + m[6] * v.y + m[10] * v.z + m[14] * v.w,
+		m[3] * v.x + m[7] * v.y + m[11] * v.z + m[15] * v.w
+	};
+#endif
 }
 
 /**
  * @brief Overloaded multiplication operator for Matrix4.
  *
- * This operator multiplies the current Matrix4 instance with another Matrix4 instance.
- * The multiplication is performed in a standard matrix multiplication manner.
+ * Every column of the result is this matrix multiplied by the corresponding column of the other one.
  *
  * @param other The right-hand side Matrix4 to be multiplied with the current instance.
  * @return Matrix4 The result of the matrix multiplication.
  */
 Matrix4 Matrix4::operator*(const Matrix4 &other) const {
-	return Matrix4({
-        m11 * other.m11 + m21 * other.m12 + m31 * other.m13 + m41 * other.m14,
-        m11 * other.m21 + m21 * other.m22 + m31 * other.m23 + m41 * other.m24,
-        m11 * other.m31 + m21 * other.m32 + m31 * other.m33 + m41 * other.m34,
-        m11 * other.m41 + m21 * other.m42 + m31 * other.m43 + m41 * other.m44,
-
-        m12 * other.m11 + m22 * other.m12 + m32 * other.m13 + m42 * other.m14,
-        m12 * other.m21 + m22 * other.m22 + m32 * other.m23 + m42 * other.m24,
-        m12 * other.m31 + m22 * other.m32 + m32 * other.m33 + m42 * other.m34,
-        m12 * other.m41 + m22 * other.m42 + m32 * other.m43 + m42 * other.m44,
-
-        m13 * other.m11 + m23 * other.m12 + m33 * other.m13 + m43 * other.m14,
-        m13 * other.m21 + m23 * other.m22 + m33 * other.m23 + m43 * other.m24,
-        m13 * other.m31 + m23 * other.m32 + m33 * other.m33 + m43 * other.m34,
-        m13 * other.m41 + m23 * other.m42 + m33 * other.m43 + m43 * other.m44,
-
-        m14 * other.m11 + m24 * other.m12 + m34 * other.m13 + m44 * other.m14,
-        m14 * other.m21 + m24 * other.m22 + m34 * other.m23 + m44 * other.m24,
-        m14 * other.m31 + m24 * other.m32 + m34 * other.m33 + m44 * other.m34,
-        m14 * other.m41 + m24 * other.m42 + m34 * other.m43 + m44 * other.m44
-    });
-}
-
-Matrix4 Matrix4::translate(const Vector3& t) {
-    return Matrix4({
-		1, 0, 0, t.x,
-		0, 1, 0, t.y,
-		0, 0, 1, t.z,
-		0, 0, 0, 1
-	});
+	Matrix4 result;
+#ifdef USE_SSE
+	const __m128 c0 = _mm_load_ps(m), c1 = _mm_load_ps(m + 4), c2 = _mm_load_ps(m + 8), c3 = _mm_load_ps(m + 12);
+	for (int col = 0; col < 16; col += 4) {
+		const float* o = other.m + col;
+		__m128 r = _mm_mul_ps(c0, _mm_set1_ps(o[0]));
+		r = _mm_add_ps(r, _mm_mul_ps(c1, _mm_set1_ps(o[1])));
+		r = _mm_add_ps(r, _mm_mul_ps(c2, _mm_set1_ps(o[2])));
+		r = _mm_add_ps(r, _mm_mul_ps(c3, _mm_set1_ps(o[3])));
+		_mm_store_ps(result.m + col, r);
+	}
+#else
+	for (int col = 0; col < 4; col++) {
+		for (int row = 0; row < 4; row++) {
+			result.at(row, col) = (*this)(row, 0) * other(0, col) + (*this)(row, 1) * other(1, col)
+								+ (*this)(row, 2) * other(2, col) + (*this)(row, 3) * other(3, col);
+		}
+	}
+#endif
+	return result;
 }
 
-Matrix4 Matrix4::scale(const Vector3& s) {
-    return Matrix4({
-		s.x, 0, 0, 0,
-		0, s.y, 0, 0,
-		0, 0, s.z, 0,
-		0, 0, 0, 1
-	});
+Vector3 Matrix4::transformPoint(const Vector3& p) const {
+	return {
+		m[0] * p.x + m[4] * p.y + m[8]  * p.z + m[12],
+		m[1] * p.x + m[5] * p.y + m[9]  * p.z + m[13],
+		m[2] * p.x + m[6] * p.y + m[10] * p.z + m[14]
+	};
+}
+
+Vector3 Matrix4::transformDirection(const Vector3& d) const {
+	return {
+		m[0] * d.x + m[4] * d.y + m[8]  * d.z,
+		m[1] * d.x + m[5] * d.y + m[9]  * d.z,
+		m[2] * d.x + m[6] * d.y + m[10] * d.z
+	};
 }
 
 Matrix4 Matrix4::rotateX(const float a) {
@@ -164,62 +128,175 @@ Matrix4 Matrix4::rotateZ(const float a) {
 	});
 }
 
-[[nodiscard]] Matrix4 Matrix4::invert() const {
-   float inv[16];
+Matrix4 Matrix4::transpose() const {
+	Matrix4 result;
+#ifdef USE_SSE
+	__m128 c0 = _mm_load_ps(m), c1 = _mm_load_ps(m + 4), c2 = _mm_load_ps(m + 8), c3 = _mm_load_ps(m + 12);
+	_MM_TRANSPOSE4_PS(c0, c1, c2, c3);
+	_mm_store_ps(result.m, c0);
+	_mm_store_ps(result.m + 4, c1);
+	_mm_store_ps(result.m + 8, c2);
+	_mm_store_ps(result.m + 12, c3);
+#else
+	for (int row = 0; row < 4; row++) {
+		for (int col = 0; col < 4; col++) {
+			result.at(col, row) = (*this)(row, col);
+		}
+	}
+#endif
+	return result;
+}
+
+
+#ifdef USE_SSE
+/** Lanes of v picked by a _MM_SHUFFLE-style index list (first index goes to lane 0) */
+#define SWIZZLE(v, x, y, z, w) _mm_shuffle_ps(v, v, _MM_SHUFFLE(w, z, y, x))
+
+// 2x2 matrices packed into one register as (a, b, c, d) = | a b |
+//                                                         | c d |
+
+/** A * B */
+static __m128 mul2x2(const __m128 a, const __m128 b) {
+	return _mm_add_ps(
+		_mm_mul_ps(a, SWIZZLE(b, 0, 3, 0, 3)),
+		_mm_mul_ps(SWIZZLE(a, 1, 0, 3, 2), SWIZZLE(b, 2, 1, 2, 1))
+	);
+}
+
+/** adj(A) * B */
+static __m128 adjMul2x2(const __m128 a, const __m128 b) {
+	return _mm_sub_ps(
+		_mm_mul_ps(SWIZZLE(a, 3, 3, 0, 0), b),
+		_mm_mul_ps(SWIZZLE(a, 1, 1, 2, 2), SWIZZLE(b, 2, 3, 0, 1))
+	);
+}
+
+/** A * adj(B) */
+static __m128 mulAdj2x2(const __m128 a, const __m128 b) {
+	return _mm_sub_ps(
+		_mm_mul_ps(a, SWIZZLE(b, 3, 0, 3, 0)),
+		_mm_mul_ps(SWIZZLE(a, 1, 0, 3, 2), SWIZZLE(b, 2, 1, 2, 1))
+	);
+}
+#endif
+
+/**
+ * Inverse through the 2x2 blocks of the matrix, M = | A B |, using
+ *                                                   | C D |
+ * |M| = |A||D| + |B||C| - tr(adj(A) B adj(D) C) and the adjugates of the blocks of the inverse.
+ *
+ * Inverting the transpose gives the transpose of the inverse, so the same code works on the
+ * columns as if they were rows. Without SSE, the cofactors are expanded directly.
+ */
+Matrix4 Matrix4::invert() const {
+	Matrix4 result;
+#ifdef USE_SSE
+	const __m128 r0 = _mm_load_ps(m), r1 = _mm_load_ps(m + 4), r2 = _mm_load_ps(m + 8), r3 = _mm_load_ps(m + 12);
+
+	const __m128 a = _mm_movelh_ps(r0, r1);
+	const __m128 b = _mm_movehl_ps(r1, r0);
+	const __m128 c = _mm_movelh_ps(r2, r3);
+	const __m128 d = _mm_movehl_ps(r3, r2);
+
+	// Determinants of the blocks as (|A|, |B|, |C|, |D|)
+	const __m128 detBlocks = _mm_sub_ps(
+		_mm_mul_ps(_mm_shuffle_ps(r0, r2, _MM_SHUFFLE(2, 0, 2, 0)), _mm_shuffle_ps(r1, r3, _MM_SHUFFLE(3, 1, 3, 1))),
+		_mm_mul_ps(_mm_shuffle_ps(r0, r2, _MM_SHUFFLE(3, 1, 3, 1)), _mm_shuffle_ps(r1, r3, _MM_SHUFFLE(2, 0, 2, 0)))
+	);
+	const __m128 detA = SWIZZLE(detBlocks, 0, 0, 0, 0);
+	const __m128 detB = SWIZZLE(detBlocks, 1, 1, 1, 1);
+	const __m128 detC = SWIZZLE(detBlocks, 2, 2, 2, 2);
+	const __m128 detD = SWIZZLE(detBlocks, 3, 3, 3, 3);
+
+	const __m128 adjDC = adjMul2x2(d, c);
+	const __m128 adjAB = adjMul2x2(a, b);
+
+	// Adjugates of the blocks of the inverse (before dividing by |M|)
+	__m128 x = _mm_sub_ps(_mm_mul_ps(detD, a), mul2x2(b, adjDC));
+	__m128 w = _mm_sub_ps(_mm_mul_ps(detA, d), mul2x2(c, adjAB));
+	__m128 y = _mm_sub_ps(_mm_mul_ps(detB, c), mulAdj2x2(d, adjAB));
+	__m128 z = _mm_sub_ps(_mm_mul_ps(detC, b), mulAdj2x2(a, adjDC));
+
+	// Trace of adj(A) B adj(D) C, summed across the lanes
+	__m128 trace = _mm_mul_ps(adjAB, SWIZZLE(adjDC, 0, 2, 1, 3));
+	trace = _mm_add_ps(trace, SWIZZLE(trace, 2, 3, 0, 1));
+	trace = _mm_add_ps(trace, SWIZZLE(trace, 1, 0, 3, 2));
+
+	const __m128 det = _mm_sub_ps(_mm_add_ps(_mm_mul_ps(detA, detD), _mm_mul_ps(detB, detC)), trace);
+
+	const float determinant = _mm_cvtss_f32(det);
+	if (determinant > -EPSILON && determinant < EPSILON) throw runtime_error("Matrix is singular and cannot be inverted.");
+
+	// Signs of the adjugate, divided by |M|
+	const __m128 scale = _mm_div_ps(_mm_setr_ps(1.0f, -1.0f, -1.0f, 1.0f), det);
+	x = _mm_mul_ps(x, scale);
+	y = _mm_mul_ps(y, scale);
+	z = _mm_mul_ps(z, scale);
+	w = _mm_mul_ps(w, scale);
+
+	// Undo the adjugate shuffle while reassembling the blocks
+	_mm_store_ps(result.m,		_mm_shuffle_ps(x, y, _MM_SHUFFLE(1, 3, 1, 3)));
+	_mm_store_ps(result.m + 4,	_mm_shuffle_ps(x, y, _MM_SHUFFLE(0, 2, 0, 2)));
+	_mm_store_ps(result.m + 8,	_mm_shuffle_ps(z, w, _MM_SHUFFLE(1, 3, 1, 3)));
+	_mm_store_ps(result.m + 12,	_mm_shuffle_ps(z, w, _MM_SHUFFLE(0, 2, 0, 2)));
+#else
+	float* inv = result.m;
 
     // Calculate the cofactor matrix
-    inv[0]  =  m22 * m33 * m44 - m22 * m34 * m43 - m32 * m23 * m44 + m32 * m24 * m43 + m42 * m23 * m34 - m42 * m24 * m33;
-	inv[4]  = -m21 * m33 * m44 + m21 * m34 * m43 + m31 * m23 * m44 - m31 * m24 * m43 - m41 * m23 * m34 + m41 * m24 * m33;
-	inv[8]  =  m21 * m32 * m44 - m21 * m34 * m42 - m31 * m22 * m44 + m31 * m24 * m42 + m41 * m22 * m34 - m41 * m24 * m32;
-	inv[12] = -m21 * m32 * m43 + m21 * m33 * m42 + m31 * m22 * m43 - m31 * m23 * m42 - m41 * m22 * m33 + m41 * m23 * m32;
-
-	inv[1]  = -m12 * m33 * m44 + m12 * m34 * m43 + m32 * m13 * m44 - m32 * m14 * m43 - m42 * m13 * m34 + m42 * m14 * m33;
-	inv[5]  =  m11 * m33 * m44 - m11 * m34 * m43 - m31 * m13 * m44 + m31 * m14 * m43 + m41 * m13 * m34 - m41 * m14 * m33;
-	inv[9]  = -m11 * m32 * m44 + m11 * m34 * m42 + m31 * m12 * m44 - m31 * m14 * m42 - m41 * m12 * m34 + m41 * m14 * m32;
-	inv[13] =  m11 * m32 * m43 - m11 * m33 * m42 - m31 * m12 * m43 + m31 * m13 * m42 + m41 * m12 * m33 - m41 * m13 * m32;
-
-	inv[2]  =  m12 * m23 * m44 - m12 * m24 * m43 - m22 * m13 * m44 + m22 * m14 * m43 + m42 * m13 * m24 - m42 * m14 * m23;
-	inv[6]  = -m11 * m23 * m44 + m11 * m24 * m43 + m21 * m13 * m44 - m21 * m14 * m43 - m41 * m13 * m24 + m41 * m14 * m23;
-	inv[10] =  m11 * m22 * m44 - m11 * m24 * m42 - m21 * m12 * m44 + m21 * m14 * m42 + m41 * m12 * m24 - m41 * m14 * m22;
-	inv[14] = -m11 * m22 * m43 + m11 * m23 * m42 + m21 * m12 * m43 - m21 * m13 * m42 - m41 * m12 * m23 + m41 * m13 * m22;
-
-	inv[3]  = -m12 * m23 * m34 + m12 * m24 * m33 + m22 * m13 * m34 - m22 * m14 * m33 - m32 * m13 * m24 + m32 * m14 * m23;
-	inv[7]  =  m11 * m23 * m34 - m11 * m24 * m33 - m21 * m13 * m34 + m21 * m14 * m33 + m31 * m13 * m24 - m31 * m14 * m23;
-	inv[11] = -m11 * m22 * m34 + m11 * m24 * m32 + m21 * m12 * m34 - m21 * m14 * m32 - m31 * m12 * m24 + m31 * m14 * m22;
-	inv[15] =  m11 * m22 * m33 - m11 * m23 * m32 - m21 * m12 * m33 + m21 * m13 * m32 + m31 * m12 * m23 - m31 * m13 * m22;
+	inv[0]  =  m[5] * m[10] * m[15] - m[5] * m[11] * m[14] - m[9] * m[6] * m[15] + m[9] * m[7] * m[14] + m[13] * m[6] * m[11] - m[13] * m[7] * m[10];
+	inv[4]  = -m[4] * m[10] * m[15] + m[4] * m[11] * m[14] + m[8] * m[6] * m[15] - m[8] * m[7] * m[14] - m[12] * m[6] * m[11] + m[12] * m[7] * m[10];
+	inv[8]  =  m[4] * m[9]  * m[15] - m[4] * m[11] * m[13] - m[8] * m[5] * m[15] + m[8] * m[7] * m[13] + m[12] * m[5] * m[11] - m[12] * m[7] * m[9];
+	inv[12] = -m[4] * m[9]  * m[14] + m[4] * m[10] * m[13] + m[8] * m[5] * m[14] - m[8] * m[6] * m[13] - m[12] * m[5] * m[10] + m[12] * m[6] * m[9];
+
+	inv[1]  = -m[1] * m[10] * m[15] + m[1] * m[11] * m[14] + m[9] * m[2] * m[15] - m[9] * m[3] * m[14] - m[13] * m[2] * m[11] + m[13] * m[3] * m[10];
+	inv[5]  =  m[0] * m[10] * m[15] - m[0] * m[11] * m[14] - m[8] * m[2] * m[15] + m[8] * m[3] * m[14] + m[12] * m[2] * m[11] - m[12] * m[3] * m[10];
+	inv[9]  = -m[0] * m[9]  * m[15] + m[0] * m[11] * m[13] + m[8] * m[1] * m[15] - m[8] * m[3] * m[13] - m[12] * m[1] * m[11] + m[12] * m[3] * m[9];
+	inv[13] =  m[0] * m[9]  * m[14] - m[0] * m[10] * m[13] - m[8] * m[1] * m[14] + m[8] * m[2] * m[13] + m[12] * m[1] * m[10] - m[12] * m[2] * m[9];
+
+	inv[2]  =  m[1] * m[6]  * m[15] - m[1] * m[7]  * m[14] - m[5] * m[2] * m[15] + m[5] * m[3] * m[14] + m[13] * m[2] * m[7]  - m[13] * m[3] * m[6];
+	inv[6]  = -m[0] * m[6]  * m[15] + m[0] * m[7]  * m[14] + m[4] * m[2] * m[15] - m[4] * m[3] * m[14] - m[12] * m[2] * m[7]  + m[12] * m[3] * m[6];
+	inv[10] =  m[0] * m[5]  * m[15] - m[0] * m[7]  * m[13] - m[4] * m[1] * m[15] + m[4] * m[3] * m[13] + m[12] * m[1] * m[7]  - m[12] * m[3] * m[5];
+	inv[14] = -m[0] * m[5]  * m[14] + m[0] * m[6]  * m[13] + m[4] * m[1] * m[14] - m[4] * m[2] * m[13] - m[12] * m[1] * m[6]  + m[12] * m[2] * m[5];
+
+	inv[3]  = -m[1] * m[6]  * m[11] + m[1] * m[7]  * m[10] + m[5] * m[2] * m[11] - m[5] * m[3] * m[10] - m[9]  * m[2] * m[7]  + m[9]  * m[3] * m[6];
+	inv[7]  =  m[0] * m[6]  * m[11] - m[0] * m[7]  * m[10] - m[4] * m[2] * m[11] + m[4] * m[3] * m[10] + m[8]  * m[2] * m[7]  - m[8]  * m[3] * m[6];
+	inv[11] = -m[0] * m[5]  * m[11] + m[0] * m[7]  * m[9]  + m[4] * m[1] * m[11] - m[4] * m[3] * m[9]  - m[8]  * m[1] * m[7]  + m[8]  * m[3] * m[5];
+	inv[15] =  m[0] * m[5]  * m[10] - m[0] * m[6]  * m[9]  - m[4] * m[1] * m[10] + m[4] * m[2] * m[9]  + m[8]  * m[1] * m[6]  - m[8]  * m[2] * m[5];
 
 	// Calculate the determinant
-	float det = m11 * inv[0] + m12 * inv[4] + m13 * inv[8] + m14 * inv[12];
+	float det = m[0] * inv[0] + m[1] * inv[4] + m[2] * inv[8] + m[3] * inv[12];
 
 	if (det > -EPSILON && det < EPSILON) throw runtime_error("Matrix is singular and cannot be inverted.");
 
 	det = 1.0f / det;
 
 	// Scale the inverse matrix by the determinant
-	for (float& i : inv) {
-		i *= det;
+	for (int i = 0; i < 16; i++) {
+		inv[i] *= det;
 	}
-
-    return Matrix4(inv);
+#endif
+	return result;
 }
 
 /** Extract Euler angles from a transformation matrix */
 [[nodiscard]] Vector3 Matrix4::extractEulerAngles() const {
-	// Compute sy (the magnitude of the first column vector of the 3x3 rotation submatrix)
-	const float sy = sqrt(m11 * m11 + m21 * m21);
+	const auto& r = *this;
+
+	// Compute sy (the magnitude of the first row vector of the 3x3 rotation submatrix)
+	const float sy = sqrt(r(0, 0) * r(0, 0) + r(0, 1) * r(0, 1));
 
 	// Check for singularity (gimbal lock)
 	const bool singular = sy < EPSILON;
 
 	float x, y, z; // Rotation angles (pitch, yaw, roll)
 	if (!singular) {
-		x = atan2(m32, m33); // Pitch (rotation around X-axis)
-		y = atan2(-m31, sy); // Yaw (rotation around Y-axis)
-		z = atan2(m21, m11); // Roll (rotation around Z-axis)
+		x = atan2(r(1, 2), r(2, 2));	// Pitch (rotation around X-axis)
+		y = atan2(-r(0, 2), sy);		// Yaw (rotation around Y-axis)
+		z = atan2(r(0, 1), r(0, 0));	// Roll (rotation around Z-axis)
 	} else {
-		x = atan2(-m23, m22); // Alternate calculation for pitch in singular case
-		y = atan2(-m31, sy);  // Yaw remains the same
-		z = 0;							 // Roll is indeterminate
+		x = atan2(-r(2, 1), r(1, 1));	// Alternate calculation for pitch in singular case
+		y = atan2(-r(0, 2), sy);		// Yaw remains the same
+		z = 0;							// Roll is indeterminate
 	}
 
 	return {
@@ -230,25 +307,10 @@ Matrix4 Matrix4::rotateZ(const float a) {
 }
 
 /**
- * Converts the matrix to column-major order and stores the result in the provided array.
+ * Copies the matrix (already column-major) into the provided array.
  *
  * @param values A reference to a 16-element array of floats where the column-major matrix elements will be stored.
  */
 void Matrix4::toColumnMajor(float (&values)[16]) const {
-    values[0] = m11;
-    values[1] = m12;
-    values[2] = m13;
-    values[3] = m14;
-    values[4] = m21;
-    values[5] = m22;
-    values[6] = m23;
-    values[7] = m24;
-    values[8] = m31;
-    values[9] = m32;
-    values[10] = m33;
-    values[11] = m34;
-    values[12] = m41;
-    values[13] = m42;
-    values[14] = m43;
-    values[15] = m44;
-}
\ No newline at end of file
+	memcpy(values, m, sizeof(m));
+}
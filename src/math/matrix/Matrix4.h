@@ -2,31 +2,92 @@
 
 using namespace std;
 
+#include <algorithm>
 #include <array>
+#include <initializer_list>
+#include <stdexcept>
+
+#include "math/vector/Vector3.h"
 
-class Vector3;
 class Vector4;
 
 
+/**
+ * 4x4 matrix for column vectors, stored column-major like OpenGL expects it,
+ * so data() can be handed to glLoadMatrixf/glUniformMatrix4fv without conversion.
+ *
+ * Every column is 16-byte aligned and processed as one SSE register (with scalar fallbacks).
+ * Construction, element access and the translation and scale factories are constexpr,
+ * so constant matrices can be built at compile time.
+ */
 class Matrix4 {
 public:
-	Matrix4() = default;							// Default Constructor
-	explicit Matrix4(const float* arr);				// Constructor with array
-	explicit Matrix4(const array<float, 16>& arr);	// Constructor with array
-	Matrix4(initializer_list<float> list);			// Constructor with initializer list
+	constexpr Matrix4() = default;	// Zero matrix
+
+	/** Constructor with column-major array */
+	constexpr explicit Matrix4(const float* arr) {
+		copy_n(arr, 16, m);
+	}
+
+	/** Constructor with column-major array */
+	constexpr explicit Matrix4(const array<float, 16>& arr) {
+		copy_n(arr.data(), 16, m);
+	}
+
+	/** Constructor with initializer list, row by row as written on paper */
+	constexpr Matrix4(const initializer_list<float> list) {
+		if (list.size() != 16) throw invalid_argument("Initializer list must have exactly 16 elements.");
+		auto it = list.begin();
+		for (int row = 0; row < 4; row++) {
+			for (int col = 0; col < 4; col++) {
+				at(row, col) = *it++;
+			}
+		}
+	}
+
+	static constexpr Matrix4 identity() {
+		Matrix4 result;
+		result.m[0] = result.m[5] = result.m[10] = result.m[15] = 1.0f;
+		return result;
+	}
 
 	void toFloatArray(float out[16]) const;
 
+	/** Column-major elements */
+	[[nodiscard]] constexpr const float* data() const { return m; }
+	[[nodiscard]] constexpr float operator()(const int row, const int col) const { return m[col * 4 + row]; }
+
 	Matrix4 operator-(const Matrix4& other) const;
     Vector4 operator*(const Vector4 &v) const;
     Matrix4 operator*(const Matrix4 &other) const;
 
-    static Matrix4 translate(const Vector3& t);
-	static Matrix4 scale(const Vector3& s);
+	/** Transform a point (w = 1) or a direction (w = 0), ignoring the resulting w */
+	[[nodiscard]] Vector3 transformPoint(const Vector3 &p) const;
+	[[nodiscard]] Vector3 transformDirection(const Vector3 &d) const;
+
+	static constexpr Matrix4 translate(const Vector3& t) {
+		return {
+			1, 0, 0, t.x,
+			0, 1, 0, t.y,
+			0, 0, 1, t.z,
+			0, 0, 0, 1
+		};
+	}
+
+	static constexpr Matrix4 scale(const Vector3& s) {
+		return {
+			s.x, 0, 0, 0,
+			0, s.y, 0, 0,
+			0, 0, s.z, 0,
+			0, 0, 0, 1
+		};
+	}
+
 	static Matrix4 rotateX(float a);
 	static Matrix4 rotateY(float a);
 	static Matrix4 rotateZ(float a);
 
+	[[nodiscard]] Matrix4 transpose() const;
 	[[nodiscard]] Matrix4 invert() const;
 
 	[[nodiscard]] Vector3 extractEulerAngles() const;
@@ -34,8 +95,7 @@ public:
 	void toColumnMajor(float (&values)[16]) const;
 
 private:
-	float m11{}, m21{}, m31{}, m41{};
-	float m12{}, m22{}, m32{}, m42{};
-	float m13{}, m23{}, m33{}, m43{};
-	float m14{}, m24{}, m34{}, m44{};
+	alignas(16) float m[16]{};
+
+	constexpr float& at(const int row, const int col) { return m[col * 4 + row]; }
 };
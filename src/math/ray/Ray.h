@@ -3,6 +3,7 @@
 #include <algorithm>
 
 #include "math/Util.h"
+#include "math/bvh/MeshBVH.h"
 
 
 class Ray {
@@ -13,15 +14,19 @@ public:
 	Ray(const Vector3 origin, const Vector3 direction) : origin(origin), direction(direction) {}
 
 	[[nodiscard]] bool intersects(const Mesh& mesh) const;
+	[[nodiscard]] RayHit closestHit(const Mesh& mesh) const;
 	[[nodiscard]] bool intersects(const Triangle& t) const;
 	[[nodiscard]] static bool intersects(const Vector2 &vertexPos, const Vector2 &mousePos, float tolerance);
 };
 
 
 inline bool Ray::intersects(const Mesh& mesh) const {
-	return ranges::any_of(mesh.triangles, [this](const shared_ptr<Triangle>& triangle) {
-		return intersects(*triangle);
-	});
+	return static_cast<bool>(closestHit(mesh));
+}
+
+/** Closest triangle hit through the Mesh's BVH */
+inline RayHit Ray::closestHit(const Mesh& mesh) const {
+	return mesh.getBVH().intersect(*this);
 }
 
 inline bool Ray::intersects(const Triangle &t) const {
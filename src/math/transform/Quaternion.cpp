@@ -0,0 +1,96 @@
+#include "Quaternion.h"
+
+#include <algorithm>
+
+#include "math/matrix/Matrix4.h"
+
+
+Quaternion Quaternion::fromAxisAngle(const Vector3& axis, const float angle) {
+	const float s = sin(angle * 0.5f);
+	return {cos(angle * 0.5f), axis.x * s, axis.y * s, axis.z * s};
+}
+
+Quaternion Quaternion::fromEuler(const Vector3& angles) {
+	Quaternion q;
+	if (angles.x != 0.0f) q = q * fromAxisAngle(Vector3(1, 0, 0), angles.x);
+	if (angles.y != 0.0f) q = q * fromAxisAngle(Vector3(0, 1, 0), angles.y);
+	if (angles.z != 0.0f) q = q * fromAxisAngle(Vector3(0, 0, 1), angles.z);
+	return q;
+}
+
+/** Shepperd's method: derive the largest component from the diagonal, the others from the off-diagonal sums */
+Quaternion Quaternion::fromMatrix(const Matrix4& m) {
+	// Normalized columns, so scaled rotations work as well
+	float r[3][3];
+	for (int col = 0; col < 3; col++) {
+		const Vector3 c(m(0, col), m(1, col), m(2, col));
+		const float l = c.length() > 0 ? c.length() : 1.0f;
+		for (int row = 0; row < 3; row++) r[row][col] = m(row, col) / l;
+	}
+
+	Quaternion q;
+	if (const float trace = r[0][0] + r[1][1] + r[2][2]; trace > 0) {
+		const float s = sqrt(trace + 1.0f) * 2.0f;	// 4w
+		q = {0.25f * s, (r[2][1] - r[1][2]) / s, (r[0][2] - r[2][0]) / s, (r[1][0] - r[0][1]) / s};
+	} else if (r[0][0] > r[1][1] && r[0][0] > r[2][2]) {
+		const float s = sqrt(1.0f + r[0][0] - r[1][1] - r[2][2]) * 2.0f;	// 4x
+		q = {(r[2][1] - r[1][2]) / s, 0.25f * s, (r[0][1] + r[1][0]) / s, (r[0][2] + r[2][0]) / s};
+	} else if (r[1][1] > r[2][2]) {
+		const float s = sqrt(1.0f + r[1][1] - r[0][0] - r[2][2]) * 2.0f;	// 4y
+		q = {(r[0][2] - r[2][0]) / s, (r[0][1] + r[1][0]) / s, 0.25f * s, (r[1][2] + r[2][1]) / s};
+	} else {
+		const float s = sqrt(1.0f + r[2][2] - r[0][0] - r[1][1]) * 2.0f;	// 4z
+		q = {(r[1][0] - r[0][1]) / s, (r[0][2] + r[2][0]) / s, (r[1][2] + r[2][1]) / s, 0.25f * s};
+	}
+	return q.normalize();
+}
+
+Quaternion Quaternion::slerp(const Quaternion& a, const Quaternion& b, const float t) {
+	// q and -q are the same rotation, take the one on a's side of the hypersphere
+	float cosTheta = a.dot(b);
+	const Quaternion end = cosTheta < 0.0f ? Quaternion(-b.w, -b.x, -b.y, -b.z) : b;
+	cosTheta = abs(cosTheta);
+
+	float wa, wb;
+	if (cosTheta > SLERP_LINEAR_THRESHOLD) {
+		// Nearly parallel: sin(theta) is too small to divide by, and lerp is just as good
+		wa = 1.0f - t;
+		wb = t;
+	} else {
+		const float theta = acos(clamp(cosTheta, -1.0f, 1.0f));
+		const float sinTheta = sin(theta);
+		wa = sin((1.0f - t) * theta) / sinTheta;
+		wb = sin(t * theta) / sinTheta;
+	}
+
+	return Quaternion(
+		wa * a.w + wb * end.w,
+		wa * a.x + wb * end.x,
+		wa * a.y + wb * end.y,
+		wa * a.z + wb * end.z
+	).normalize();
+}
+
+
+Matrix4 Quaternion::toMatrix() const {
+	const float xx = x * x, yy = y * y, zz = z * z;
+	const float xy = x * y, xz = x * z, yz = y * z;
+	const float wx = w * x, wy = w * y, wz = w * z;
+
+	return Matrix4({
+		1 - 2 * (yy + zz),	   2 * (xy - wz),	  2 * (xz + wy), 0,
+			2 * (xy + wz), 1 - 2 * (xx + zz),	  2 * (yz - wx), 0,
+			2 * (xz - wy),	   2 * (yz + wx), 1 - 2 * (xx + yy), 0,
+					    0,				   0,				  0, 1
+	});
+}
+
+Vector3 Quaternion::toEulerAngles() const {
+	return toMatrix().extractEulerAngles();
+}
+
+string Quaternion::toString() const {
+	ostringstream out;
+	out << fixed << setprecision(3) << w << ", " << x << ", " << y << ", " << z;
+	return out.str();
+}
@@ -0,0 +1,86 @@
+#pragma once
+
+using namespace std;
+
+#include <cmath>
+#include <string>
+
+#include "math/vector/Vector3.h"
+
+class Matrix4;
+
+// Constants
+constexpr float SLERP_LINEAR_THRESHOLD = 0.9995f;	// Above this cosine, slerp() falls back to a normalized lerp
+
+
+/**
+ * Unit quaternion w + xi + yj + zk for rotations. Composing two is 16 multiplications instead of 64
+ * for Matrix4, and normalize() snaps the result back onto a rotation, so accumulating many small
+ * rotations doesn't drift into shear or scale.
+ */
+class Quaternion {
+public:
+	float w = 1.0f, x = 0.0f, y = 0.0f, z = 0.0f;
+
+	// Constructors
+	Quaternion() = default;		// Identity
+	Quaternion(const float w, const float x, const float y, const float z) : w(w), x(x), y(y), z(z) {}
+
+	/** Rotation by angle (radians) about a unit axis */
+	static Quaternion fromAxisAngle(const Vector3& axis, float angle);
+
+	/** Same rotation as rotateX(angles.x) * rotateY(angles.y) * rotateZ(angles.z), skipping zero angles */
+	static Quaternion fromEuler(const Vector3& angles);
+
+	/** Rotation part of a matrix without shear (the columns are normalized first) */
+	static Quaternion fromMatrix(const Matrix4& m);
+
+	/** Shortest-path interpolation at constant angular speed */
+	static Quaternion slerp(const Quaternion& a, const Quaternion& b, float t);
+
+	bool operator==(const Quaternion& other) const {
+		return w == other.w && x == other.x && y == other.y && z == other.z;
+	}
+
+	/** Composition: (a * b) rotates by b first, then by a */
+	Quaternion operator*(const Quaternion& other) const {
+		return {
+			w * other.w - x * other.x - y * other.y - z * other.z,
+			w * other.x + x * other.w + y * other.z - z * other.y,
+			w * other.y - x * other.z + y * other.w + z * other.x,
+			w * other.z + x * other.y - y * other.x + z * other.w
+		};
+	}
+
+	[[nodiscard]] float dot(const Quaternion& other) const {
+		return w * other.w + x * other.x + y * other.y + z * other.z;
+	}
+
+	[[nodiscard]] float length() const {
+		return sqrt(dot(*this));
+	}
+
+	[[nodiscard]] Quaternion normalize() const {
+		const float l = length();
+		return l > 0 ? Quaternion(w / l, x / l, y / l, z / l) : Quaternion();
+	}
+
+	/** Inverse rotation (for unit quaternions) */
+	[[nodiscard]] Quaternion conjugate() const {
+		return {w, -x, -y, -z};
+	}
+
+	/** v' = q v q*, expanded to two cross products */
+	[[nodiscard]] Vector3 rotate(const Vector3& v) const {
+		const Vector3 u(x, y, z);
+		const Vector3 t = u.cross(v) * 2.0f;
+		return v + t * w + u.cross(t);
+	}
+
+	[[nodiscard]] Matrix4 toMatrix() const;
+
+	/** In degrees, decomposed like Matrix4::extractEulerAngles() */
+	[[nodiscard]] Vector3 toEulerAngles() const;
+
+	[[nodiscard]] string toString() const;
+};
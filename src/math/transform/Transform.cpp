@@ -0,0 +1,39 @@
+#include "Transform.h"
+
+#include "math/matrix/Matrix4.h"
+
+
+Transform Transform::operator*(const Transform& child) const {
+	Transform result;
+	result.position = transformPoint(child.position);
+	result.rotation = rotation * child.rotation;
+	result.scale	= scale * child.scale;
+	return result;
+}
+
+Transform Transform::inverse() const {
+	Transform result;
+	result.rotation = rotation.conjugate();
+	result.scale	= Vector3(1.0f / scale.x, 1.0f / scale.y, 1.0f / scale.z);
+	result.position = result.scale * result.rotation.rotate(-position);
+	return result;
+}
+
+Matrix4 Transform::toMatrix() const {
+	// The rotation columns scaled by the scale components, then the translation column
+	const Matrix4 r = rotation.toMatrix();
+	return Matrix4({
+		r(0, 0) * scale.x, r(0, 1) * scale.y, r(0, 2) * scale.z, position.x,
+		r(1, 0) * scale.x, r(1, 1) * scale.y, r(1, 2) * scale.z, position.y,
+		r(2, 0) * scale.x, r(2, 1) * scale.y, r(2, 2) * scale.z, position.z,
+						0,				   0,				  0,		  1
+	});
+}
+
+Transform Transform::interpolate(const Transform& a, const Transform& b, const float t) {
+	Transform result;
+	result.position = a.position + (b.position - a.position) * t;
+	result.rotation = Quaternion::slerp(a.rotation, b.rotation, t);
+	result.scale	= a.scale + (b.scale - a.scale) * t;
+	return result;
+}
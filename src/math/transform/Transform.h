@@ -0,0 +1,44 @@
+#pragma once
+
+using namespace std;
+
+#include "Quaternion.h"
+#include "math/vector/Vector3.h"
+
+class Matrix4;
+
+
+/**
+ * Translation, rotation and scale of an Object, applied in that order from the right (T * R * S).
+ *
+ * Composition and inversion stay in TRS form; they're exact as long as the scale is uniform,
+ * otherwise the shear a Matrix4 product would produce is dropped.
+ */
+class Transform {
+public:
+	Vector3 position	= Vector3::ZERO;
+	Quaternion rotation;
+	Vector3 scale		= Vector3::ONE;
+
+	/** Parent * child: the child Transform expressed in the parent's space */
+	Transform operator*(const Transform& child) const;
+
+	[[nodiscard]] Transform inverse() const;
+
+	[[nodiscard]] Vector3 transformPoint(const Vector3& p) const {
+		return position + rotation.rotate(scale * p);
+	}
+
+	[[nodiscard]] Vector3 transformDirection(const Vector3& d) const {
+		return rotation.rotate(scale * d);
+	}
+
+	/** Re-normalize the rotation after many compositions */
+	void normalize() { rotation = rotation.normalize(); }
+
+	/** T * R * S, built directly from the quaternion without multiplying three matrices */
+	[[nodiscard]] Matrix4 toMatrix() const;
+
+	/** Linear in position and scale, spherical in rotation */
+	static Transform interpolate(const Transform& a, const Transform& b, float t);
+};
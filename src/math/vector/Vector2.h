@@ -11,11 +11,11 @@ public:
 	double x, y;
 
 	// Constructor
-	Vector2() : x(0.0), y(0.0) {}	// Default constructor
-	Vector2(const double x, const double y) : x(x), y(y) {}
+	constexpr Vector2() : x(0.0), y(0.0) {}	// Default constructor
+	constexpr Vector2(const double x, const double y) : x(x), y(y) {}
 
 	// Access by index
-	double operator[](const int index) const {
+	constexpr double operator[](const int index) const {
 		switch (index) {
 			case 0: return x;
 			case 1: return y;
@@ -24,31 +24,31 @@ public:
 	}
 
 	// Arithmetic operators
-	Vector2 operator+(const Vector2& other) const {
+	constexpr Vector2 operator+(const Vector2& other) const {
 		return {x + other.x, y + other.y};
 	}
 
-	Vector2 operator-(const Vector2& other) const {
+	constexpr Vector2 operator-(const Vector2& other) const {
 		return {x - other.x, y - other.y};
 	}
 
-	Vector2 operator*(const double scalar) const {
+	constexpr Vector2 operator*(const double scalar) const {
 		return {x * scalar, y * scalar};
 	}
 
-	Vector2 operator*(const Vector2& other) const {
+	constexpr Vector2 operator*(const Vector2& other) const {
 		return {x * other.x, y * other.y};
 	}
 
-	Vector2 operator/(const double scalar) const {
+	constexpr Vector2 operator/(const double scalar) const {
 		return {x / scalar, y / scalar};
 	}
 
-	Vector2 operator/(const Vector2& other) const {
+	constexpr Vector2 operator/(const Vector2& other) const {
 		return {x / other.x, y / other.y};
 	}
 
-	Vector2 operator-() const {
+	constexpr Vector2 operator-() const {
 		return {-x, -y};
 	}
 
@@ -65,7 +65,7 @@ public:
 		return sqrt((x - other.x) * (x - other.x) + (y - other.y) * (y - other.y));
 	}
 
-	[[nodiscard]] double dot(const Vector2& other) const {
+	[[nodiscard]] constexpr double dot(const Vector2& other) const {
 		return x * other.x + y * other.y;
 	}
 };
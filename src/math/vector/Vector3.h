@@ -12,21 +12,21 @@ public:
 	float x, y, z;
 
 	// Constructor
-	Vector3() = default;
-	Vector3(const float x, const float y, const float z) : x(x), y(y), z(z) {}
+	constexpr Vector3() = default;
+	constexpr Vector3(const float x, const float y, const float z) : x(x), y(y), z(z) {}
 
 	// Static constants
-	static const Vector3& ZERO;
-	static const Vector3& ONE;
-	static const Vector3& MINUS_ONE;
+	static const Vector3 ZERO;
+	static const Vector3 ONE;
+	static const Vector3 MINUS_ONE;
 
 	// Check equality
-	bool operator==(const Vector3& other) const {
+	constexpr bool operator==(const Vector3& other) const {
 		return x == other.x && y == other.y && z == other.z;
 	}
 
 	// Access by index
-	float operator[](const int index) const {
+	constexpr float operator[](const int index) const {
 		switch (index) {
 			case 0: return x;
 			case 1: return y;
@@ -36,31 +36,31 @@ public:
 	}
 
 	// Arithmetic operators
-	Vector3 operator+(const Vector3& other) const {
+	constexpr Vector3 operator+(const Vector3& other) const {
 		return {x + other.x, y + other.y, z + other.z};
 	}
 
-	Vector3 operator-(const Vector3& other) const {
+	constexpr Vector3 operator-(const Vector3& other) const {
 		return {x - other.x, y - other.y, z - other.z};
 	}
 
-	Vector3 operator*(const float scalar) const {
+	constexpr Vector3 operator*(const float scalar) const {
 		return {x * scalar, y * scalar, z * scalar};
 	}
 
-	Vector3 operator*(const Vector3& other) const {
+	constexpr Vector3 operator*(const Vector3& other) const {
 		return {x * other.x, y * other.y, z * other.z};
 	}
 
-	Vector3 operator/(const float scalar) const {
+	constexpr Vector3 operator/(const float scalar) const {
 		return {x / scalar, y / scalar, z / scalar};
 	}
 
-	Vector3 operator/(const Vector3& other) const {
+	constexpr Vector3 operator/(const Vector3& other) const {
 		return {x / other.x, y / other.y, z / other.z};
 	}
 
-	Vector3 operator-() const {
+	constexpr Vector3 operator-() const {
 		return {-x, -y, -z};
 	}
 
@@ -77,11 +77,11 @@ public:
 		return sqrt((x - other.x) * (x - other.x) + (y - other.y) * (y - other.y) + (z - other.z) * (z - other.z));
 	}
 
-	[[nodiscard]] float dot(const Vector3& other) const {
+	[[nodiscard]] constexpr float dot(const Vector3& other) const {
 		return x * other.x + y * other.y + z * other.z;
 	}
 
-	[[nodiscard]] Vector3 cross(const Vector3& other) const {
+	[[nodiscard]] constexpr Vector3 cross(const Vector3& other) const {
 		return {y * other.z - z * other.y, z * other.x - x * other.z, x * other.y - y * other.x};
 	}
 
@@ -92,9 +92,9 @@ public:
 	}
 };
 
-inline const Vector3& Vector3::ZERO		 = Vector3(0.0f, 0.0f, 0.0f);
-inline const Vector3& Vector3::ONE		 = Vector3(1.0f, 1.0f, 1.0f);
-inline const Vector3& Vector3::MINUS_ONE = Vector3(-1.0f, -1.0f, -1.0f);
+constexpr Vector3 Vector3::ZERO	   = Vector3(0.0f, 0.0f, 0.0f);
+constexpr Vector3 Vector3::ONE	   = Vector3(1.0f, 1.0f, 1.0f);
+constexpr Vector3 Vector3::MINUS_ONE = Vector3(-1.0f, -1.0f, -1.0f);
 
 template <>
 struct std::hash<Vector3> {
@@ -9,10 +9,10 @@ public:
 	float x, y, z, w;
 
 	// Constructor
-	Vector4(const float x, const float y, const float z, const float w) : x(x), y(y), z(z), w(w) {}
+	constexpr Vector4(const float x, const float y, const float z, const float w) : x(x), y(y), z(z), w(w) {}
 
 	// Access by index
-	float operator[](const int index) const {
+	constexpr float operator[](const int index) const {
 		switch (index) {
 			case 0: return x;
 			case 1: return y;
@@ -23,31 +23,31 @@ public:
 	}
 
 	// Arithmetic operators
-	Vector4 operator+(const Vector4& other) const {
+	constexpr Vector4 operator+(const Vector4& other) const {
 		return {x + other.x, y + other.y, z + other.z, w + other.w};
 	}
 
-	Vector4 operator-(const Vector4& other) const {
+	constexpr Vector4 operator-(const Vector4& other) const {
 		return {x - other.x, y - other.y, z - other.z, w - other.w};
 	}
 
-	Vector4 operator*(const float scalar) const {
+	constexpr Vector4 operator*(const float scalar) const {
 		return {x * scalar, y * scalar, z * scalar, w * scalar};
 	}
 
-	Vector4 operator*(const Vector4& other) const {
+	constexpr Vector4 operator*(const Vector4& other) const {
 		return {x * other.x, y * other.y, z * other.z, w * other.w};
 	}
 
-	Vector4 operator/(const float scalar) const {
+	constexpr Vector4 operator/(const float scalar) const {
 		return {x / scalar, y / scalar, z / scalar, w / scalar};
 	}
 
-	Vector4 operator/(const Vector4& other) const {
+	constexpr Vector4 operator/(const Vector4& other) const {
 		return {x / other.x, y / other.y, z / other.z, w / other.w};
 	}
 
-	Vector4 operator-() const {
+	constexpr Vector4 operator-() const {
 		return {-x, -y, -z, -w};
 	}
 
@@ -64,7 +64,7 @@ public:
 		return sqrt((x - other.x) * (x - other.x) + (y - other.y) * (y - other.y) + (z - other.z) * (z - other.z) + (w - other.w) * (w - other.w));
 	}
 
-	[[nodiscard]] float dot(const Vector4& other) const {
+	[[nodiscard]] constexpr float dot(const Vector4& other) const {
 		return x * other.x + y * other.y + z * other.z + w * other.w;
 	}
 };
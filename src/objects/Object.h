@@ -5,7 +5,7 @@ using namespace std;
 #include <utility>
 #include <string>
 
-#include "math/vector/Vector3.h"
+#include "math/transform/Transform.h"
 
 class Matrix4;
 class Mode;
@@ -15,10 +15,7 @@ class Object {
 public:
 	string name;
 
-	Vector3 position		= Vector3::ZERO;
-	Vector3 scale			= Vector3::ONE;
-	Vector3 rotation		= Vector3::ZERO;
-	Vector3 rotationEuler	= Vector3::ZERO;	// Euler angles for debug output
+	Transform transform;	// Origin, orientation and scale; Meshes keep their Vertices in world space
 
 	// Constructor & Destructor
 	explicit Object(string name) : name(move(name)), id(nextID++) {}
@@ -28,6 +25,9 @@ public:
 
 	bool operator==(const Object& other) const { return id == other.id; }	// Object == Object
 
+	/** Unique and dense (assigned in order of construction), so it can index arrays */
+	[[nodiscard]] int getID() const { return id; }
+
 private:
 	int id;
 	static int nextID;	// Static variable for automatic ID assignment
@@ -1,9 +1,13 @@
 #include "Mesh.h"
 
+#include <numeric>
 #include <vector>
 #include <ranges>
 
+#include "jobs/JobSystem.h"
 #include "math/Util.h"
+#include "math/geometry/SpatialHash.h"
+#include "math/matrix/BatchTransform.h"
 #include "math/matrix/Matrix4.h"
 
 
@@ -11,23 +15,67 @@
  * (Matrix operations, updating normals)
  */
 void Mesh::applyTransformation(const Mode& selectionMode, const Mode& transformMode, const Matrix4& transformation) {
+	const bool boundsValid = !localBoundsOutdated;
+	const auto previousRotation = transform.rotation;
+
 	// Update Object transformation
 	switch (transformMode.mode) {
-		case Mode::GRAB:   position = vector3(transformation * vector4(position, 1.0f)); break;
-		case Mode::SCALE:  scale	= vector3(transformation * vector4(scale, 1.0f));	 break;
-		case Mode::ROTATE: {
-			rotation = vector3(transformation * vector4(rotation, 0.0f));
-			rotationEuler = rotationEuler + transformation.extractEulerAngles();
-			break;
-		}
+		case Mode::GRAB:   transform.position = transformation.transformPoint(transform.position); break;
+		case Mode::SCALE:  transform.scale	  = transformation.transformPoint(transform.scale);	   break;
+		case Mode::ROTATE: transform.rotation = (Quaternion::fromMatrix(transformation) * transform.rotation).normalize(); break;
 		default: break;
 	}
 
-	for (const auto& v : vertices) {
-		v->position = vector3(transformation * vector4(v->position - position, 1.0f)) + position;
+	// Transform the Vertices relative to the (updated) origin, all in one batch
+	const auto& origin	= transform.position;
+	const auto relative = Matrix4::translate(origin) * transformation * Matrix4::translate(-origin);
+	PointBatch points;
+	points.gather(vertices);
+	transformPoints(relative, points, points);
+	points.scatter(vertices);
+
+	updateNormals();
+	markGeometryChanged();
+
+	// The Vertex offsets move with the rotation in the Transform, so only scaling changes the local bounds
+	if (boundsValid) {
+		switch (transformMode.mode) {
+			case Mode::GRAB:
+			case Mode::ROTATE: localBoundsOutdated = false; break;
+			case Mode::SCALE: {
+				localBounds = localBounds.transform(transform.rotation.conjugate().toMatrix() * transformation * previousRotation.toMatrix());
+				localBoundsOutdated = false;
+				break;
+			}
+			default: break;
+		}
+	}
+}
+
+/**
+ * Rotate about the origin. The Vertices are recomputed from their unrotated offsets to the origin,
+ * which are cached until anything else changes the geometry, so a rotate drag doesn't accumulate
+ * rounding errors from one event to the next.
+ */
+void Mesh::rotate(const Quaternion& delta) {
+	const auto& origin = transform.position;
+
+	if (restVersion != geometryVersion) {
+		restOffsets.gather(vertices);
+		transformPoints(transform.rotation.conjugate().toMatrix() * Matrix4::translate(-origin), restOffsets, restOffsets);
 	}
 
+	transform.rotation = (delta * transform.rotation).normalize();
+
+	PointBatch points;
+	transformPoints(Matrix4::translate(origin) * transform.rotation.toMatrix(), restOffsets, points);
+	points.scatter(vertices);
+
+	const bool boundsValid = !localBoundsOutdated;
 	updateNormals();
+	markGeometryChanged();
+	localBoundsOutdated = !boundsValid;	// Unchanged in the rotated frame
+	restVersion = geometryVersion;
 }
 
 void Mesh::initializeTriangles() {
@@ -38,25 +86,18 @@ void Mesh::initializeTriangles() {
 			vertices[faceIndices[i + 2]]
 		));
 	}
+	markGeometryChanged(true);
 }
 
-/** Build the vertex-to-edge adjacency map for the mesh */
+/** Build the vertex-to-edge adjacency map for the mesh (from the edge-to-face map, so build that first) */
 void Mesh::buildVertexToEdgeMap() {
 	vertexToEdgeMap.clear();
 	vertexToEdgeMap.reserve(vertices.size());	// Reserve space (this helps avoid reallocations)
 
-	// Use shared_ptr to store the vertices in the map
-	for (const auto& v : vertices) {
-		for (const auto& e: edgeToFaceMap | views::keys) {
-			if (e.v0 == v || e.v1 == v) {
-				// Store the shared pointer to the vertex in the map
-				if (!vertexToEdgeMap.contains(v)) {
-					vertexToEdgeMap[v] = vector {e};
-				} else {
-					vertexToEdgeMap[v].push_back(e);
-				}
-			}
-		}
+	// Every Edge belongs to both of its Vertices
+	for (const auto& e : edgeToFaceMap | views::keys) {
+		vertexToEdgeMap[e.v0].push_back(e);
+		vertexToEdgeMap[e.v1].push_back(e);
 	}
 }
 
@@ -71,6 +112,8 @@ void Mesh::buildEdgeToFaceMap() {
 		addEdgeToMap(Edge(t->v1, t->v2), t);
 		addEdgeToMap(Edge(t->v2, t->v0), t);
 	}
+	selectionOutdated = true;
+	topologyVersion++;
 }
 
 /** Helper function to add an edge to the map */
@@ -84,17 +127,249 @@ void Mesh::addEdgeToMap(const Edge& e, const shared_ptr<Triangle>& t) {
 	}
 }
 
+/** Add the Triangle to its Edges; Edges that are new to the Mesh are also added to their Vertices */
+void Mesh::linkTriangle(const shared_ptr<Triangle>& t) {
+	for (const auto& e : {Edge(t->v0, t->v1), Edge(t->v1, t->v2), Edge(t->v2, t->v0)}) {
+		if (!edgeToFaceMap.contains(e)) {
+			vertexToEdgeMap[e.v0].push_back(e);
+			vertexToEdgeMap[e.v1].push_back(e);
+		}
+		addEdgeToMap(e, t);
+	}
+}
+
+/** Remove the Triangle from its Edges; Edges without any Triangle left are removed entirely */
+void Mesh::unlinkTriangle(const shared_ptr<Triangle>& t) {
+	for (const auto& e : {Edge(t->v0, t->v1), Edge(t->v1, t->v2), Edge(t->v2, t->v0)}) {
+		const auto it = edgeToFaceMap.find(e);
+		if (it == edgeToFaceMap.end()) continue;
+
+		erase(it->second, t);
+		if (!it->second.empty()) continue;
+		edgeToFaceMap.erase(it);
+
+		for (const auto& v : {e.v0, e.v1}) {
+			if (const auto vt = vertexToEdgeMap.find(v); vt != vertexToEdgeMap.end()) {
+				erase(vt->second, e);
+				if (vt->second.empty()) vertexToEdgeMap.erase(vt);
+			}
+		}
+	}
+}
+
+/**
+ * Merge by distance through a SpatialHash with cells twice as large as the threshold, so every
+ * Vertex only has to be compared against the few Vertices in at most 8 neighboring cells.
+ * Afterward, only the Triangles that reference a removed Vertex are touched: they're unlinked from
+ * the adjacency maps, pointed at the kept Vertices, and relinked unless they collapsed.
+ * If most of the Mesh is affected (e.g. cleaning up a whole scan), rebuilding the maps is cheaper.
+ */
+size_t Mesh::mergeByDistance(const float threshold) {
+	vector<uint32_t> candidates;
+	vector<Vector3> positions;
+	getSelection().getVertices().forEachSet([&](const size_t i) {
+		candidates.emplace_back(static_cast<uint32_t>(i));
+		positions.emplace_back(vertices[i]->position);
+	});
+	if (candidates.size() < 2 || threshold <= 0.0f) return 0;
+
+	SpatialHash hash(threshold * 2.0f);
+	hash.build(positions);
+
+	// Greedily keep the first unvisited Vertex and merge its unvisited neighbors into it
+	constexpr int UNVISITED = -1, KEPT = -2;
+	vector<int> mergedInto(candidates.size(), UNVISITED);
+	size_t removed = 0;
+	for (size_t c = 0; c < candidates.size(); c++) {
+		if (mergedInto[c] != UNVISITED) continue;
+		mergedInto[c] = KEPT;
+
+		hash.forEachNear(positions[c], threshold, [&](const uint32_t k) {
+			if (mergedInto[k] != UNVISITED) return;
+			mergedInto[k] = static_cast<int>(candidates[c]);
+			removed++;
+		});
+	}
+	if (removed == 0) return 0;
+
+	// Removed Vertex -> kept Vertex, by pointer and by index
+	unordered_map<const Vertex*, shared_ptr<Vertex>> replacement;
+	replacement.reserve(removed);
+	vector<int> targetOf(vertices.size());
+	iota(targetOf.begin(), targetOf.end(), 0);
+	for (size_t c = 0; c < candidates.size(); c++) {
+		if (mergedInto[c] < 0) continue;
+		replacement.emplace(vertices[candidates[c]].get(), vertices[mergedInto[c]]);
+		targetOf[candidates[c]] = mergedInto[c];
+	}
+
+	const auto replace = [&replacement](shared_ptr<Vertex>& v) {
+		if (const auto it = replacement.find(v.get()); it != replacement.end()) {
+			v = it->second;
+			return true;
+		}
+		return false;
+	};
+
+	// Only Triangles that reference a removed Vertex change
+	vector<uint32_t> affected;
+	for (size_t i = 0; i < triangles.size(); i++) {
+		const auto& t = triangles[i];
+		if (replacement.contains(t->v0.get()) || replacement.contains(t->v1.get()) || replacement.contains(t->v2.get())) {
+			affected.emplace_back(static_cast<uint32_t>(i));
+		}
+	}
+
+	// Patching the adjacency maps Triangle by Triangle only pays off for local merges
+	const bool incremental = affected.size() * MERGE_REBUILD_FRACTION < triangles.size();
+
+	vector<bool> keepTriangle(triangles.size(), true);
+	for (const uint32_t i : affected) {
+		const auto& t = triangles[i];
+		if (incremental) unlinkTriangle(t);
+		replace(t->v0);
+		replace(t->v1);
+		replace(t->v2);
+
+		if (t->v0 == t->v1 || t->v1 == t->v2 || t->v2 == t->v0) {
+			keepTriangle[i] = false;	// Collapsed
+			continue;
+		}
+
+		if (incremental) linkTriangle(t);
+		t->normal	= t->faceNormal();
+		t->centroid = t->center();
+	}
+
+	// Compact the Vertices, then the Triangles and their indices (if they still match the Triangles one to one)
+	const bool syncIndices = faceIndices.size() == triangles.size() * 3;
+	vector<int> newIndex(vertices.size(), -1);
+	size_t kept = 0;
+	for (size_t i = 0; i < vertices.size(); i++) {
+		if (replacement.contains(vertices[i].get())) continue;
+		newIndex[i] = static_cast<int>(kept);
+		vertices[kept++] = vertices[i];
+	}
+	vertices.resize(kept);
+	selection.remap(newIndex, kept);
+
+	size_t keptTriangles = 0;
+	for (size_t i = 0; i < triangles.size(); i++) {
+		if (!keepTriangle[i]) continue;
+		if (syncIndices) {
+			for (int k = 0; k < 3; k++) {
+				faceIndices[keptTriangles * 3 + k] = newIndex[targetOf[faceIndices[i * 3 + k]]];
+			}
+		}
+		triangles[keptTriangles++] = triangles[i];
+	}
+	triangles.resize(keptTriangles);
+	if (syncIndices) faceIndices.resize(keptTriangles * 3);
+
+	if (!incremental) {
+		buildEdgeToFaceMap();
+		buildVertexToEdgeMap();
+	}
+
+	markGeometryChanged(true);
+	return removed;
+}
+
 void Mesh::updateNormals() const {
 	// Update vertex normals
-	for (const auto& v : vertices) {
-		v->normal = (v->position - position).normalize();
-	}
+	JobSystem::parallelFor(vertices.size(), MESH_PARALLEL_THRESHOLD, [this](const size_t begin, const size_t end) {
+		for (size_t i = begin; i < end; i++) {
+			vertices[i]->normal = (vertices[i]->position - transform.position).normalize();
+		}
+	});
 
 	// Update face normals
+	JobSystem::parallelFor(triangles.size(), MESH_PARALLEL_THRESHOLD, [this](const size_t begin, const size_t end) {
+		for (size_t i = begin; i < end; i++) {
+			const auto& t = triangles[i];
+			t->normal = t->faceNormal();
+			t->centroid = t->center();
+		}
+	});
+}
+
+const MeshBVH& Mesh::getBVH() const {
+	if (!bvhBuilt) {
+		bvh.build(*this);
+		bvhBuilt = true;
+	} else if (bvhOutdated && !bvh.refit(*this)) {
+		bvh.build(*this);	// Refitting degraded the tree too much (e.g. after large rotations)
+	}
+	bvhOutdated = false;
+	return bvh;
+}
+
+void Mesh::markGeometryChanged(const bool topology) const {
+	if (topology) {
+		bvhBuilt		  = false;
+		selectionOutdated = true;
+		topologyVersion++;
+	}
+	bvhOutdated			= true;
+	localBoundsOutdated = true;
+	geometryVersion++;
+}
+
+const AABB& Mesh::getLocalBounds() const {
+	if (localBoundsOutdated) {
+		PointBatch offsets;
+		offsets.gather(vertices);
+		transformPoints(transform.rotation.conjugate().toMatrix() * Matrix4::translate(-transform.position), offsets, offsets);
+
+		localBounds = AABB();
+		for (size_t i = 0; i < offsets.size(); i++) {
+			localBounds.expand(Vector3(offsets.x[i], offsets.y[i], offsets.z[i]));
+		}
+		localBoundsOutdated = false;
+	}
+	return localBounds;
+}
+
+OBB Mesh::getOrientedBounds() const {
+	return {getLocalBounds(), transform.position, transform.rotation};
+}
+
+AABB Mesh::getWorldBounds() const {
+	return getOrientedBounds().toAABB();
+}
+
+MeshSelection& Mesh::getSelection() {
+	if (selectionOutdated) updateSelectionTopology();
+	return selection;
+}
+
+const MeshSelection& Mesh::getSelection() const {
+	if (selectionOutdated) updateSelectionTopology();
+	return selection;
+}
+
+/** Translate the Vertex pointers of the Triangles and Edges into indices for the selection */
+void Mesh::updateSelectionTopology() const {
+	unordered_map<const Vertex*, uint32_t> indexOf;
+	indexOf.reserve(vertices.size());
+	for (size_t i = 0; i < vertices.size(); i++) {
+		indexOf.emplace(vertices[i].get(), static_cast<uint32_t>(i));
+	}
+
+	vector<array<uint32_t, 3>> triangleIndices;
+	triangleIndices.reserve(triangles.size());
 	for (const auto& t : triangles) {
-		t->normal = t->faceNormal();
-		t->centroid = t->center();
+		triangleIndices.push_back({indexOf.at(t->v0.get()), indexOf.at(t->v1.get()), indexOf.at(t->v2.get())});
 	}
+
+	vector<array<uint32_t, 2>> edgeIndices;
+	edgeIndices.reserve(edgeToFaceMap.size());
+	for (const auto& e : edgeToFaceMap | views::keys) {
+		edgeIndices.push_back({indexOf.at(e.v0.get()), indexOf.at(e.v1.get())});
+	}
+
+	selection.setTopology(vertices.size(), std::move(triangleIndices), std::move(edgeIndices));
+	selectionOutdated = false;
 }
 
 void Mesh::setShadingMode(const ShadingMode shadingMode) {
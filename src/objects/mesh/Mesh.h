@@ -4,7 +4,11 @@
 #include <memory>
 #include <vector>
 
+#include "MeshSelection.h"
 #include "objects/Object.h"
+#include "math/bounds/OBB.h"
+#include "math/bvh/MeshBVH.h"
+#include "math/matrix/BatchTransform.h"
 #include "math/geometry/Edge.h"
 #include "math/geometry/Triangle.h"
 
@@ -13,6 +17,15 @@
 
 class Texture;
 
+struct MeshTopologySnapshot;
+struct MeshGeometrySnapshot;
+struct MeshSelectionSnapshot;
+
+// Constants
+constexpr size_t MERGE_REBUILD_FRACTION	= 4;		// Rebuild the adjacency maps if more than 1 / n of the Triangles change in a merge
+constexpr size_t MESH_PARALLEL_THRESHOLD	= 1 << 14;	// Vertices or Triangles before per-element updates are split across threads
+
+
 enum class ShadingMode {
 	FLAT,
 	SMOOTH
@@ -36,10 +49,45 @@ public:
 	void buildVertexToEdgeMap();
 
 	void applyTransformation(const Mode &selectionMode, const Mode &transformMode, const Matrix4 &transformation) override;
+	void rotate(const Quaternion &delta);
 
 	void initializeTriangles();
 	void updateNormals() const;
 
+	/**
+	 * Merge every selected Vertex into the first selected Vertex within threshold of it.
+	 * Triangles that collapse are removed. Returns the number of removed Vertices.
+	 */
+	size_t mergeByDistance(float threshold);
+
+	/** Triangle BVH for ray queries; built on first use and refit after geometry changes */
+	[[nodiscard]] const MeshBVH& getBVH() const;
+
+	/**
+	 * Bounds of the Vertex offsets to the origin, in the frame rotated by transform.rotation.
+	 * Object Mode transformations keep them valid by transforming the box instead of recomputing it.
+	 */
+	[[nodiscard]] const AABB& getLocalBounds() const;
+
+	/** The local bounds placed in the world by the Transform */
+	[[nodiscard]] OBB getOrientedBounds() const;
+
+	/** Box around the oriented bounds, the cheap first rejection test for culling and picking */
+	[[nodiscard]] AABB getWorldBounds() const;
+
+	/** Call after moving vertices, or with topology = true after changing the triangle list */
+	void markGeometryChanged(bool topology = false) const;
+
+	/** Incremented on every geometry change, so caches built from the vertices can tell when they're stale */
+	[[nodiscard]] uint64_t getGeometryVersion() const { return geometryVersion; }
+
+	/** Incremented whenever the triangle list or the Edges change */
+	[[nodiscard]] uint64_t getTopologyVersion() const { return topologyVersion; }
+
+	/** Selected Vertices (and the Edges and Triangles derived from them), indexed like vertices and triangles */
+	[[nodiscard]] MeshSelection& getSelection();
+	[[nodiscard]] const MeshSelection& getSelection() const;
+
 	void setShadingMode(ShadingMode shadingMode);
 	void setMaterial(const Color &diffuse, const Color &specular, const Color &emission, const Color &ambient, float shininess);
 
@@ -51,17 +99,47 @@ protected:
 	float shininess = 30.0f;
 
 private:
-	friend class MeshRenderer;
+	friend struct MeshSnapshot;
 
 	// adjacency information
 	unordered_map<Edge, vector<shared_ptr<Triangle>>> edgeToFaceMap;
 	unordered_map<shared_ptr<Vertex>, vector<Edge>> vertexToEdgeMap;
 
+	// Ray query acceleration (updated lazily by getBVH())
+	mutable MeshBVH bvh;
+	mutable bool bvhBuilt	 = false;
+	mutable bool bvhOutdated = false;
+	mutable uint64_t geometryVersion = 0;
+	mutable uint64_t topologyVersion = 0;
+
+	// Updated lazily by getLocalBounds() after edits other than Object Mode transformations
+	mutable AABB localBounds;
+	mutable bool localBoundsOutdated = true;
+
+	// Vertex offsets to the origin before rotation, valid while geometryVersion == restVersion (see rotate())
+	PointBatch restOffsets;
+	uint64_t restVersion = UINT64_MAX;
+
+	// Vertex selection (index lists updated lazily after topology changes)
+	mutable MeshSelection selection;
+	mutable bool selectionOutdated = true;
+
+	// Last render snapshots, reused while their versions are current (see MeshSnapshot::capture())
+	mutable shared_ptr<const MeshTopologySnapshot> topologySnapshot;
+	mutable shared_ptr<const MeshGeometrySnapshot> geometrySnapshot;
+	mutable shared_ptr<const MeshSelectionSnapshot> selectionSnapshot;
+
 	virtual void initializeVertices()    = 0;
 	virtual void initializeFaceIndices() = 0;
 
 	void addEdgeToMap(const Edge &e, const shared_ptr<Triangle> &t);
 
+	// Incremental adjacency updates for a single Triangle
+	void linkTriangle(const shared_ptr<Triangle> &t);
+	void unlinkTriangle(const shared_ptr<Triangle> &t);
+
+	void updateSelectionTopology() const;
+
 	void setColor(const Color &color);
 
 	void setPosition(const Vector3& translation);
@@ -0,0 +1,125 @@
+#include "MeshSelection.h"
+
+#include <algorithm>
+
+
+void MeshSelection::setTopology(const size_t vertexCount, vector<array<uint32_t, 3>>&& triangles, vector<array<uint32_t, 2>>&& edges) {
+	this->triangles = std::move(triangles);
+	this->edges		= std::move(edges);
+	vertexBits.resize(vertexCount);
+	changed();
+}
+
+void MeshSelection::remap(const vector<int>& newIndex, const size_t vertexCount) {
+	BitSet remapped(vertexCount);
+	vertexBits.forEachSet([&](const size_t i) {
+		if (newIndex[i] >= 0) remapped.set(newIndex[i]);
+	});
+	vertexBits = std::move(remapped);
+	changed();
+}
+
+void MeshSelection::select(const size_t vertex, const bool selected) {
+	vertexBits.set(vertex, selected);
+	changed();
+}
+
+void MeshSelection::toggle(const size_t vertex) {
+	vertexBits.flip(vertex);
+	changed();
+}
+
+
+void MeshSelection::selectAll() {
+	vertexBits.setAll();
+	changed();
+}
+
+void MeshSelection::deselectAll() {
+	vertexBits.resetAll();
+	changed();
+}
+
+void MeshSelection::invert() {
+	vertexBits.flipAll();
+	changed();
+}
+
+void MeshSelection::grow() {
+	if (vertexBits.none()) return;
+
+	BitSet grown = vertexBits;
+	for (const auto& [a, b] : edges) {
+		if (vertexBits.test(a) != vertexBits.test(b)) {
+			grown.set(a);
+			grown.set(b);
+		}
+	}
+	vertexBits = std::move(grown);
+	changed();
+}
+
+void MeshSelection::shrink() {
+	if (vertexBits.none()) return;
+
+	BitSet shrunk = vertexBits;
+	for (const auto& [a, b] : edges) {
+		if (vertexBits.test(a) != vertexBits.test(b)) {
+			shrunk.reset(a);
+			shrunk.reset(b);
+		}
+	}
+	vertexBits = std::move(shrunk);
+	changed();
+}
+
+
+const BitSet& MeshSelection::getEdges() const {
+	if (derivedOutdated) derive();
+	return edgeBits;
+}
+
+const BitSet& MeshSelection::getFaces() const {
+	if (derivedOutdated) derive();
+	return faceBits;
+}
+
+void MeshSelection::changed() {
+	derivedOutdated = true;
+	version++;
+}
+
+/** Assemble the Edge and Triangle bits a word at a time, instead of setting them one by one */
+void MeshSelection::derive() const {
+	edgeBits.assign(edges.size(), false);
+	faceBits.assign(triangles.size(), false);
+
+	if (vertexBits.all()) {
+		edgeBits.setAll();
+		faceBits.setAll();
+	} else if (vertexBits.any()) {
+		uint64_t* edgeWords = edgeBits.data();
+		for (size_t w = 0; w < edgeBits.wordCount(); w++) {
+			uint64_t word = 0;
+			const size_t end = min(edges.size(), (w + 1) * 64);
+			for (size_t i = w * 64; i < end; i++) {
+				const auto& [a, b] = edges[i];
+				word |= static_cast<uint64_t>(vertexBits.test(a) & vertexBits.test(b)) << (i & 63);
+			}
+			edgeWords[w] = word;
+		}
+
+		uint64_t* faceWords = faceBits.data();
+		for (size_t w = 0; w < faceBits.wordCount(); w++) {
+			uint64_t word = 0;
+			const size_t end = min(triangles.size(), (w + 1) * 64);
+			for (size_t i = w * 64; i < end; i++) {
+				const auto& [a, b, c] = triangles[i];
+				word |= static_cast<uint64_t>(vertexBits.test(a) & vertexBits.test(b) & vertexBits.test(c)) << (i & 63);
+			}
+			faceWords[w] = word;
+		}
+	}
+
+	derivedOutdated = false;
+}
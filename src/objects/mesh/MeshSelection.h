@@ -0,0 +1,62 @@
+#pragma once
+
+using namespace std;
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+#include "math/BitSet.h"
+
+
+/**
+ * Selection state of the Vertices of a Mesh, one bit per Vertex index.
+ *
+ * Edges and Triangles count as selected if all of their Vertices are. Their bits are derived lazily,
+ * in one sweep over the index lists, the first time they're needed after the Vertex bits changed.
+ * The index lists are handed over by the Mesh after every topology change (see Mesh::getSelection()).
+ */
+class MeshSelection {
+public:
+	/** Vertex indices of every Triangle (in Mesh order) and every unique Edge; resizes the Vertex bits */
+	void setTopology(size_t vertexCount, vector<array<uint32_t, 3>> &&triangles, vector<array<uint32_t, 2>> &&edges);
+
+	/** Move the bit of every kept Vertex i to newIndex[i] (negative for removed Vertices) */
+	void remap(const vector<int> &newIndex, size_t vertexCount);
+
+	[[nodiscard]] bool isSelected(const size_t vertex) const { return vertexBits.test(vertex); }
+	void select(size_t vertex, bool selected = true);
+	void toggle(size_t vertex);
+
+	// Bulk operations
+	void selectAll();
+	void deselectAll();
+	void invert();
+	void grow();	// Add every Vertex that shares an Edge with a selected one
+	void shrink();	// Remove every selected Vertex that shares an Edge with an unselected one
+
+	[[nodiscard]] size_t count() const { return vertexBits.count(); }
+	[[nodiscard]] bool isEmpty() const { return vertexBits.none(); }
+
+	[[nodiscard]] const BitSet& getVertices() const { return vertexBits; }
+	[[nodiscard]] const BitSet& getEdges() const;
+	[[nodiscard]] const BitSet& getFaces() const;
+	[[nodiscard]] const vector<array<uint32_t, 2>>& getEdgeList() const { return edges; }
+
+	/** Incremented on every change, so caches of the selection can tell when they're stale */
+	[[nodiscard]] uint64_t getVersion() const { return version; }
+
+private:
+	BitSet vertexBits;
+	mutable BitSet edgeBits;
+	mutable BitSet faceBits;
+	mutable bool derivedOutdated = true;
+
+	vector<array<uint32_t, 3>> triangles;
+	vector<array<uint32_t, 2>> edges;
+
+	uint64_t version = 0;
+
+	void changed();
+	void derive() const;
+};
@@ -0,0 +1,84 @@
+#include "Primitives.h"
+
+#include <cmath>
+#include <mutex>
+#include <unordered_map>
+
+#include "math/Util.h"
+
+
+static SphereTable buildSphereTable(const int segments, const int rings) {
+	SphereTable table;
+	const size_t vertexCount = 2 + static_cast<size_t>(rings - 1) * (segments + 1);
+	table.positions.reserve(vertexCount);
+	table.texCoords.reserve(vertexCount);
+
+	// Top pole (north pole)
+	table.positions.emplace_back(0.0f, 0.0f, 1.0f);
+	table.texCoords.emplace_back(0.5f, 1.0f);
+
+	// Longitudes are the same for every ring
+	vector<float> sinPhi(segments + 1), cosPhi(segments + 1);
+	for (int seg = 0; seg < segments + 1; ++seg) {
+		const auto phi = seg == segments ? 0 : static_cast<float>(2 * PI * seg / segments);
+		sinPhi[seg] = sin(phi);
+		cosPhi[seg] = cos(phi);
+	}
+
+	// Latitude rings
+	for (int ring = 1; ring < rings; ++ring) {
+		const auto theta = static_cast<float>(PI * ring / rings);
+		const float sinTheta = sin(theta);
+		const float cosTheta = cos(theta);
+		const float v = 1.0f - static_cast<float>(ring) / static_cast<float>(rings);	// Inverted to fix upside-down texture
+
+		for (int seg = 0; seg < segments + 1; ++seg) {
+			table.positions.emplace_back(sinTheta * cosPhi[seg], sinTheta * sinPhi[seg], cosTheta);
+			table.texCoords.emplace_back(static_cast<float>(seg) / static_cast<float>(segments), v);
+		}
+	}
+
+	// Bottom pole (south pole)
+	table.positions.emplace_back(0.0f, 0.0f, -1.0f);
+	table.texCoords.emplace_back(0.5f, 0.0f);
+
+	auto& indices = table.indices;
+	indices.reserve(static_cast<size_t>(rings) * (segments + 1) * 6);
+
+	// Top pole faces
+	for (int seg = 0; seg < segments + 1; ++seg) {
+		const int nextSeg = (seg + 1) % (segments + 1);
+		indices.insert(indices.end(), {1 + seg, 1 + nextSeg, 0});
+	}
+
+	// Middle faces, two Triangles per quad
+	for (int ring = 0; ring < rings - 2; ++ring) {
+		for (int seg = 0; seg < segments + 1; ++seg) {
+			const int nextSeg	= (seg + 1) % (segments + 1);
+			const int current	= 1 + ring * (segments + 1) + seg;
+			const int next		= 1 + ring * (segments + 1) + nextSeg;
+			const int below		= 1 + (ring + 1) * (segments + 1) + seg;
+			const int belowNext = 1 + (ring + 1) * (segments + 1) + nextSeg;
+			indices.insert(indices.end(), {current, below, next, next, below, belowNext});
+		}
+	}
+
+	// Bottom pole faces
+	const int bottomPole = static_cast<int>(table.positions.size()) - 1;
+	for (int seg = 0; seg < segments + 1; ++seg) {
+		const int nextSeg = (seg + 1) % (segments + 1);
+		indices.insert(indices.end(), {bottomPole - (segments + 1) + nextSeg, bottomPole - (segments + 1) + seg, bottomPole});
+	}
+
+	return table;
+}
+
+const SphereTable& sphereTable(const int segments, const int rings) {
+	static mutex tablesMutex;
+	static unordered_map<uint64_t, SphereTable> tables;	// References to the elements stay valid on rehash
+
+	const uint64_t key = static_cast<uint64_t>(static_cast<uint32_t>(segments)) << 32 | static_cast<uint32_t>(rings);
+	lock_guard lock(tablesMutex);
+	if (const auto it = tables.find(key); it != tables.end()) return it->second;
+	return tables.emplace(key, buildSphereTable(segments, rings)).first->second;
+}
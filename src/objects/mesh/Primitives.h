@@ -0,0 +1,106 @@
+#pragma once
+
+using namespace std;
+
+#include <array>
+#include <vector>
+
+#include "math/vector/Vector2.h"
+#include "math/vector/Vector3.h"
+
+
+/** Vertex of a primitive table; a literal type, so the tables of the fixed primitives are built at compile time */
+struct PrimitiveVertex {
+	Vector3 position;
+	Vector3 normal;
+	Vector2 texCoords;
+};
+
+
+/** Cube with side length 1 around the origin */
+constexpr array<PrimitiveVertex, 8> CUBE_VERTICES = {{
+	// Front face
+	{{-0.5f, -0.5f,  0.5f}, {}, {0, 0}},	// Bottom-left
+	{{ 0.5f, -0.5f,  0.5f}, {}, {1, 0}},	// Bottom-right
+	{{ 0.5f,  0.5f,  0.5f}, {}, {1, 1}},	// Top-right
+	{{-0.5f,  0.5f,  0.5f}, {}, {0, 1}},	// Top-left
+
+	// Back face
+	{{-0.5f, -0.5f, -0.5f}, {}, {0, 0}},	// Bottom-left
+	{{ 0.5f, -0.5f, -0.5f}, {}, {1, 0}},	// Bottom-right
+	{{ 0.5f,  0.5f, -0.5f}, {}, {1, 1}},	// Top-right
+	{{-0.5f,  0.5f, -0.5f}, {}, {0, 1}}		// Top-left
+}};
+
+constexpr array<int, 36> CUBE_INDICES = {
+	0, 1, 2,  2, 3, 0,	// Front face
+	1, 5, 6,  6, 2, 1,	// Right face
+	5, 4, 7,  7, 6, 5,	// Back face
+	4, 0, 3,  3, 7, 4,	// Left face
+	3, 2, 6,  6, 7, 3,	// Top face
+	4, 5, 1,  1, 0, 4	// Bottom face
+};
+
+
+/** Inward-facing cube with side length 2, with separate Vertices per face to map the cross-shaped cube map texture */
+constexpr array<PrimitiveVertex, 24> SKYBOX_VERTICES = {{
+	// +y
+	{{ 1,  1, -1}, {0, -1, 0}, {2 / 3.f, 1 / 2.f}},
+	{{ 1,  1,  1}, {0, -1, 0}, {2 / 3.f, 2 / 2.f}},
+	{{-1,  1,  1}, {0, -1, 0}, {1 / 3.f, 2 / 2.f}},
+	{{-1,  1, -1}, {0, -1, 0}, {1 / 3.f, 1 / 2.f}},
+
+	// +z
+	{{ 1, -1,  1}, {0, 0, -1}, {2 / 3.f, 1 / 2.f}},
+	{{-1, -1,  1}, {0, 0, -1}, {3 / 3.f, 1 / 2.f}},
+	{{-1,  1,  1}, {0, 0, -1}, {3 / 3.f, 2 / 2.f}},
+	{{ 1,  1,  1}, {0, 0, -1}, {2 / 3.f, 2 / 2.f}},
+
+	// -x
+	{{-1, -1,  1}, {1, 0, 0}, {0 / 3.f, 0 / 2.f}},
+	{{-1, -1, -1}, {1, 0, 0}, {1 / 3.f, 0 / 2.f}},
+	{{-1,  1, -1}, {1, 0, 0}, {1 / 3.f, 1 / 2.f}},
+	{{-1,  1,  1}, {1, 0, 0}, {0 / 3.f, 1 / 2.f}},
+
+	// -y
+	{{-1, -1, -1}, {0, 1, 0}, {1 / 3.f, 1 / 2.f}},
+	{{-1, -1,  1}, {0, 1, 0}, {1 / 3.f, 0 / 2.f}},
+	{{ 1, -1,  1}, {0, 1, 0}, {2 / 3.f, 0 / 2.f}},
+	{{ 1, -1, -1}, {0, 1, 0}, {2 / 3.f, 1 / 2.f}},
+
+	// +x
+	{{ 1, -1, -1}, {-1, 0, 0}, {0 / 3.f, 1 / 2.f}},
+	{{ 1, -1,  1}, {-1, 0, 0}, {1 / 3.f, 1 / 2.f}},
+	{{ 1,  1,  1}, {-1, 0, 0}, {1 / 3.f, 2 / 2.f}},
+	{{ 1,  1, -1}, {-1, 0, 0}, {0 / 3.f, 2 / 2.f}},
+
+	// -z
+	{{-1, -1, -1}, {0, 0, 1}, {2 / 3.f, 0 / 2.f}},
+	{{ 1, -1, -1}, {0, 0, 1}, {3 / 3.f, 0 / 2.f}},
+	{{ 1,  1, -1}, {0, 0, 1}, {3 / 3.f, 1 / 2.f}},
+	{{-1,  1, -1}, {0, 0, 1}, {2 / 3.f, 1 / 2.f}}
+}};
+
+/** Two Triangles per face, 4 Vertices apart */
+constexpr array<int, 36> SKYBOX_INDICES = [] {
+	array<int, 36> indices{};
+	for (int face = 0; face < 6; face++) {
+		constexpr int quad[6] = {0, 1, 2, 0, 2, 3};
+		for (int k = 0; k < 6; k++) indices[face * 6 + k] = face * 4 + quad[k];
+	}
+	return indices;
+}();
+
+
+/**
+ * Unit sphere with the Vertex layout of Sphere: poles on the z axis, rings in between
+ * with segments + 1 Vertices each (the last one duplicating the first for the texture seam).
+ */
+struct SphereTable {
+	vector<Vector3> positions;
+	vector<Vector2> texCoords;
+	vector<int> indices;
+};
+
+/** Built on first use for every (segments, rings) and cached, so the trigonometry runs once per resolution */
+[[nodiscard]] const SphereTable& sphereTable(int segments, int rings);
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "objects/mesh/Mesh.h"
+#include "objects/mesh/Primitives.h"
 #include "math/matrix/Matrix4.h"
 
 class Cube final : public Mesh {
@@ -13,8 +14,8 @@ public:
         initializeFaceIndices();
 
         initializeTriangles();
-        buildVertexToEdgeMap();
         buildEdgeToFaceMap();
+        buildVertexToEdgeMap();
         updateNormals();
 
         Mesh::applyTransformation(OBJECT, GRAB, Matrix4::translate(position));
@@ -25,35 +26,15 @@ public:
 private:
     float s;    // side length
 
-    /** Initialize the Cube's vertices based on side length and position */
+    /** Initialize the Cube's vertices from the unit cube table, scaled to the side length */
     void initializeVertices() override {
-        // Front face
-        vertices.emplace_back(make_shared<Vertex>(-s/2, -s/2,  s/2, Vector2(0, 0)));  // Bottom-left
-        vertices.emplace_back(make_shared<Vertex>( s/2, -s/2,  s/2, Vector2(1, 0)));  // Bottom-right
-        vertices.emplace_back(make_shared<Vertex>( s/2,  s/2,  s/2, Vector2(1, 1)));  // Top-right
-        vertices.emplace_back(make_shared<Vertex>(-s/2,  s/2,  s/2, Vector2(0, 1)));  // Top-left
-
-        // Back face
-        vertices.emplace_back(make_shared<Vertex>(-s/2, -s/2, -s/2, Vector2(0, 0)));  // Bottom-left
-        vertices.emplace_back(make_shared<Vertex>( s/2, -s/2, -s/2, Vector2(1, 0)));  // Bottom-right
-        vertices.emplace_back(make_shared<Vertex>( s/2,  s/2, -s/2, Vector2(1, 1)));  // Top-right
-        vertices.emplace_back(make_shared<Vertex>(-s/2,  s/2, -s/2, Vector2(0, 1)));  // Top-left
+        vertices.reserve(CUBE_VERTICES.size());
+        for (const auto& v : CUBE_VERTICES) {
+            vertices.emplace_back(make_shared<Vertex>(v.position * s, v.texCoords));
+        }
     }
 
     void initializeFaceIndices() override {
-        faceIndices = {
-            // Front face
-            0, 1, 2,  2, 3, 0,
-            // Right face
-            1, 5, 6,  6, 2, 1,
-            // Back face
-            5, 4, 7,  7, 6, 5,
-            // Left face
-            4, 0, 3,  3, 7, 4,
-            // Top face
-            3, 2, 6,  6, 7, 3,
-            // Bottom face
-            4, 5, 1,  1, 0, 4
-        };
+        faceIndices.assign(CUBE_INDICES.begin(), CUBE_INDICES.end());
     }
 };
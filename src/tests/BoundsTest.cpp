@@ -0,0 +1,220 @@
+using namespace std;
+
+#include "Test.h"
+
+#include <array>
+#include <cmath>
+#include <random>
+#include <string>
+
+#include "math/Util.h"
+#include "math/bounds/AABB.h"
+#include "math/bounds/BoundingSphere.h"
+#include "math/bounds/Frustum.h"
+#include "math/bounds/OBB.h"
+#include "math/transform/Quaternion.h"
+
+/**
+ * Checks the BoundingSphere, OBB and Frustum tests on hand-placed cases: separated, exactly touching
+ * (which counts as overlapping) and contained. Touching cases use axis-aligned boxes, so they are exact in floats.
+ */
+
+// Constants
+constexpr int TEST_SPHERE_POINTS = 1000;	// Random points fed to BoundingSphere::expand()
+
+
+static string name(const Containment containment) {
+	switch (containment) {
+		case Containment::OUTSIDE:	  return "OUTSIDE";
+		case Containment::INTERSECTS: return "INTERSECTS";
+		case Containment::INSIDE:	  return "INSIDE";
+	}
+	return "?";
+}
+
+static void checkContainment(const Containment actual, const Containment expected, const string& message) {
+	check(actual == expected, message + " is " + name(actual) + ", expected " + name(expected));
+}
+
+
+class BoundsTest {
+public:
+	void run() {
+		sphereFromPoints();
+		sphereOverlaps();
+		sphereIntersect();
+		obbOverlaps();
+		obbEdgeAxes();
+		obbIntersect();
+		frustumClassifySphere();
+		frustumClassifyOBB();
+	}
+
+private:
+	mt19937 rng{11};
+	uniform_real_distribution<float> dist{-10.0f, 10.0f};
+
+	/** Unit cube with half extents 1, rotated by angle (radians) about axis */
+	static OBB rotatedCube(const Vector3& center, const Vector3& axis, const float angle) {
+		return {AABB({-1, -1, -1}, {1, 1, 1}), center, Quaternion::fromAxisAngle(axis, angle)};
+	}
+
+	/** Region -5 <= x, y, z <= 5 as six planes, so that distances to it are exact */
+	static Frustum cubeFrustum() {
+		Frustum frustum;
+		for (const Vector3& normal : {Vector3(1, 0, 0), Vector3(0, 1, 0), Vector3(0, 0, 1)}) {
+			frustum.planes.emplace_back(normal, normal * -5.0f);
+			frustum.planes.emplace_back(normal * -1.0f, normal * 5.0f);
+		}
+		return frustum;
+	}
+
+	void sphereFromPoints() {
+		BoundingSphere sphere;
+		check(sphere.isEmpty(), "default BoundingSphere is empty");
+
+		array<Vector3, TEST_SPHERE_POINTS> points;
+		for (auto& p : points) {
+			p = Vector3(dist(rng), dist(rng), dist(rng));
+			sphere.expand(p);
+		}
+		for (const auto& p : points) {
+			check(sphere.center.distance(p) <= sphere.radius * (1.0f + TEST_TOLERANCE), "expand() keeps every point inside");
+		}
+
+		const auto fromBox = BoundingSphere::fromAABB(AABB({-1, -2, -3}, {3, 2, 1}));
+		check(near(fromBox.center.x, 1.0f) && near(fromBox.center.y, 0.0f) && near(fromBox.center.z, -1.0f), "fromAABB() center");
+		check(near(fromBox.radius, sqrt(12.0f)), "fromAABB() radius is " + to_string(fromBox.radius) + ", expected sqrt(12)");
+		check(BoundingSphere::fromAABB(AABB()).isEmpty(), "fromAABB() of an empty box is empty");
+	}
+
+	void sphereOverlaps() {
+		const BoundingSphere sphere({0, 0, 0}, 1);
+
+		check(!sphere.overlaps(BoundingSphere({3, 0, 0}, 1)), "separated spheres don't overlap");
+		check(sphere.overlaps(BoundingSphere({2, 0, 0}, 1)), "touching spheres overlap");
+		check(sphere.overlaps(BoundingSphere({0.5f, 0, 0}, 0.25f)), "contained sphere overlaps");
+		check(BoundingSphere({0, 0, 0}, 5).overlaps(sphere), "containing sphere overlaps");
+		check(!sphere.overlaps(BoundingSphere()), "empty sphere overlaps nothing");
+
+		check(!sphere.overlaps(AABB({2, -1, -1}, {4, 1, 1})), "sphere and separated box don't overlap");
+		check(sphere.overlaps(AABB({1, -1, -1}, {3, 1, 1})), "sphere and touching box overlap");
+		check(sphere.overlaps(AABB({-5, -5, -5}, {5, 5, 5})), "sphere inside box overlaps");
+		check(sphere.overlaps(AABB({-0.1f, -0.1f, -0.1f}, {0.1f, 0.1f, 0.1f})), "box inside sphere overlaps");
+		check(!sphere.overlaps(AABB({0.8f, 0.8f, -1}, {2, 2, 1})), "box near the sphere's bounding square doesn't overlap");
+
+		check(sphere.contains({0, 0, 1}), "contains() a point on the surface");
+		check(!sphere.contains({0, 0, 1.01f}), "contains() no point outside");
+	}
+
+	void sphereIntersect() {
+		const BoundingSphere sphere({0, 0, 0}, 1);
+		const Vector3 x(1, 0, 0);
+
+		check(near(sphere.intersect({-5, 0, 0}, x, 100), 4.0f), "ray through the center enters at 4");
+		check(near(sphere.intersect({-5, 1, 0}, x, 100), 5.0f), "tangent ray touches at 5");
+		check(sphere.intersect({-5, 1.01f, 0}, x, 100) == INF, "ray passing by misses");
+		check(sphere.intersect({5, 0, 0}, x, 100) == INF, "ray pointing away misses");
+		check(sphere.intersect({-5, 0, 0}, x, 3) == INF, "ray shorter than the distance misses");
+		check(sphere.intersect({0.5f, 0, 0}, x, 100) == 0.0f, "ray from inside enters at 0");
+	}
+
+	void obbOverlaps() {
+		const OBB box(AABB({-1, -1, -1}, {1, 1, 1}), Vector3::ZERO, Quaternion());
+
+		check(!box.overlaps(OBB(AABB({-1, -1, -1}, {1, 1, 1}), {2.1f, 0, 0}, Quaternion())), "separated boxes don't overlap");
+		check(box.overlaps(OBB(AABB({-1, -1, -1}, {1, 1, 1}), {2, 0, 0}, Quaternion())), "boxes touching face to face overlap");
+		check(box.overlaps(OBB(AABB({-1, -1, -1}, {1, 1, 1}), {2, 2, 2}, Quaternion())), "boxes touching corner to corner overlap");
+		check(!box.overlaps(OBB()), "empty box overlaps nothing");
+
+		// The diamond stops short of the box's corner edge, but its AABB reaches sqrt(2) out and overlaps the box's
+		const auto diamond = rotatedCube({2.2f, 2.2f, 0}, {0, 0, 1}, PI / 4);
+		check(!box.overlaps(diamond), "rotated box past the corner doesn't overlap");
+		check(box.toAABB().overlaps(diamond.toAABB()), "... although their AABBs do");
+		check(diamond.overlaps(rotatedCube({2.2f, 2.2f, 0}, Vector3(1, 1, 0).normalize(), 0.3f)), "boxes with the same center overlap");
+
+		const auto inner = OBB(AABB({-0.2f, -0.2f, -0.2f}, {0.2f, 0.2f, 0.2f}), {0.1f, 0.2f, 0}, Quaternion::fromAxisAngle(Vector3(1, 2, 3).normalize(), 0.7f));
+		check(box.overlaps(inner) && inner.overlaps(box), "contained box overlaps both ways");
+
+		check(!diamond.overlaps(AABB({-1, -1, -1}, {1, 1, 1})), "overlaps(AABB) of a rotated box past the corner");
+		check(diamond.overlaps(AABB({1, 1, -1}, {2, 2, 1})), "overlaps(AABB) of a box reaching into the rotated one");
+		check(box.overlaps(AABB({1, -1, -1}, {3, 1, 1})), "overlaps(AABB) of a touching box");
+	}
+
+	/**
+	 * A diamond standing on its z edge and one lying on its y edge, tip to tip along x. No face normal of
+	 * either separates them, only x, the cross product of those two edges.
+	 */
+	void obbEdgeAxes() {
+		const float tips = 2.0f * sqrt(2.0f);	// Distance at which the edges touch
+		const auto standing = rotatedCube(Vector3::ZERO, {0, 0, 1}, PI / 4);
+
+		check(!standing.overlaps(rotatedCube({tips + 0.1f, 0, 0}, {0, 1, 0}, PI / 4)), "boxes separated only by an edge axis don't overlap");
+		check(standing.overlaps(rotatedCube({tips - 0.1f, 0, 0}, {0, 1, 0}, PI / 4)), "boxes with crossing edges overlap");
+	}
+
+	void obbIntersect() {
+		const OBB box(AABB({-1, -1, -1}, {1, 1, 1}), Vector3::ZERO, Quaternion());
+		const auto diamond = rotatedCube(Vector3::ZERO, {0, 0, 1}, PI / 4);
+		const Vector3 x(1, 0, 0);
+		const Vector3 diagonal = Vector3(1, 1, 0).normalize();
+
+		check(near(diamond.intersect({-5, 0, 0}, x, 100), 5.0f - sqrt(2.0f), 1e-4f), "ray hits the rotated box at its edge");
+		check(diamond.intersect({-5, 1.5f, 0}, x, 100) == INF, "ray passing the rotated box misses");
+		check(diamond.intersect({-5, 0, 0}, x, 3) == INF, "ray shorter than the distance misses");
+		check(diamond.intersect({0.5f, 0, 0}, x, 100) == 0.0f, "ray from inside enters at 0");
+
+		check(near(box.intersect({-3, -1, 0}, diagonal, 100), 2.0f * sqrt(2.0f), 1e-4f), "ray grazing an edge touches it");
+		check(box.intersect({-3, -0.9f, 0}, diagonal, 100) == INF, "ray just above the edge misses");
+		check(OBB().intersect({-5, 0, 0}, x, 100) == INF, "empty box is never hit");
+	}
+
+	void frustumClassifySphere() {
+		const auto cube = cubeFrustum();
+
+		checkContainment(cube.classify(BoundingSphere({7, 0, 0}, 1)), Containment::OUTSIDE, "separated sphere");
+		checkContainment(cube.classify(BoundingSphere({6, 0, 0}, 1)), Containment::INTERSECTS, "sphere touching from outside");
+		checkContainment(cube.classify(BoundingSphere({5, 0, 0}, 1)), Containment::INTERSECTS, "sphere crossing a plane");
+		checkContainment(cube.classify(BoundingSphere({4, 0, 0}, 1)), Containment::INSIDE, "sphere touching from inside");
+		checkContainment(cube.classify(BoundingSphere({0, 0, 0}, 1)), Containment::INSIDE, "contained sphere");
+		checkContainment(cube.classify(BoundingSphere({0, 0, 0}, 10)), Containment::INTERSECTS, "sphere containing the frustum");
+		checkContainment(cube.classify(BoundingSphere()), Containment::OUTSIDE, "empty sphere");
+
+		// 90 degree pyramid along +z
+		const auto pyramid = Frustum::fromCorners(Vector3::ZERO, {Vector3(-1, -1, 1), Vector3(1, -1, 1), Vector3(1, 1, 1), Vector3(-1, 1, 1)});
+		checkContainment(pyramid.classify(BoundingSphere({0, 0, 10}, 1)), Containment::INSIDE, "sphere in the pyramid");
+		checkContainment(pyramid.classify(BoundingSphere({0, 0, -5}, 1)), Containment::OUTSIDE, "sphere behind the apex");
+		checkContainment(pyramid.classify(BoundingSphere({10, 0, 5}, 1)), Containment::OUTSIDE, "sphere beside the pyramid");
+		checkContainment(pyramid.classify(BoundingSphere({0, 0, 0}, 1)), Containment::INTERSECTS, "sphere around the apex");
+	}
+
+	void frustumClassifyOBB() {
+		const auto cube = cubeFrustum();
+		const Quaternion identity;
+		const AABB unit({-1, -1, -1}, {1, 1, 1});
+
+		checkContainment(cube.classify(OBB(unit, {7.5f, 0, 0}, identity)), Containment::OUTSIDE, "separated box");
+		checkContainment(cube.classify(OBB(unit, {6, 0, 0}, identity)), Containment::INTERSECTS, "box touching from outside");
+		checkContainment(cube.classify(OBB(unit, {4, 0, 0}, identity)), Containment::INSIDE, "box touching from inside");
+		checkContainment(cube.classify(OBB(unit, {0, 0, 0}, identity)), Containment::INSIDE, "contained box");
+		checkContainment(cube.classify(OBB(AABB({-6, -6, -6}, {6, 6, 6}), Vector3::ZERO, identity)), Containment::INTERSECTS, "box containing the frustum");
+		checkContainment(cube.classify(OBB()), Containment::OUTSIDE, "empty box");
+
+		// The diamond reaches sqrt(2) beyond its center along x
+		checkContainment(cube.classify(rotatedCube({6.5f, 0, 0}, {0, 0, 1}, PI / 4)), Containment::OUTSIDE, "rotated box past a plane");
+		checkContainment(cube.classify(rotatedCube({6.3f, 0, 0}, {0, 0, 1}, PI / 4)), Containment::INTERSECTS, "rotated box reaching over a plane");
+		checkContainment(cube.classify(rotatedCube({3.5f, 0, 0}, {0, 0, 1}, PI / 4)), Containment::INSIDE, "rotated box within the planes");
+
+		// A thin rod just outside the pyramid and parallel to its side: the OBB rules it out, its AABB can't
+		const auto pyramid = Frustum::fromCorners(Vector3::ZERO, {Vector3(-1, -1, 1), Vector3(1, -1, 1), Vector3(1, 1, 1), Vector3(-1, 1, 1)});
+		const OBB rod(AABB({-5, -0.1f, -0.1f}, {5, 0.1f, 0.1f}), {10.5f, 0, 9.5f}, Quaternion::fromAxisAngle({0, 1, 0}, -PI / 4));
+		checkContainment(pyramid.classify(rod), Containment::OUTSIDE, "rod beside the pyramid");
+		checkContainment(pyramid.classify(rod.toAABB()), Containment::INTERSECTS, "AABB of the rod beside the pyramid");
+		checkContainment(pyramid.classify(rotatedCube({0, 0, 10}, {1, 0, 0}, 0.5f)), Containment::INSIDE, "rotated box in the pyramid");
+	}
+};
+
+
+void runBoundsTests() {
+	BoundsTest().run();
+}
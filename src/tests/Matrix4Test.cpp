@@ -0,0 +1,173 @@
+using namespace std;
+
+#include "Test.h"
+
+#include <array>
+#include <cmath>
+#include <random>
+#include <stdexcept>
+#include <string>
+
+#include "math/matrix/Matrix4.h"
+#include "math/vector/Vector3.h"
+#include "math/vector/Vector4.h"
+
+/** Checks the Matrix4 kernels against a plain row-times-column reference */
+
+// Constants
+constexpr int TEST_MATRICES				= 1000;		// Random matrices per check
+constexpr float TEST_INVERSE_TOLERANCE	= 1e-4f;	// Absolute tolerance of A * A.invert() against the identity
+
+
+/** Element (row, col) of a * b, one dot product of a row and a column */
+static float referenceProduct(const Matrix4& a, const Matrix4& b, const int row, const int col) {
+	float sum = 0.0f;
+	for (int k = 0; k < 4; k++) sum += a(row, k) * b(k, col);
+	return sum;
+}
+
+/** Row of m times the column vector (x, y, z, w) */
+static float referenceRow(const Matrix4& m, const int row, const float x, const float y, const float z, const float w) {
+	return m(row, 0) * x + m(row, 1) * y + m(row, 2) * z + m(row, 3) * w;
+}
+
+
+class Matrix4Test {
+public:
+	void run() {
+		multiplyMatrices();
+		multiplyVectors();
+		transformPointsAndDirections();
+		transposeMatrices();
+		invertMatrices();
+		invertSingular();
+		wRow();
+	}
+
+private:
+	mt19937 rng{7};
+	uniform_real_distribution<float> dist{-2.0f, 2.0f};
+
+	Matrix4 randomMatrix() {
+		array<float, 16> values{};
+		for (auto& value : values) value = dist(rng);
+		return Matrix4(values);
+	}
+
+	void multiplyMatrices() {
+		for (int i = 0; i < TEST_MATRICES; i++) {
+			const auto a = randomMatrix();
+			const auto b = randomMatrix();
+			const auto product = a * b;
+
+			for (int row = 0; row < 4; row++) {
+				for (int col = 0; col < 4; col++) {
+					check(near(product(row, col), referenceProduct(a, b, row, col)),
+						"operator*(Matrix4) at (" + to_string(row) + ", " + to_string(col) + ")");
+				}
+			}
+		}
+	}
+
+	void multiplyVectors() {
+		for (int i = 0; i < TEST_MATRICES; i++) {
+			const auto m = randomMatrix();
+			const Vector4 v(dist(rng), dist(rng), dist(rng), dist(rng));
+			const auto result = m * v;
+
+			const array<float, 4> components = {result.x, result.y, result.z, result.w};
+			for (int row = 0; row < 4; row++) {
+				check(near(components[row], referenceRow(m, row, v.x, v.y, v.z, v.w)),
+					"operator*(Vector4) in row " + to_string(row));
+			}
+		}
+	}
+
+	void transformPointsAndDirections() {
+		for (int i = 0; i < TEST_MATRICES; i++) {
+			const auto m = randomMatrix();
+			const Vector3 v(dist(rng), dist(rng), dist(rng));
+			const auto point	 = m.transformPoint(v);
+			const auto direction = m.transformDirection(v);
+
+			const array<float, 3> points	 = {point.x, point.y, point.z};
+			const array<float, 3> directions = {direction.x, direction.y, direction.z};
+			for (int row = 0; row < 3; row++) {
+				check(near(points[row], referenceRow(m, row, v.x, v.y, v.z, 1.0f)),
+					"transformPoint() in row " + to_string(row));
+				check(near(directions[row], referenceRow(m, row, v.x, v.y, v.z, 0.0f)),
+					"transformDirection() in row " + to_string(row));
+			}
+		}
+	}
+
+	void transposeMatrices() {
+		for (int i = 0; i < TEST_MATRICES; i++) {
+			const auto m = randomMatrix();
+			const auto transposed = m.transpose();
+
+			for (int row = 0; row < 4; row++) {
+				for (int col = 0; col < 4; col++) {
+					check(transposed(row, col) == m(col, row),
+						"transpose() at (" + to_string(row) + ", " + to_string(col) + ")");
+				}
+			}
+		}
+	}
+
+	/** Random matrices with a dominant diagonal, so none of them is close to singular */
+	void invertMatrices() {
+		for (int i = 0; i < TEST_MATRICES; i++) {
+			array<float, 16> values{};
+			for (auto& value : values) value = dist(rng);
+			for (int d = 0; d < 16; d += 5) values[d] += 8.0f;
+
+			const Matrix4 m(values);
+			const auto identity = m * m.invert();
+
+			for (int row = 0; row < 4; row++) {
+				for (int col = 0; col < 4; col++) {
+					const float expected = row == col ? 1.0f : 0.0f;
+					check(abs(identity(row, col) - expected) <= TEST_INVERSE_TOLERANCE,
+						"A * A.invert() at (" + to_string(row) + ", " + to_string(col) + ")");
+				}
+			}
+		}
+	}
+
+	void invertSingular() {
+		const auto throws = [](const Matrix4& m) {
+			try {
+				(void) m.invert();
+			} catch (const runtime_error&) {
+				return true;
+			}
+			return false;
+		};
+
+		check(throws(Matrix4()), "invert() of the zero matrix throws");
+		check(throws({
+			1, 2, 3, 4,
+			2, 4, 6, 8,		// Twice the first row
+			0, 1, 0, 0,
+			0, 0, 1, 0
+		}), "invert() of a rank-deficient matrix throws");
+	}
+
+	/** The w row reads m34 times z (it once read m34 alone) */
+	void wRow() {
+		const Matrix4 m({
+			1, 0, 0, 0,
+			0, 1, 0, 0,
+			0, 0, 1, 0,
+			0, 0, 5, 0
+		});
+		const auto result = m * Vector4(1, 1, 2, 1);
+		check(result.w == 10.0f, "w of operator*(Vector4) is " + to_string(result.w) + ", expected 10");
+	}
+};
+
+
+void runMatrix4Tests() {
+	Matrix4Test().run();
+}
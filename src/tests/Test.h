@@ -0,0 +1,33 @@
+#pragma once
+
+using namespace std;
+
+#include <cmath>
+#include <iostream>
+#include <string>
+
+/*
+ * Minimal harness shared by the test suites, run from TestMain.cpp. Built twice, as Qengine_tests with the
+ * SSE paths and as Qengine_tests_scalar with FORCE_SCALAR; run both with ctest --test-dir <build dir>.
+ */
+
+// Constants
+constexpr float TEST_TOLERANCE = 1e-5f;	// Default relative tolerance of near()
+
+
+inline int failures = 0;
+
+inline void check(const bool condition, const string& message) {
+	if (!condition) {
+		failures++;
+		cerr << "FAILED: " << message << endl;
+	}
+}
+
+inline bool near(const float a, const float b, const float tolerance = TEST_TOLERANCE) {
+	return abs(a - b) <= tolerance * (1.0f + abs(a) + abs(b));
+}
+
+// Suites
+void runMatrix4Tests();
+void runBoundsTests();
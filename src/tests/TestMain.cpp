@@ -0,0 +1,26 @@
+using namespace std;
+
+#include "Test.h"
+
+#include <iostream>
+
+#include "math/Simd.h"
+
+
+int main() {
+#ifdef USE_SSE
+	cout << "Tests (SSE)" << endl;
+#else
+	cout << "Tests (scalar)" << endl;
+#endif
+
+	runMatrix4Tests();
+	runBoundsTests();
+
+	if (failures > 0) {
+		cerr << failures << " check(s) failed" << endl;
+		return 1;
+	}
+	cout << "All checks passed" << endl;
+	return 0;
+}
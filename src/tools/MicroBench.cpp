@@ -0,0 +1,287 @@
+using namespace std;
+
+#include <memory>
+#include <random>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "math/Simd.h"
+#include "math/Util.h"
+#include "math/bvh/TrianglePackets.h"
+#include "math/matrix/BatchTransform.h"
+#include "math/ray/Ray.h"
+#include "objects/mesh/sphere/Sphere.cpp"
+
+/*
+ * JSON results: cmake --build <build dir> --target run_microbench writes <build dir>/microbench.json.
+ * To compare two builds, run it on both and diff the files with tools/compare.py from Google Benchmark.
+ */
+
+// Constants
+constexpr size_t BENCH_TRIANGLES = 4096;	// Triangle soup size for the brute-force benchmarks
+constexpr size_t BENCH_RAYS		 = 256;		// Rays cycled through per benchmark
+constexpr size_t BENCH_VECTORS	 = 1024;	// Vectors / matrices / points cycled through by the math benchmarks
+
+
+/** Random small triangles in a cube, with rays from one side through it */
+struct Soup {
+	vector<shared_ptr<Vertex>> vertices;
+	vector<Triangle> triangles;
+	TrianglePackets packets;
+	vector<Ray> rays;
+
+	Soup() {
+		mt19937 rng(42);
+		uniform_real_distribution<float> dist(-1.0f, 1.0f);
+
+		packets.resize(BENCH_TRIANGLES);
+		for (size_t i = 0; i < BENCH_TRIANGLES; i++) {
+			const Vector3 center = {dist(rng) * 2.0f, dist(rng) * 2.0f, dist(rng) * 2.0f};
+			array<shared_ptr<Vertex>, 3> corners;
+			for (auto& corner : corners) {
+				corner = make_shared<Vertex>(center + Vector3(dist(rng), dist(rng), dist(rng)) * 0.2f, Vector2(0.0, 0.0));
+				vertices.emplace_back(corner);
+			}
+			triangles.emplace_back(corners[0], corners[1], corners[2]);
+			packets.set(i, corners[0]->position, corners[1]->position, corners[2]->position);
+		}
+
+		for (size_t i = 0; i < BENCH_RAYS; i++) {
+			const Vector3 origin = {dist(rng) * 3.0f, dist(rng) * 3.0f, 5.0f};
+			rays.emplace_back(origin, (Vector3(dist(rng), dist(rng), 0.0f) - origin).normalize());
+		}
+	}
+};
+
+static const Soup& soup() {
+	static const Soup instance;
+	return instance;
+}
+
+/** Random operands for the math benchmarks, plus a camera looking down -z from z = 5 */
+struct Operands {
+	vector<Vector3> vectors;
+	vector<Vector2> screenPoints;
+	vector<Matrix4> matrices;
+	PointBatch points;
+
+	array<int, 4> viewport = {0, 0, 1920, 1080};
+	array<float, 16> viewMatrix{}, projMatrix{};
+	Matrix4 view, proj, inverseView, inverseProj;
+
+	Operands() {
+		mt19937 rng(7);
+		uniform_real_distribution<float> dist(-1.0f, 1.0f);
+
+		points.resize(BENCH_VECTORS);
+		for (size_t i = 0; i < BENCH_VECTORS; i++) {
+			vectors.emplace_back(dist(rng), dist(rng), dist(rng));
+			screenPoints.emplace_back((dist(rng) + 1.0f) * 960.0f, (dist(rng) + 1.0f) * 540.0f);
+			matrices.emplace_back(
+				Matrix4::translate(vectors.back()) *
+				Matrix4::rotateX(dist(rng)) * Matrix4::rotateY(dist(rng)) *
+				Matrix4::scale(Vector3(1.5f, 1.5f, 1.5f) + vectors.back())
+			);
+			points.x[i] = vectors[i].x;
+			points.y[i] = vectors[i].y;
+			points.z[i] = vectors[i].z;
+		}
+
+		// 45 degree vertical field of view, near 0.1, far 100
+		constexpr float f = 2.4142135f, n = 0.1f, fa = 100.0f, aspect = 1920.0f / 1080.0f;
+		view = Matrix4::translate(Vector3(0, 0, -5));
+		proj = {
+			f / aspect, 0, 0, 0,
+			0, f, 0, 0,
+			0, 0, (fa + n) / (n - fa), 2 * fa * n / (n - fa),
+			0, 0, -1, 0
+		};
+		copy_n(view.data(), 16, viewMatrix.begin());
+		copy_n(proj.data(), 16, projMatrix.begin());
+		inverseView = view.invert();
+		inverseProj = proj.invert();
+	}
+};
+
+static const Operands& operands() {
+	static const Operands instance;
+	return instance;
+}
+
+
+static void BM_Vector3Ops(benchmark::State& state) {
+	const auto& o = operands();
+	Vector3 sum;
+	for (auto _ : state) {
+		for (size_t i = 0; i + 1 < BENCH_VECTORS; i++) {
+			const auto& a = o.vectors[i];
+			const auto& b = o.vectors[i + 1];
+			sum = sum + a.cross(b) * a.dot(b) + (a - b).normalize();
+		}
+		benchmark::DoNotOptimize(sum);
+	}
+	state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * (BENCH_VECTORS - 1)));
+}
+BENCHMARK(BM_Vector3Ops);
+
+static void BM_Matrix4Multiply(benchmark::State& state) {
+	const auto& o = operands();
+	size_t i = 0;
+	for (auto _ : state) {
+		benchmark::DoNotOptimize(o.matrices[i % BENCH_VECTORS] * o.matrices[(i + 1) % BENCH_VECTORS]);
+		i++;
+	}
+	state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_Matrix4Multiply);
+
+static void BM_Matrix4Invert(benchmark::State& state) {
+	const auto& o = operands();
+	size_t i = 0;
+	for (auto _ : state) benchmark::DoNotOptimize(o.matrices[i++ % BENCH_VECTORS].invert());
+	state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_Matrix4Invert);
+
+/** One point at a time through ::project, as the per-Vertex callers do */
+static void BM_Project(benchmark::State& state) {
+	const auto& o = operands();
+	size_t i = 0;
+	for (auto _ : state) benchmark::DoNotOptimize(project(o.vectors[i++ % BENCH_VECTORS], &o.viewport, o.viewMatrix, o.projMatrix));
+	state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_Project);
+
+/** The same points through the batch kernel, for the per-point cost against BM_Project */
+static void BM_ProjectPoints(benchmark::State& state) {
+	const auto& o = operands();
+	const Matrix4 viewProj = o.proj * o.view;
+	ScreenBatch screen;
+	for (auto _ : state) {
+		projectPoints(viewProj, o.viewport, o.points, screen);
+		benchmark::DoNotOptimize(screen.x.data());
+	}
+	state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * BENCH_VECTORS));
+}
+BENCHMARK(BM_ProjectPoints);
+
+static void BM_TransformPoints(benchmark::State& state) {
+	const auto& o = operands();
+	PointBatch out;
+	for (auto _ : state) {
+		transformPoints(o.matrices[0], o.points, out);
+		benchmark::DoNotOptimize(out.x.data());
+	}
+	state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * BENCH_VECTORS));
+}
+BENCHMARK(BM_TransformPoints);
+
+/** Inverting the camera matrices per call, or reusing the cached inverses (see Camera::getInverseView()) */
+static void BM_Unproject(benchmark::State& state) {
+	const auto& o = operands();
+	const bool cached = state.range(0) != 0;
+	size_t i = 0;
+	for (auto _ : state) {
+		const auto& p = o.screenPoints[i++ % BENCH_VECTORS];
+		benchmark::DoNotOptimize(cached
+			? unproject(p, &o.viewport, o.inverseView, o.inverseProj)
+			: unproject(p, &o.viewport, o.viewMatrix, o.projMatrix));
+	}
+	state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_Unproject)->Arg(0)->Arg(1)->ArgName("cached");
+
+static void BM_TriangleFaceNormal(benchmark::State& state) {
+	const auto& s = soup();
+	for (auto _ : state) {
+		Vector3 sum;
+		for (const auto& t : s.triangles) sum = sum + t.faceNormal();
+		benchmark::DoNotOptimize(sum);
+	}
+	state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * BENCH_TRIANGLES));
+}
+BENCHMARK(BM_TriangleFaceNormal);
+
+
+/** Baseline: Ray::intersects through the Vertex pointers of every Triangle */
+static void BM_RayTriangleScalar(benchmark::State& state) {
+	const auto& s = soup();
+	size_t ray = 0;
+	for (auto _ : state) {
+		const auto& r = s.rays[ray++ % BENCH_RAYS];
+		int hits = 0;
+		for (const auto& t : s.triangles) hits += r.intersects(t);
+		benchmark::DoNotOptimize(hits);
+	}
+	state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * BENCH_TRIANGLES));
+}
+BENCHMARK(BM_RayTriangleScalar);
+
+/** TrianglePackets over the whole soup (brute force) or in BVH leaf-sized ranges, per kernel */
+static void BM_RayTrianglePackets(benchmark::State& state) {
+	const auto level = static_cast<SimdLevel>(state.range(0));
+	const auto range = static_cast<size_t>(state.range(1));
+	if (level > detectSimdLevel()) {
+		state.SkipWithError("Not supported by this CPU");
+		return;
+	}
+	TrianglePackets::setKernel(level);
+	state.SetLabel(simdLevelName(level));
+
+	const auto& s = soup();
+	size_t ray = 0;
+	for (auto _ : state) {
+		const auto& r = s.rays[ray++ % BENCH_RAYS];
+		RayHit hit;
+		for (size_t first = 0; first < BENCH_TRIANGLES; first += range) {
+			benchmark::DoNotOptimize(s.packets.intersect(r.origin, r.direction, first, min(range, BENCH_TRIANGLES - first), hit));
+		}
+	}
+	state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * BENCH_TRIANGLES));
+	TrianglePackets::setKernel(detectSimdLevel());
+}
+BENCHMARK(BM_RayTrianglePackets)
+	->ArgsProduct({
+		{static_cast<int>(SimdLevel::SCALAR), static_cast<int>(SimdLevel::SSE), static_cast<int>(SimdLevel::AVX2), static_cast<int>(SimdLevel::AVX512)},
+		{MESH_BVH_LEAF_SIZE_MAX, BENCH_TRIANGLES}
+	})
+	->ArgNames({"isa", "range"});
+
+
+/** Sphere resolutions (segments, rings) shared by the Mesh benchmarks */
+static void sphereResolutions(benchmark::internal::Benchmark* b) {
+	b->Args({16, 8})->Args({64, 32})->Args({256, 128})->ArgNames({"segments", "rings"});
+}
+
+static shared_ptr<Sphere> makeSphere(const benchmark::State& state) {
+	return make_shared<Sphere>(
+		"Sphere", Vector3::ZERO, 1.0f,
+		static_cast<int>(state.range(0)), static_cast<int>(state.range(1)),
+		Colors::WHITE, shared_ptr<Texture>{}
+	);
+}
+
+/** Whole construction: Vertices from the cached table, Triangles, adjacency maps and normals */
+static void BM_SphereConstruction(benchmark::State& state) {
+	for (auto _ : state) benchmark::DoNotOptimize(makeSphere(state));
+	state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_SphereConstruction)->Apply(sphereResolutions);
+
+static void BM_BuildEdgeToFaceMap(benchmark::State& state) {
+	const auto sphere = makeSphere(state);
+	for (auto _ : state) sphere->buildEdgeToFaceMap();
+	state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * sphere->triangles.size()));
+}
+BENCHMARK(BM_BuildEdgeToFaceMap)->Apply(sphereResolutions);
+
+static void BM_BuildVertexToEdgeMap(benchmark::State& state) {
+	const auto sphere = makeSphere(state);
+	for (auto _ : state) sphere->buildVertexToEdgeMap();
+	state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * sphere->vertices.size()));
+}
+BENCHMARK(BM_BuildVertexToEdgeMap)->Apply(sphereResolutions);
+
+
+BENCHMARK_MAIN();
@@ -0,0 +1,505 @@
+using namespace std;
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#ifdef _WIN32
+	#define NOMINMAX
+	#include <windows.h>
+	#include <psapi.h>
+#else
+	#include <sys/resource.h>
+#endif
+
+#include "viewport/Viewport.h"
+#include "viewport/scene/Scene.h"
+#include "viewport/scene/SceneManager.h"
+#include "graphics/ui/UISceneManager.h"
+
+#include "objects/mesh/cube/Cube.cpp"
+#include "objects/mesh/sphere/Sphere.cpp"
+#include "objects/light/Light.h"
+
+// Constants
+constexpr float OBJECT_SPACING		= 3.0f;		// Distance between neighbouring Objects of the grid
+constexpr float ORBIT_ELEVATION		= 30.0f;	// Camera elevation in degrees during the orbit
+constexpr float ORBIT_DISTANCE		= 1.5f;		// Camera distance relative to the extent of the grid
+constexpr float TRANSFORM_STEP		= 0.002f;	// Mouse world-space movement per transform step
+constexpr double PERCENTILES[]		= {50.0, 90.0, 95.0, 99.0};
+
+
+/** Size of the stress scene and of every scripted phase, all settable from the command line */
+struct BenchConfig {
+	int spheres			= 100;	// Spheres in the grid
+	int sphereSegments	= 32;	// Their segments (rings: half of it)
+	int cubes			= 100;	// Cubes in the grid
+	int meshSegments	= 512;	// Segments of the single large sphere in the center (0: none)
+
+	int frames			= 600;	// Frames rendered during one camera orbit
+	int picks			= 500;	// Picks at random window positions
+	int regions			= 100;	// Region selections of random rectangles
+	int transformSteps	= 200;	// Mouse movements per transform mode
+
+	int width			= 1920;
+	int height			= 1080;
+	string output;				// JSON file, stdout if empty
+};
+
+/** Nearest-rank percentiles of a set of latencies in milliseconds */
+struct Stats {
+	size_t count	= 0;
+	double mean		= 0.0;
+	double min		= 0.0;
+	double max		= 0.0;
+	vector<double> percentiles;
+
+	explicit Stats(vector<double> samples) {
+		if (samples.empty()) return;
+		ranges::sort(samples);
+
+		count = samples.size();
+		min	  = samples.front();
+		max	  = samples.back();
+		for (const double s : samples) mean += s;
+		mean /= static_cast<double>(count);
+
+		for (const double p : PERCENTILES) {
+			const auto rank = static_cast<size_t>(ceil(p / 100.0 * static_cast<double>(count)));
+			percentiles.emplace_back(samples[std::max<size_t>(rank, 1) - 1]);
+		}
+	}
+
+	void write(ostream& out) const {
+		out << "{\"count\": " << count << ", \"mean\": " << mean << ", \"min\": " << min << ", \"max\": " << max;
+		for (size_t i = 0; i < percentiles.size(); i++) {
+			out << ", \"p" << PERCENTILES[i] << "\": " << percentiles[i];
+		}
+		out << "}";
+	}
+};
+
+
+/**
+ * End-to-end stress test of the whole engine: builds a procedural scene of the configured size
+ * and runs scripted camera orbits, picks, region selections and transforms through SceneManager,
+ * just as the input callbacks would. Frames are rendered offscreen in a hidden window.
+ */
+class SceneBench {
+public:
+	explicit SceneBench(BenchConfig config);
+	~SceneBench();
+
+	void run();
+	void write(ostream& out) const;
+
+private:
+	BenchConfig config;
+	GLFWwindow* window = nullptr;
+	unique_ptr<Framebuffer> target;
+
+	shared_ptr<Scene> scene;
+	vector<shared_ptr<Mesh>> meshes;
+	float extent = 0.0f;	// Half the side length of the grid
+	mt19937 rng{42};
+
+	// Results
+	size_t vertexCount = 0, triangleCount = 0;
+	double setupTime = 0.0;
+	int rayHits = 0, gpuHits = 0;
+	vector<double> frameTimes, rayPickTimes, gpuPickTimes, objectRegionTimes, vertexRegionTimes;
+	vector<double> grabTimes, rotateTimes, scaleTimes;
+
+	void buildScene();
+	void orbit();
+	void pick();
+	void selectRegions();
+	void transform(const Mode& mode, vector<double>& times);
+
+	void renderFrame() const;
+	[[nodiscard]] Vector2 randomPoint();
+
+	template<typename F>
+	static double measure(F&& f) {
+		const auto start = chrono::steady_clock::now();
+		f();
+		return chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+	}
+};
+
+
+SceneBench::SceneBench(BenchConfig config) : config(move(config)) {
+	glfwSetErrorCallback([](int, const char *description) {
+		cerr << "GLFW Error: " << description << endl;
+	});
+
+	if (!glfwInit()) {
+		throw runtime_error("Failed to initialize GLFW");
+	}
+
+	glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+	window = glfwCreateWindow(this->config.width, this->config.height, "Qengine_bench", nullptr, nullptr);
+	if (!window) {
+		glfwTerminate();
+		throw runtime_error("Failed to open window");
+	}
+	glfwMakeContextCurrent(window);
+
+	glewExperimental = GL_TRUE;
+	if (glewInit() != GLEW_OK) {
+		glfwDestroyWindow(window);
+		glfwTerminate();
+		throw runtime_error("Failed to initialize GLEW");
+	}
+	glfwSwapInterval(0);
+
+	// Same fixed-function state as the Viewport
+	glEnable(GL_MULTISAMPLE);
+	glEnable(GL_DEPTH_TEST);
+	glEnable(GL_TEXTURE_2D);
+	glEnable(GL_RESCALE_NORMAL);
+	glEnable(GL_LIGHTING);
+	glEnable(GL_NORMALIZE);
+	glEnable(GL_BLEND);
+	glBlendFunc(GL_ONE, GL_ZERO);
+
+	// The hidden window's own framebuffer may not be rasterized at all, so render offscreen if possible
+	if (Framebuffer::isSupported()) {
+		target = make_unique<Framebuffer>(ANTIALIASING_SAMPLES);
+		target->resize(this->config.width, this->config.height);
+	}
+	if (PickingBuffer::isSupported()) {
+		SceneManager::pickingBuffer = make_unique<PickingBuffer>();
+	}
+
+	SceneManager::viewport		= make_shared<array<int, 4>>(array{0, 0, this->config.width, this->config.height});
+	SceneManager::activeCamera	= make_shared<Camera>();
+	SceneManager::mouseRay		= make_shared<Ray>(Vector3::ZERO, Vector3::ONE);
+
+	glViewport(0, 0, this->config.width, this->config.height);
+	SceneManager::activeCamera->setAspect(static_cast<float>(this->config.width) / static_cast<float>(this->config.height));
+}
+
+SceneBench::~SceneBench() {
+	// GL resources first, while the context is still alive
+	target.reset();
+	SceneManager::pickingBuffer.reset();
+	SceneManager::selection.clear();
+	SceneManager::deleteScene(scene);
+	meshes.clear();
+	scene.reset();
+
+	glfwDestroyWindow(window);
+	glfwTerminate();
+}
+
+void SceneBench::run() {
+	setupTime = measure([this] { buildScene(); });
+	cerr << "Scene: " << meshes.size() << " Meshes, " << vertexCount << " Vertices, " << triangleCount
+		 << " Triangles (" << setupTime << " ms)" << endl;
+
+	orbit();
+	pick();
+	selectRegions();
+
+	// Transform everything but the first Cube, so grabbing has something to snap to
+	vector<shared_ptr<Object>> selected(meshes.begin() + (meshes.size() > 1 ? 1 : 0), meshes.end());
+	SceneManager::selection.assign(selected);
+	transform(GRAB, grabTimes);
+	transform(ROTATE, rotateTimes);
+	transform(SCALE, scaleTimes);
+	SceneManager::deselectAllObjects();
+}
+
+
+/** Spheres and Cubes alternating on a square grid in the xy-plane, around the large sphere */
+void SceneBench::buildScene() {
+	scene = make_shared<Scene>("Bench");
+
+	const int count = config.spheres + config.cubes;
+	const int side  = max(1, static_cast<int>(ceil(sqrt(static_cast<double>(count)))));
+	extent = static_cast<float>(side) * OBJECT_SPACING * 0.5f;
+
+	const auto gridPosition = [&](const int i) {
+		return Vector3(
+			static_cast<float>(i % side) * OBJECT_SPACING - extent + OBJECT_SPACING * 0.5f,
+			static_cast<float>(i / side) * OBJECT_SPACING - extent + OBJECT_SPACING * 0.5f,
+			0.0f
+		);
+	};
+
+	int spheres = 0, cubes = 0;
+	for (int i = 0; i < count; i++) {
+		// Interleave both kinds, so every part of the grid is equally expensive
+		const bool sphere = cubes >= config.cubes || (spheres < config.spheres && i % 2 == 1);
+		const auto mesh = sphere
+			? static_pointer_cast<Mesh>(make_shared<Sphere>(
+				"Sphere " + to_string(spheres++), gridPosition(i), 0.5f,
+				config.sphereSegments, max(2, config.sphereSegments / 2),
+				Colors::WHITE, shared_ptr<Texture>{}))
+			: static_pointer_cast<Mesh>(make_shared<Cube>(
+				"Cube " + to_string(cubes++), gridPosition(i), 1.0f,
+				Colors::WHITE, shared_ptr<Texture>{}));
+		meshes.emplace_back(mesh);
+	}
+
+	if (config.meshSegments > 0) {
+		meshes.emplace_back(make_shared<Sphere>(
+			"Large Mesh", Vector3(0.0f, 0.0f, OBJECT_SPACING), OBJECT_SPACING,
+			config.meshSegments, max(2, config.meshSegments / 2),
+			Colors::WHITE, shared_ptr<Texture>{}
+		));
+	}
+
+	// Scene::addObject() refreshes the whole scene tree of the UI per Object, which is quadratic in the Object count,
+	// so the Objects are added before the Scene (which registers them for picking all at once)
+	scene->sceneObjects.assign(meshes.begin(), meshes.end());
+	SceneManager::addScene(scene);
+	UISceneManager::update();
+	for (const auto& mesh : meshes) {
+		vertexCount	  += mesh->vertices.size();
+		triangleCount += mesh->triangles.size();
+	}
+
+	array lightPos = {2.0f, 3.0f, 6.0f, 0.0f};
+	scene->addLight(make_shared<Light>("Sun", GL_LIGHT1, lightPos), Colors::LIGHT_SUN, Colors::LIGHT_AMBIENT, Colors::WHITE);
+
+	// Start the orbit with the whole grid in view
+	SceneManager::activeCamera->camDist = std::max(extent, OBJECT_SPACING) * 2.0f * ORBIT_DISTANCE;
+	SceneManager::activeCamera->setPerspective(0.0f, ORBIT_ELEVATION);
+}
+
+/** One full turn around the scene, a frame per step */
+void SceneBench::orbit() {
+	const auto& camera = SceneManager::activeCamera;
+	for (int i = 0; i < config.frames; i++) {
+		camera->setPerspective(360.0f * static_cast<float>(i) / static_cast<float>(config.frames), ORBIT_ELEVATION);
+		frameTimes.emplace_back(measure([this] { renderFrame(); }));
+	}
+}
+
+/**
+ * Snapshot, clear and render the Scenes like Viewport::captureFrame() and Viewport::render() do
+ * on their two threads, but in sequence and waiting for the GPU to finish
+ */
+void SceneBench::renderFrame() const {
+	const auto sceneSnapshots = SceneManager::snapshotScenes();
+	const auto camera = SceneManager::activeCamera->snapshot();
+
+	if (target) target->bind();
+
+	glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+	SceneManager::renderScenes(sceneSnapshots, camera);
+	glFinish();
+}
+
+/** Object picks through the scene BVH and, if supported, through the PickingBuffer */
+void SceneBench::pick() {
+	const auto& camera = SceneManager::activeCamera;
+	const auto& pickable = SceneManager::getPickableMeshes();
+
+	for (int i = 0; i < config.picks; i++) {
+		const auto p = randomPoint();
+		rayPickTimes.emplace_back(measure([&] {
+			const Ray ray(camera->camPos, camera->unproject(p, *SceneManager::viewport).normalize());
+			rayHits += SceneManager::pick(ray).mesh != nullptr;
+		}));
+
+		if (SceneManager::pickingBuffer) {
+			gpuPickTimes.emplace_back(measure([&] {
+				const auto result = SceneManager::pickingBuffer->pick(
+					pickable, {}, PickTarget::OBJECT,
+					static_cast<int>(p.x), static_cast<int>(p.y), 0,
+					*SceneManager::viewport, camera->viewMatrix, camera->projMatrix
+				);
+				gpuHits += result.has_value();
+			}));
+		}
+	}
+}
+
+/** Random rectangles, over the Objects in Object Mode and over the Vertices of the large Mesh in Edit Mode */
+void SceneBench::selectRegions() {
+	const auto rectangle = [this] {
+		SelectionRegion region;
+		region.begin(randomPoint(), RegionShape::RECTANGLE);
+		region.extend(randomPoint());
+		return region;
+	};
+
+	SceneManager::selectionMode = OBJECT;
+	for (int i = 0; i < config.regions; i++) {
+		const auto region = rectangle();
+		objectRegionTimes.emplace_back(measure([&] { SceneManager::selectRegion(region); }));
+	}
+
+	SceneManager::selection.assign({meshes.back()});
+	SceneManager::selectionMode = EDIT;
+	for (int i = 0; i < config.regions; i++) {
+		const auto region = rectangle();
+		vertexRegionTimes.emplace_back(measure([&] { SceneManager::selectRegion(region); }));
+	}
+
+	SceneManager::deselectAllVertices();
+	SceneManager::selectionMode = OBJECT;
+	SceneManager::deselectAllObjects();
+}
+
+/** Drag the selected Meshes along the x axis in the given mode, as the mouse movement callback would */
+void SceneBench::transform(const Mode& mode, vector<double>& times) {
+	const auto& camera = SceneManager::activeCamera;
+	const auto& viewport = *SceneManager::viewport;
+
+	SceneManager::setTransformMode(mode);
+	SceneManager::setTransformSubMode(SubMode::X);
+
+	for (int i = 0; i < config.transformSteps; i++) {
+		const Vector2 mouse(
+			static_cast<float>(viewport[2]) * 0.5f + static_cast<float>(i),
+			static_cast<float>(viewport[3]) * 0.5f
+		);
+		const auto worldPos = Vector3(static_cast<float>(i + 1) * TRANSFORM_STEP, 0.0f, 0.0f);
+		times.emplace_back(measure([&] {
+			SceneManager::transform(mouse.x, mouse.y, worldPos, camera->camPos, mode == GRAB);
+		}));
+	}
+
+	SceneManager::applyTransformation();
+}
+
+Vector2 SceneBench::randomPoint() {
+	uniform_real_distribution<float> x(0.0f, static_cast<float>(config.width));
+	uniform_real_distribution<float> y(0.0f, static_cast<float>(config.height));
+	return {x(rng), y(rng)};
+}
+
+
+/** Peak resident memory of the process in bytes */
+static size_t peakMemory() {
+#ifdef _WIN32
+	PROCESS_MEMORY_COUNTERS counters{};
+	if (!GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) return 0;
+	return counters.PeakWorkingSetSize;
+#else
+	rusage usage{};
+	getrusage(RUSAGE_SELF, &usage);
+	return static_cast<size_t>(usage.ru_maxrss) * 1024;	// Kilobytes
+#endif
+}
+
+void SceneBench::write(ostream& out) const {
+	const auto stats = [&out](const char* name, const vector<double>& samples, const bool last = false) {
+		out << "    \"" << name << "\": ";
+		Stats(samples).write(out);
+		out << (last ? "\n" : ",\n");
+	};
+
+	out << "{\n";
+	out << "  \"config\": {\"spheres\": " << config.spheres << ", \"sphere_segments\": " << config.sphereSegments
+		<< ", \"cubes\": " << config.cubes << ", \"mesh_segments\": " << config.meshSegments
+		<< ", \"width\": " << config.width << ", \"height\": " << config.height << "},\n";
+	out << "  \"scene\": {\"meshes\": " << meshes.size() << ", \"vertices\": " << vertexCount
+		<< ", \"triangles\": " << triangleCount << ", \"setup_ms\": " << setupTime << "},\n";
+	out << "  \"gpu\": {\"offscreen\": " << (target ? "true" : "false")
+		<< ", \"picking_buffer\": " << (SceneManager::pickingBuffer ? "true" : "false") << "},\n";
+	out << "  \"pick_hits\": {\"ray\": " << rayHits << ", \"gpu\": " << gpuHits << "},\n";
+
+	out << "  \"latency_ms\": {\n";
+	stats("frame", frameTimes);
+	stats("pick_ray", rayPickTimes);
+	stats("pick_gpu", gpuPickTimes);
+	stats("select_region_objects", objectRegionTimes);
+	stats("select_region_vertices", vertexRegionTimes);
+	stats("transform_grab", grabTimes);
+	stats("transform_rotate", rotateTimes);
+	stats("transform_scale", scaleTimes, true);
+	out << "  },\n";
+
+	out << "  \"peak_memory_bytes\": " << peakMemory() << "\n";
+	out << "}" << endl;
+}
+
+
+static void usage() {
+	cerr << "Usage: Qengine_bench [--spheres n] [--sphere-segments n] [--cubes n] [--mesh-segments n]\n"
+		 << "                     [--frames n] [--picks n] [--regions n] [--transform-steps n]\n"
+		 << "                     [--width n] [--height n] [--out file.json]" << endl;
+}
+
+static BenchConfig parseArguments(const int argc, char* argv[]) {
+	BenchConfig config;
+	const vector<pair<string, int*>> counts = {
+		{"--spheres", &config.spheres},
+		{"--sphere-segments", &config.sphereSegments},
+		{"--cubes", &config.cubes},
+		{"--mesh-segments", &config.meshSegments},
+		{"--frames", &config.frames},
+		{"--picks", &config.picks},
+		{"--regions", &config.regions},
+		{"--transform-steps", &config.transformSteps},
+		{"--width", &config.width},
+		{"--height", &config.height}
+	};
+
+	for (int i = 1; i < argc; i++) {
+		const string arg = argv[i];
+		if (i + 1 >= argc) throw invalid_argument("Missing value for " + arg);
+		const string value = argv[++i];
+
+		if (arg == "--out") {
+			config.output = value;
+			continue;
+		}
+		const auto it = ranges::find(counts, arg, &pair<string, int*>::first);
+		if (it == counts.end()) throw invalid_argument("Unknown option " + arg);
+		*it->second = stoi(value);
+		if (*it->second < 0) throw invalid_argument(arg + " must not be negative");
+	}
+
+	if (config.sphereSegments < 3) throw invalid_argument("--sphere-segments must be at least 3");
+	if (config.meshSegments != 0 && config.meshSegments < 3) throw invalid_argument("--mesh-segments must be 0 or at least 3");
+	if (config.spheres + config.cubes + (config.meshSegments > 0) == 0) throw invalid_argument("The scene is empty");
+	if (config.width <= 0 || config.height <= 0) throw invalid_argument("The window size must be positive");
+	return config;
+}
+
+
+/**
+ * Headless end-to-end benchmark: how frame time, picking, selection and transform latency
+ * and memory scale with the scene size. Results are written as JSON.
+ *
+ * Usage: see usage(), e.g. Qengine_bench --spheres 1000 --cubes 1000 --out bench.json
+ */
+int main(const int argc, char* argv[]) {
+	BenchConfig config;
+	try {
+		config = parseArguments(argc, argv);
+	} catch (const exception& e) {
+		cerr << e.what() << endl;
+		usage();
+		return EXIT_FAILURE;
+	}
+
+	try {
+		SceneBench bench(config);
+		bench.run();
+
+		if (config.output.empty()) {
+			bench.write(cout);
+		} else {
+			ofstream file(config.output);
+			if (!file) throw runtime_error("Failed to open " + config.output);
+			bench.write(file);
+		}
+	} catch (const exception& e) {
+		cerr << e.what() << endl;
+		return EXIT_FAILURE;
+	}
+
+	return EXIT_SUCCESS;
+}
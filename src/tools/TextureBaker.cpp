@@ -0,0 +1,76 @@
+using namespace std;
+
+#include <algorithm>
+#include <filesystem>
+#include <iostream>
+#include <set>
+
+#include "graphics/material/texture/TextureCache.h"
+#include "graphics/material/texture/TextureCompressor.h"
+
+#define STB_IMAGE_IMPLEMENTATION
+#include "graphics/material/libs/stb_image.h"
+
+constexpr auto DEFAULT_SOURCE_DIR = "../resources/textures";
+
+const set<string> SOURCE_EXTENSIONS = {".png", ".jpg", ".jpeg", ".bmp", ".tga"};
+
+
+/**
+ * Offline texture baker: compresses every image in the source directory into the
+ * TextureCache, so that Qengine finds ready-to-upload mip chains on its first launch.
+ *
+ * Usage: Qengine_texbake [source directory] [cache directory]
+ */
+int main(const int argc, char* argv[]) {
+	const string sourceDir = argc > 1 ? argv[1] : DEFAULT_SOURCE_DIR;
+	const string cacheDir  = argc > 2 ? argv[2] : TEXTURE_CACHE_DIR;
+
+	if (!filesystem::is_directory(sourceDir)) {
+		cerr << "Source directory " << sourceDir << " not found" << endl;
+		return EXIT_FAILURE;
+	}
+
+	stbi_set_flip_vertically_on_load(1);	// Must match the runtime loader
+
+	int baked = 0, upToDate = 0, failed = 0;
+	for (const auto& entry : filesystem::directory_iterator(sourceDir)) {
+		auto extension = entry.path().extension().string();
+		ranges::transform(extension, extension.begin(), ::tolower);
+		if (!entry.is_regular_file() || !SOURCE_EXTENSIONS.contains(extension)) continue;
+
+		const auto filename = entry.path().string();
+		const auto bytes = TextureCache::readFile(filename);
+		const auto sourceHash = TextureCache::hash(bytes);
+
+		if (TextureCache::read(sourceHash, cacheDir)) {
+			upToDate++;
+			continue;
+		}
+
+		int width, height, channels;
+		unsigned char* pixels = stbi_load_from_memory(bytes.data(), static_cast<int>(bytes.size()), &width, &height, &channels, 0);
+		if (!pixels) {
+			cerr << "Failed to decode " << filename << ": " << stbi_failure_reason() << endl;
+			failed++;
+			continue;
+		}
+
+		const auto image = TextureCompressor::compress(pixels, width, height, channels);
+		stbi_image_free(pixels);
+
+		if (!TextureCache::write(sourceHash, image, cacheDir)) {
+			cerr << "Failed to write " << TextureCache::path(sourceHash, cacheDir) << endl;
+			failed++;
+			continue;
+		}
+
+		cout << filename << " -> " << TextureCache::path(sourceHash, cacheDir)
+			 << " (" << width << "x" << height << ", " << image.levels.size() << " levels, "
+			 << (image.format == BlockFormat::BC1 ? "BC1" : "BC3") << ")" << endl;
+		baked++;
+	}
+
+	cout << baked << " baked, " << upToDate << " up to date, " << failed << " failed" << endl;
+	return failed == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -2,6 +2,8 @@
 
 #include "Camera.h"
 
+#include "Redraw.h"
+
 
 Camera::Camera()
 	: camPos(CAMERA_POSITION_INIT), lookAt(LOOK_AT_POINT_INIT), up(UP_VECTOR_INIT) {
@@ -18,70 +20,127 @@ Camera::~Camera() = default;
  * Function to set up a perspective projection matrix, which is essential for rendering 3D scenes
  * in a way that simulates human vision, where objects further away appear smaller than those closer.
  */
-void Camera::loadProjectionMatrix(const float aspect) {
-	glMatrixMode(GL_PROJECTION);	// Subsequent matrix operations will affect the projection matrix
-	glLoadIdentity();
+void Camera::setAspect(const float aspect) {
+	updateProjection(aspect);
+}
 
-	const auto fh = static_cast<float>(tan(radians(FOV_Y)) / 2 * Z_NEAR);	// Height of the Near Clipping Plane
-	const auto fw = fh * aspect;											//  Width of the Near Clipping Plane
-	constexpr float dz = Z_FAR - Z_NEAR;
+CameraSnapshot Camera::snapshot() {
+	updateView();
+
+	CameraSnapshot snapshot;
+	snapshot.viewMatrix = viewMatrix;
+	snapshot.projMatrix = projMatrix;
+	fixedView.toFloatArray(snapshot.fixedViewMatrix.data());
+	snapshot.camPos = camPos;
+	return snapshot;
+}
 
-	// Update the projection matrix
-	projMatrix = {
-		Z_NEAR / fw, 0.0f,		    0.0f,				  0.0f,
-		0.0f,        Z_NEAR / fh,   0.0f,				  0.0f,
-		0.0f,        0.0f,		  -(Z_FAR + Z_NEAR) / dz, -1.0f,
-		0.0f,        0.0f,		  -(2.0f * Z_FAR * Z_NEAR) / dz,  0.0f
-	};
 
-	glMultMatrixf(projMatrix.data());
+const Matrix4& Camera::getView() {
+	updateView();
+	return view;
 }
 
-/**
- * Defines a viewing transformation by specifying an eye point, a reference point indicating.
- * the center of the scene, and an up vector.
- */
-void Camera::loadViewMatrix() {
-	glMatrixMode(GL_MODELVIEW);      // Subsequent matrix operations will affect the modelview matrix
-	glLoadIdentity();
+const Matrix4& Camera::getViewProjection() {
+	updateView();
+	return viewProj;
+}
 
-	const Vector3 forward = (lookAt - camPos).normalize();	// Calculate the forward vector (direction from eye to center)
-	const Vector3 side = forward.cross(up).normalize();		// Calculate the side vector (perpendicular to both forward and up vectors)
-	const Vector3 zUp = side.cross(forward);				// Recalculate the actual up vector to ensure orthogonality
+const Matrix4& Camera::getInverseView() {
+	updateView();
+	return invView;
+}
+
+const Matrix4& Camera::getInverseViewProjection() {
+	updateView();
+	return invViewProj;
+}
 
-	// Update the view matrix
-	viewMatrix = {
-		 side.x,			zUp.x,			-forward.x,			  0.0f,
-		 side.y,			zUp.y,			-forward.y,			  0.0f,
-		 side.z,			zUp.z,			-forward.z,			  0.0f,
-		-side.dot(camPos), -zUp.dot(camPos), forward.dot(camPos), 1.0f
-	};
+uint64_t Camera::getVersion() {
+	updateView();
+	return version;
+}
 
-	glMultMatrixf(viewMatrix.data());
+Vector3 Camera::unproject(const Vector2& screenPoint, const array<int, 4>& viewport) {
+	return ::unproject(screenPoint, &viewport, getInverseView(), getInverseProjection());
 }
 
-void Camera::loadFixedViewMatrix() {
-	glMatrixMode(GL_MODELVIEW); // Set the matrix mode to modelview
-	glLoadIdentity();           // Reset the current modelview matrix
+/** Rebuild the view matrix and its inverse if the camera moved since the last call */
+void Camera::updateView() {
+	if (viewValid && camPos == viewPos && lookAt == viewLookAt && up == viewUp) return;
 
-	// Calculate the forward vector (camera's local negative Z-axis)
-	const Vector3 forward = (lookAt - camPos).normalize();
+	const Vector3 forward = (lookAt - camPos).normalize();	// Calculate the forward vector (direction from eye to center)
+	const Vector3 side = forward.cross(up).normalize();		// Calculate the side vector (perpendicular to both forward and up vectors)
+	const Vector3 zUp = side.cross(forward);				// Recalculate the actual up vector to ensure orthogonality
 
-	// Calculate the side vector (perpendicular to the forward and up vectors)
-	const Vector3 side = forward.cross(up).normalize();
+	// The rotation rows are the camera axes, followed by the rotated negative camera position
+	view = Matrix4({
+		 side.x,		 side.y,		 side.z,		-side.dot(camPos),
+		 zUp.x,			 zUp.y,			 zUp.z,			-zUp.dot(camPos),
+		-forward.x,		-forward.y,		-forward.z,		 forward.dot(camPos),
+		 0.0f,			 0.0f,			 0.0f,			 1.0f
+	});
+	fixedView = Matrix4({
+		 side.x,		 side.y,		 side.z,		 0.0f,
+		 zUp.x,			 zUp.y,			 zUp.z,			 0.0f,
+		-forward.x,		-forward.y,		-forward.z,		 0.0f,
+		 0.0f,			 0.0f,			 0.0f,			 1.0f
+	});
+
+	// Rigid transformation: the inverse rotation is the transpose, the inverse translation the camera position
+	invView = Matrix4({
+		side.x,		zUp.x,		-forward.x,		camPos.x,
+		side.y,		zUp.y,		-forward.y,		camPos.y,
+		side.z,		zUp.z,		-forward.z,		camPos.z,
+		0.0f,		0.0f,		 0.0f,			1.0f
+	});
+
+	view.toFloatArray(viewMatrix.data());
+	viewProj	= proj * view;
+	invViewProj = invView * invProj;
+
+	viewPos		= camPos;
+	viewLookAt	= lookAt;
+	viewUp		= up;
+	viewValid	= true;
+	version++;
+}
 
-	// Recalculate the actual up vector to ensure orthogonality
-	const Vector3 zUp = side.cross(forward);
+/** Rebuild the projection matrix and its inverse if the aspect ratio changed since the last call */
+void Camera::updateProjection(const float aspect) {
+	if (aspect == projAspect) return;
 
-	// Create the fixed view matrix without applying camera position translation
-	viewMatrix = {
-		side.x,   zUp.x,   -forward.x,   0.0f,
-		side.y,   zUp.y,   -forward.y,   0.0f,
-		side.z,   zUp.z,   -forward.z,   0.0f,
-		0.0f,     0.0f,    0.0f,         1.0f // No translation, fixed view
-	};
+	const auto fh = static_cast<float>(tan(radians(FOV_Y)) / 2 * Z_NEAR);	// Height of the Near Clipping Plane
+	const auto fw = fh * aspect;											//  Width of the Near Clipping Plane
+	constexpr float dz = Z_FAR - Z_NEAR;
 
-	glMultMatrixf(viewMatrix.data());
+	const float sx = Z_NEAR / fw;
+	const float sy = Z_NEAR / fh;
+	constexpr float a = -(Z_FAR + Z_NEAR) / dz;
+	constexpr float b = -(2.0f * Z_FAR * Z_NEAR) / dz;
+
+	proj = Matrix4({
+		sx,		0.0f,	0.0f,	0.0f,
+		0.0f,	sy,		0.0f,	0.0f,
+		0.0f,	0.0f,	a,		b,
+		0.0f,	0.0f,	-1.0f,	0.0f
+	});
+
+	// Scales invert to their reciprocals, the depth rows solve for z and w
+	invProj = Matrix4({
+		1.0f / sx,	0.0f,		0.0f,		0.0f,
+		0.0f,		1.0f / sy,	0.0f,		0.0f,
+		0.0f,		0.0f,		0.0f,		-1.0f,
+		0.0f,		0.0f,		1.0f / b,	a / b
+	});
+
+	proj.toFloatArray(projMatrix.data());
+	projAspect = aspect;
+
+	updateView();
+	viewProj	= proj * view;
+	invViewProj = invView * invProj;
+	version++;
 }
 
 /** Update camera position based on spherical coordinates. */
@@ -100,7 +159,8 @@ void Camera::updatePosition() {
 		camDist * sinV
 	);
 
-	loadViewMatrix();
+	updateView();
+	Redraw::request();
 }
 
 void Camera::initRotation(const bool isRotating, const double mouseX, const double mouseY) {
@@ -3,10 +3,20 @@
 using namespace std;
 
 #include <array>
+#include <cstdint>
 
+#include "math/matrix/Matrix4.h"
 #include "math/ray/Ray.h"
 
 
+/** Matrices and position of a Camera at one point in time, for drawing a frame on the render thread */
+struct CameraSnapshot {
+	array<GLfloat, 16> viewMatrix{};		// Column-major
+	array<GLfloat, 16> fixedViewMatrix{};	// Without the translation, for the background
+	array<GLfloat, 16> projMatrix{};
+	Vector3 camPos;
+};
+
 // Constants
 const auto CAMERA_POSITION_INIT			= Vector3(10.0f, 0, 0);		// Default camera position
 const auto LOOK_AT_POINT_INIT			= Vector3(0, 0, 0);			// Default: Looking at origin
@@ -27,7 +37,7 @@ public:
 	Camera(const Vector3 &camPos, const Vector3 &lookAt, const Vector3 &up);
 	~Camera();
 
-	array<GLfloat, 16> viewMatrix{};
+	array<GLfloat, 16> viewMatrix{};	// Column-major copies of getView() and getProjection()
 	array<GLfloat, 16> projMatrix{};
 
 	Vector3 camPos		= CAMERA_POSITION_INIT;
@@ -39,9 +49,8 @@ public:
 	double rotH			= 0.0;
 	double rotV			= 0.0;
 
-	void loadProjectionMatrix(float aspect);
-	void loadViewMatrix();
-	void loadFixedViewMatrix();
+	/** Update the projection to a new aspect ratio of the Viewport */
+	void setAspect(float aspect);
 
 	void updatePosition();
 	void initRotation(bool isRotating, double mouseX, double mouseY);
@@ -49,7 +58,41 @@ public:
 	void zoom(double yoffset);
 	void setPerspective(float h, float v);
 
+	/**
+	 * Matrices and their inverses, recomputed on access only if camPos, lookAt, up or the aspect ratio
+	 * changed since. The inverses are built in closed form (transposed rotation, reciprocal projection).
+	 */
+	[[nodiscard]] const Matrix4& getView();
+	[[nodiscard]] const Matrix4& getProjection() const { return proj; }
+	[[nodiscard]] const Matrix4& getViewProjection();
+	[[nodiscard]] const Matrix4& getInverseView();
+	[[nodiscard]] const Matrix4& getInverseProjection() const { return invProj; }
+	[[nodiscard]] const Matrix4& getInverseViewProjection();
+
+	/** Copy of the current matrices; the Camera itself makes no GL calls, so it can be changed while a frame is drawn */
+	[[nodiscard]] CameraSnapshot snapshot();
+
+	/** Incremented whenever one of the matrices changes */
+	[[nodiscard]] uint64_t getVersion();
+
+	/** World-space direction through a point in window coordinates (see ::unproject) */
+	[[nodiscard]] Vector3 unproject(const Vector2 &screenPoint, const array<int, 4> &viewport);
+
 private:
+	// Cached matrices
+	Matrix4 view, proj, viewProj;
+	Matrix4 invView, invProj, invViewProj;
+	Matrix4 fixedView;		// View without the translation, for the background
+	uint64_t version = 0;
+
+	// Inputs of the cached matrices
+	Vector3 viewPos, viewLookAt, viewUp;
+	float projAspect	= 0.0f;
+	bool viewValid		= false;
+
+	void updateView();
+	void updateProjection(float aspect);
+
 	double rotSens		= 0.5;
 	double lastH		= 0.0;
 	double lastV		= 0.0;
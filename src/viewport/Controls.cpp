@@ -1,14 +1,17 @@
 #include "scene/SceneManager.h"
+#include "viewport/RenderThread.h"
 #include "viewport/Viewport.h"
 
 // Controls
 
 /**
  * Initialization function to set callbacks for events:
- *   - Window resizing
+ *   - Window resizing and refreshing
  *   - Mouse:
  *      - Left mouse button:
- *          - Select object
+ *          - Click: Select object (or Vertex in Edit Mode)
+ *          - Drag: Box selection
+ *          - CTRL + drag: Lasso selection
  *      - Middle mouse button:
  *          - Hold and drag: Rotate Viewport around the origin
  *          - Scroll: Zoom in and out of the Viewport
@@ -18,36 +21,69 @@
  *      - TAB
  *          - Toggle Object/Edit Mode
  *      - Object transformation:
- *          - G: Grab
+ *          - G: Grab (hold CTRL to snap to the nearest Vertex of other Objects)
  *          - S: Scale
  *          - R: Rotate
+ *      - V: Toggle visible-only region selection
+ *      - Edit Mode selection:
+ *          - A: Select/deselect all
+ *          - I: Invert
+ *          - Numpad +/-: Grow/shrink
  *      - Mesh operations:
  *          - E: Extrude
  *          - F: Fill
  *          - M: Merge
+ *
+ * Every input event requests a redraw of the Viewport (see Redraw). The callbacks run on the main thread
+ * and never touch the GL context, which belongs to the RenderThread.
  */
 void Viewport::setCallbacks(GLFWwindow* window) {
 	// Window resize callback
 	glfwSetFramebufferSizeCallback(window, [](GLFWwindow* cbWindow, const int width, const int height) {
 		if (const auto vp = static_cast<Viewport*>(glfwGetWindowUserPointer(cbWindow))) {
 			vp->windowResize(width, height);
-			vp->render();				// Force a re-render during resizing
 			UI::unsavedChanges = true;	// Trigger UI resize
 
-			glfwSwapBuffers(cbWindow);
+			// The main loop doesn't run while the window is being resized on some platforms, so hand over
+			// a frame of the new size right away (replacing one that wasn't picked up yet)
+			RenderThread::submit(vp->captureFrame());
 		}
 	});
 
+	// Window refresh callback (e.g. after the window was uncovered)
+	glfwSetWindowRefreshCallback(window, [](GLFWwindow*) {
+		Redraw::request();
+	});
+
 	// Mouse button callbacks
-	glfwSetMouseButtonCallback(window, [](GLFWwindow* cbWindow, const int button, const int action, const int) {
+	glfwSetMouseButtonCallback(window, [](GLFWwindow* cbWindow, const int button, const int action, const int mods) {
 		if (const auto vp = static_cast<Viewport*>(glfwGetWindowUserPointer(cbWindow))) {
+			Redraw::request();
+
 			if (button == GLFW_MOUSE_BUTTON_LEFT && action == GLFW_PRESS) {
 				const auto mousePos = Vector2(*SceneManager::mouseX, *SceneManager::mouseY);
-				vp->setMouseRay(mousePos);
-				SceneManager::select(mousePos, false);
+				if (SceneManager::transformMode != NONE) {
+					// Clicking applies the transformation
+					vp->setMouseRay(mousePos);
+					SceneManager::select(mousePos, false);
+				} else {
+					// Selection happens on release, once it's clear whether this is a click or a drag
+					vp->selectionRegion.begin(mousePos, mods & GLFW_MOD_CONTROL ? RegionShape::LASSO : RegionShape::RECTANGLE);
+				}
 				UI::checkButtonPressed();
 			}
 
+			else if (button == GLFW_MOUSE_BUTTON_LEFT && action == GLFW_RELEASE && vp->selectionRegion.isActive()) {
+				if (vp->selectionRegion.isDrag()) {
+					SceneManager::selectRegion(vp->selectionRegion);
+				} else {
+					const auto mousePos = Vector2(*SceneManager::mouseX, *SceneManager::mouseY);
+					vp->setMouseRay(mousePos);
+					SceneManager::select(mousePos, false);
+				}
+				vp->selectionRegion.clear();
+			}
+
 			else if (button == GLFW_MOUSE_BUTTON_MIDDLE) {
 				vp->activeCamera->initRotation(action == GLFW_PRESS, *SceneManager::mouseX, *SceneManager::mouseY);
 			}
@@ -57,32 +93,45 @@ void Viewport::setCallbacks(GLFWwindow* window) {
 	// Cursor position callback
 	glfwSetCursorPosCallback(window, [](GLFWwindow* cbWindow, const double x, const double y) {
 		if (const auto vp = static_cast<Viewport*>(glfwGetWindowUserPointer(cbWindow))) {
-			// Update the mouse position in the Viewport
-			glfwGetCursorPos(cbWindow, SceneManager::mouseX, SceneManager::mouseY);
+			Redraw::request();
+
+			// Update the mouse position in the Viewport (the UI reads it while drawing)
+			{
+				lock_guard lock(UI::uiMutex);
+				glfwGetCursorPos(cbWindow, SceneManager::mouseX, SceneManager::mouseY);
+			}
 
 			if (SceneManager::transformMode == NONE) {
 				// Viewport rotation
 				if (vp->activeCamera->rotating) {
 					vp->activeCamera->rotate(x, y);
 				}
+
+				// Region selection
+				vp->selectionRegion.extend(Vector2(x, y));
 			} else {
 				// Object transformation
-				const Vector3 worldPos = unproject(Vector2(*SceneManager::mouseX, *SceneManager::mouseY), vp->viewport.get(), vp->activeCamera->viewMatrix, vp->activeCamera->projMatrix);
-				SceneManager::transform(x, y, worldPos, vp->activeCamera->camPos);
+				const Vector3 worldPos = vp->activeCamera->unproject(Vector2(*SceneManager::mouseX, *SceneManager::mouseY), *vp->viewport);
+				const bool snap = glfwGetKey(cbWindow, GLFW_KEY_LEFT_CONTROL) == GLFW_PRESS || glfwGetKey(cbWindow, GLFW_KEY_RIGHT_CONTROL) == GLFW_PRESS;
+				SceneManager::transform(x, y, worldPos, vp->activeCamera->camPos, snap);
 			}
 		}
 	});
 
 	// Mouse scroll callback
 	glfwSetScrollCallback(window, [](GLFWwindow* cbWindow, const double, const double yOffset) {
-		if (const auto vp = static_cast<Viewport*>(glfwGetWindowUserPointer(cbWindow)))
+		if (const auto vp = static_cast<Viewport*>(glfwGetWindowUserPointer(cbWindow))) {
+			Redraw::request();
 			vp->activeCamera->zoom(yOffset);
+		}
 	});
 
 	// Key callbacks
 	glfwSetKeyCallback(window, [](GLFWwindow *cbWindow, const int key, const int scancode, const int action, int const mods) {
-		if (const auto vp = static_cast<Viewport*>(glfwGetWindowUserPointer(cbWindow)))
+		if (const auto vp = static_cast<Viewport*>(glfwGetWindowUserPointer(cbWindow))) {
+			Redraw::request();
 			vp->onKeyboardInput(cbWindow, key, scancode, action, mods);
+		}
 	});
 
 	// Set the user pointer to the Viewport instance
@@ -117,6 +166,13 @@ void Viewport::onKeyboardInput(GLFWwindow *cbWindow, const int key, const int sc
 		case GLFW_KEY_M: SceneManager::setTransformMode(MERGE); break;					// M -> Merge
 
 		case GLFW_KEY_C: drawCoordinateSystem = !drawCoordinateSystem; break;			// C -> Toggle coordinate system visibility
+		case GLFW_KEY_V: SceneManager::selectVisibleOnly = !SceneManager::selectVisibleOnly; break;	// V -> Toggle visible-only region selection
+
+		// Edit Mode selection
+		case GLFW_KEY_A: if (SceneManager::selectionMode == EDIT) SceneManager::toggleAllVertices(); break;			// A -> (De)select all Vertices
+		case GLFW_KEY_I: if (SceneManager::selectionMode == EDIT) SceneManager::invertVertexSelection(); break;		// I -> Invert Vertex selection
+		case GLFW_KEY_KP_ADD: if (SceneManager::selectionMode == EDIT) SceneManager::growVertexSelection(); break;		// Numpad + -> Grow Vertex selection
+		case GLFW_KEY_KP_SUBTRACT: if (SceneManager::selectionMode == EDIT) SceneManager::shrinkVertexSelection(); break;	// Numpad - -> Shrink Vertex selection
 
 		// Set Transform SubMode
 		case GLFW_KEY_X || GLFW_KEY_Y || GLFW_KEY_Z: {
@@ -0,0 +1,29 @@
+#pragma once
+
+using namespace std;
+
+#include <string>
+#include <vector>
+
+#include "Camera.h"
+#include "scene/SceneSnapshot.h"
+#include "scene/SelectionRegion.h"
+
+
+/**
+ * Everything the render thread needs to draw one frame, taken by Viewport::captureFrame() on the main thread.
+ * Immutable once submitted, so the main thread can go on changing the Scenes while it's drawn.
+ */
+struct FrameSnapshot {
+	int width  = 0;
+	int height = 0;
+
+	CameraSnapshot camera;
+	vector<SceneSnapshot> scenes;
+
+	SelectionRegion selectionRegion;
+	bool drawCoordinateSystem = true;
+	Vector3 rayStart, rayEnd;
+
+	vector<string> debugText;	// Scene state lines of the on-screen debug text
+};
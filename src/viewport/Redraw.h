@@ -0,0 +1,53 @@
+#pragma once
+
+using namespace std;
+
+#include <atomic>
+
+#include <GLFW/glfw3.h>
+
+// Constants
+constexpr bool ON_DEMAND_RENDERING	= true;		// Only redraw the Viewport when something changed
+constexpr double IDLE_WAIT_TIMEOUT	= 1.0;		// Longest time in seconds the main loop blocks while waiting for events
+
+
+/**
+ * Keeps track of whether the Viewport needs a new frame when on-demand rendering is enabled.
+ *
+ * Anything that changes what's on screen without going through a GLFW input callback
+ * (Scene and Camera changes, timers, streamed assets, ...) should request a redraw here.
+ * Requests may come from any thread; they wake up the main loop if it's blocked in
+ * glfwWaitEventsTimeout().
+ */
+class Redraw {
+public:
+	/** Mark the Viewport as dirty */
+	static void request() {
+		if (!requested.exchange(true)) glfwPostEmptyEvent();
+	}
+
+	/** Open-ended animations (e.g. dragging, streaming textures) redraw until they end */
+	static void beginAnimation() {
+		++activeAnimations;
+		request();
+	}
+
+	static void endAnimation() {
+		if (activeAnimations > 0) --activeAnimations;
+		request();	// Draw the final state
+	}
+
+	/** Returns whether a frame should be drawn now and clears the pending request */
+	static bool consume() {
+		return requested.exchange(false) || activeAnimations > 0;
+	}
+
+	/** How long the main loop may block while waiting for events */
+	static double waitTimeout() {
+		return activeAnimations > 0 || requested ? 0.0 : IDLE_WAIT_TIMEOUT;
+	}
+
+private:
+	inline static atomic<bool> requested		= true;	// Draw the first frame
+	inline static atomic<int> activeAnimations	= 0;
+};
@@ -0,0 +1,99 @@
+#include "RenderThread.h"
+
+#include "FrameSnapshot.h"
+
+
+void RenderThread::start(GLFWwindow* window, function<void(const FrameSnapshot&)> draw) {
+	if (running) return;
+
+	RenderThread::window = window;
+	RenderThread::draw	 = move(draw);
+	stopping = false;
+
+	// A context can only be current on one thread at a time
+	glfwMakeContextCurrent(nullptr);
+
+	running = true;
+	worker = thread(loop);
+}
+
+void RenderThread::stop() {
+	if (!running) return;
+
+	{
+		lock_guard lock(frameMutex);
+		stopping = true;
+	}
+	frameCondition.notify_one();
+	worker.join();
+
+	running = false;
+	glfwMakeContextCurrent(window);
+}
+
+void RenderThread::submit(shared_ptr<const FrameSnapshot> frame) {
+	{
+		lock_guard lock(frameMutex);
+		// Snapshots may hold the last reference to a Texture, so they're only released on the render thread
+		if (back) replaced.emplace_back(move(back));
+		back = move(frame);
+	}
+	frameCondition.notify_one();
+}
+
+bool RenderThread::isIdle() {
+	lock_guard lock(frameMutex);
+	return !back;
+}
+
+void RenderThread::post(function<void()> task) {
+	{
+		lock_guard lock(frameMutex);
+		tasks.emplace_back(move(task));
+	}
+	frameCondition.notify_one();
+}
+
+
+void RenderThread::loop() {
+	onRenderThread = true;
+	glfwMakeContextCurrent(window);
+
+	shared_ptr<const FrameSnapshot> front;
+	while (true) {
+		vector<function<void()>> work;
+		vector<shared_ptr<const FrameSnapshot>> released;
+		bool newFrame = false;
+		{
+			unique_lock lock(frameMutex);
+			frameCondition.wait(lock, [] { return back || !tasks.empty() || stopping; });
+			if (stopping) break;
+
+			work.swap(tasks);
+			released.swap(replaced);
+			if (back) {
+				front	 = move(back);
+				newFrame = true;
+			}
+		}
+
+		for (const auto& task : work) {
+			task();
+		}
+
+		if (newFrame) {
+			glfwPostEmptyEvent();	// The main loop may take the next snapshot now
+			draw(*front);
+		}
+	}
+
+	// Release the snapshots while the context is still current
+	front.reset();
+	{
+		lock_guard lock(frameMutex);
+		back.reset();
+		replaced.clear();
+	}
+
+	glfwMakeContextCurrent(nullptr);
+}
@@ -0,0 +1,80 @@
+#pragma once
+
+using namespace std;
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <GLFW/glfw3.h>
+
+struct FrameSnapshot;
+
+
+/**
+ * Thread owning the GL context, so that input handling on the main thread never waits for the GPU
+ * and vice versa.
+ *
+ * The main thread keeps the authoritative Scenes and hands over immutable FrameSnapshots, double-buffered:
+ * the front snapshot is being drawn while the back one waits for the next frame. A newer snapshot replaces
+ * a back one that wasn't picked up yet, so presentation always shows the latest state. Everything else that
+ * needs the context (e.g. GPU picking) goes through invoke() and runs between two frames.
+ */
+class RenderThread {
+public:
+	/** Release the window's context on the calling thread and draw every new snapshot with draw on a new thread */
+	static void start(GLFWwindow *window, function<void(const FrameSnapshot&)> draw);
+
+	/** Finish the current frame, join, and make the context current on the calling thread again */
+	static void stop();
+
+	[[nodiscard]] static bool isRunning() { return running; }
+
+	/** Replace the back snapshot; never blocks on drawing */
+	static void submit(shared_ptr<const FrameSnapshot> frame);
+
+	/** Whether the last submitted snapshot was picked up, so a new one wouldn't replace it unseen */
+	[[nodiscard]] static bool isIdle();
+
+	/**
+	 * Run fn with the GL context and return its result, blocking until it's done.
+	 * Runs inline if no render thread is running or if called from it.
+	 */
+	template <typename F>
+	static auto invoke(F &&fn) -> decltype(fn());
+
+private:
+	inline static thread worker;
+	inline static GLFWwindow *window = nullptr;
+	inline static function<void(const FrameSnapshot&)> draw;
+	inline static atomic<bool> running = false;
+
+	inline static mutex frameMutex;
+	inline static condition_variable frameCondition;
+	inline static shared_ptr<const FrameSnapshot> back;				// Guarded by frameMutex
+	inline static vector<shared_ptr<const FrameSnapshot>> replaced;	// Dropped back snapshots; guarded by frameMutex
+	inline static vector<function<void()>> tasks;					// Guarded by frameMutex
+	inline static bool stopping = false;							// Guarded by frameMutex
+
+	inline static thread_local bool onRenderThread = false;
+
+	static void loop();
+	static void post(function<void()> task);
+};
+
+
+template <typename F>
+auto RenderThread::invoke(F&& fn) -> decltype(fn()) {
+	if (!running || onRenderThread) return fn();
+
+	// function<> needs a copyable target, so share the task
+	const auto task = make_shared<packaged_task<decltype(fn())()>>(forward<F>(fn));
+	auto result = task->get_future();
+	post([task] { (*task)(); });
+	return result.get();
+}
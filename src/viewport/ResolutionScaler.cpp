@@ -0,0 +1,51 @@
+#include "ResolutionScaler.h"
+
+#include <algorithm>
+#include <cmath>
+
+
+ResolutionScaler::ResolutionScaler(const double targetFrameTime) : targetFrameTime(targetFrameTime) {}
+
+/**
+ * Feed the duration of the last frame into the moving average and adjust the scale.
+ *
+ * Going down, the scale is chosen so that the pixel count shrinks by the ratio of target
+ * to average frame time (pixel count grows with the square of the scale). Going up
+ * happens one step at a time so the scale doesn't oscillate around the target.
+ */
+void ResolutionScaler::addFrameTime(const double ms) {
+	averageFrameTime = averageFrameTime == 0.0
+		? ms
+		: averageFrameTime + FRAME_TIME_SMOOTHING * (ms - averageFrameTime);
+
+	if (!enabled) {
+		scale = RESOLUTION_SCALE_MAX;
+		return;
+	}
+
+	// Give the average time to settle after the last change
+	if (cooldown > 0) {
+		cooldown--;
+		return;
+	}
+
+	float newScale = scale;
+	if (averageFrameTime > targetFrameTime * FRAME_TIME_UPPER_BOUND) {
+		newScale = scale * static_cast<float>(sqrt(targetFrameTime / averageFrameTime));
+		newScale = floor(newScale / RESOLUTION_SCALE_STEP) * RESOLUTION_SCALE_STEP;
+	} else if (averageFrameTime < targetFrameTime * FRAME_TIME_LOWER_BOUND) {
+		newScale = scale + RESOLUTION_SCALE_STEP;
+	}
+	newScale = clamp(newScale, RESOLUTION_SCALE_MIN, RESOLUTION_SCALE_MAX);
+
+	if (abs(newScale - scale) > RESOLUTION_SCALE_STEP / 2.0f) {
+		scale = newScale;
+		cooldown = RESOLUTION_SCALE_COOLDOWN;
+	}
+}
+
+void ResolutionScaler::reset() {
+	averageFrameTime = 0.0;
+	scale = RESOLUTION_SCALE_MAX;
+	cooldown = RESOLUTION_SCALE_COOLDOWN;
+}
@@ -0,0 +1,39 @@
+#pragma once
+
+using namespace std;
+
+// Constants
+constexpr double TARGET_FRAME_TIME			= 1000.0 / 60.0;	// Frame time target in ms (60 FPS)
+constexpr double FRAME_TIME_SMOOTHING		= 0.1;				// Weight of the newest sample in the moving average
+constexpr double FRAME_TIME_UPPER_BOUND		= 1.05;				// Scale down if the average exceeds the target by this factor
+constexpr double FRAME_TIME_LOWER_BOUND		= 0.75;				// Scale up if the average falls below the target by this factor
+
+constexpr float RESOLUTION_SCALE_MIN		= 0.5f;				// Lowest fraction of the window resolution used for the 3D Scenes
+constexpr float RESOLUTION_SCALE_MAX		= 1.0f;
+constexpr float RESOLUTION_SCALE_STEP		= 0.05f;			// Scale is quantized to avoid reallocating the render target every frame
+constexpr int RESOLUTION_SCALE_COOLDOWN		= 30;				// Frames to wait after a change before adjusting again
+
+
+/**
+ * Picks the internal render resolution of the 3D Scenes based on an exponential
+ * moving average of the frame time, so that a given frame time target is held.
+ */
+class ResolutionScaler {
+public:
+	explicit ResolutionScaler(double targetFrameTime = TARGET_FRAME_TIME);
+
+	void addFrameTime(double ms);
+	void reset();
+
+	[[nodiscard]] float getScale() const { return scale; }
+	[[nodiscard]] double getAverageFrameTime() const { return averageFrameTime; }
+
+	bool enabled = true;
+
+private:
+	double targetFrameTime;
+	double averageFrameTime = 0.0;
+
+	float scale		= RESOLUTION_SCALE_MAX;
+	int cooldown	= RESOLUTION_SCALE_COOLDOWN;
+};
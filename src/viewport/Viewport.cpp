@@ -10,11 +10,18 @@
 #include "objects/light/Light.h"
 
 #include "graphics/material/texture/Texture.h"
+#include "graphics/material/texture/TextureLoader.h"
+#include "graphics/material/texture/TextureRegistry.h"
 #include "graphics/ui/UI.h"
+#include "jobs/JobSystem.h"
 
 #include "scene/Scene.h"
 #include "scene/SceneManager.h"
 
+#include "FrameSnapshot.h"
+#include "RenderThread.h"
+#include "graphics/text/Debug.h"
+
 
 Viewport::Viewport(const string& title, const int width, const int height)
 	: title(title), width(width), height(height) {
@@ -41,6 +48,14 @@ Viewport::Viewport(const string& title, const int width, const int height)
 	glfwSetWindowUserPointer(window, this);
 	glfwShowWindow(window);
 
+	// Load OpenGL extension functions (framebuffer objects etc.)
+	glewExperimental = GL_TRUE;
+	if (glewInit() != GLEW_OK) {
+		glfwDestroyWindow(window);
+		glfwTerminate();
+		throw runtime_error("Failed to initialize GLEW");
+	}
+
 	if (glfwRawMouseMotionSupported()) {
 		glfwSetInputMode(window, GLFW_RAW_MOUSE_MOTION, GLFW_TRUE);
 	}
@@ -65,6 +80,18 @@ Viewport::Viewport(const string& title, const int width, const int height)
 	glEnable(GL_BLEND);
 	glBlendFunc(GL_ONE, GL_ZERO);
 
+	// Offscreen target for rendering the 3D Scenes at a reduced resolution
+	if (Framebuffer::isSupported()) {
+		sceneTarget = make_unique<Framebuffer>(ANTIALIASING_SAMPLES);
+	} else {
+		resolutionScaler.enabled = false;
+	}
+
+	// Offscreen ID buffer for picking (falls back to ray casting if unavailable)
+	if (PickingBuffer::isSupported()) {
+		SceneManager::pickingBuffer = make_unique<PickingBuffer>();
+	}
+
 	// Other setup
 	viewport	 = make_shared<array<int, 4>>();
 	activeCamera = make_shared<Camera>();
@@ -77,12 +104,21 @@ Viewport::Viewport(const string& title, const int width, const int height)
 }
 
 Viewport::~Viewport() {
-	// Cleanup
+	// Take the context back from the render thread
+	RenderThread::stop();
+
+	// Cleanup (GL resources first, while the context is still alive)
+	TextureLoader::stop();
+	TextureRegistry::cleanup();
+	sceneTarget.reset();
+	SceneManager::pickingBuffer.reset();
 	glfwDestroyWindow(window);
 	glfwTerminate();
 
 	SceneManager::cleanupScenes();
 	UI::cleanup();
+
+	JobSystem::stop();	// Last, everything above may still wait for jobs
 }
 
 void Viewport::start() {
@@ -99,11 +135,11 @@ void Viewport::start() {
 	SceneManager::addScene(background);
 	SceneManager::addScene(foreground);
 
-	// Load Textures
+	// Load Textures (decoded in the background and streamed in over the next frames)
 	const auto noTexture	= shared_ptr<Texture>{};
-	const auto thmTexture	= make_shared<Texture>("../resources/textures/thm2k.png");
-	const auto earthTexture = make_shared<Texture>("../resources/textures/earth_diffuse.jpg");
-	const auto starsTexture = make_shared<Texture>("../resources/textures/cubemap8k.jpg");
+	const auto thmTexture	= TextureRegistry::acquire("../resources/textures/thm2k.png");
+	const auto earthTexture = TextureRegistry::acquire("../resources/textures/earth_diffuse.jpg");
+	const auto starsTexture = TextureRegistry::acquire("../resources/textures/cubemap8k.jpg");
 
 	// Add Default Cube to Scene
 	const auto cube = make_shared<Cube>(
@@ -139,7 +175,7 @@ void Viewport::start() {
 
 
 	// Set up UI afterwards
-	UI::setup(&SceneManager::viewport->at(2), &SceneManager::viewport->at(3));
+	UI::setup(window, &SceneManager::viewport->at(2), &SceneManager::viewport->at(3));
 
 	// Set up graphics
 	clearColor(Colors::BG_COLOR);	// Background color
@@ -160,61 +196,140 @@ void Viewport::start() {
 		Colors::BLACK
 	);
 
-	// Get matrices
-	activeCamera->loadProjectionMatrix(aspect);
-	activeCamera->loadViewMatrix();
-
+	// Get the framebuffer size (it may differ from the window size) and matrices
+	glfwGetFramebufferSize(window, &width, &height);
+	windowResize(width, height);
 
-	// Start rendering the Viewport
-	while (!glfwWindowShouldClose(window)) {
-		render();
 
-		getFPS();
+	// Hand the GL context over to the render thread. From here on, the main thread only handles input,
+	// changes the Scenes and takes a snapshot of them whenever the render thread is ready for the next frame.
+	RenderThread::start(window, [this](const FrameSnapshot& frame) {
+		const double frameStart = glfwGetTime();
 
+		render(frame);
 		glfwSwapBuffers(window);
-		glfwPollEvents();
+
+		getFPS(frameStart);
+	});
+
+	while (!glfwWindowShouldClose(window)) {
+		if (RenderThread::isIdle() && (!onDemandRendering || Redraw::consume())) {
+			RenderThread::submit(captureFrame());
+		}
+
+		if (!RenderThread::isIdle()) {
+			// The render thread wakes this up as soon as it picks up the snapshot
+			glfwWaitEventsTimeout(IDLE_WAIT_TIMEOUT);
+		} else if (onDemandRendering) {
+			// Sleep until input arrives, something requests a redraw or the timeout passes
+			glfwWaitEventsTimeout(Redraw::waitTimeout());
+		} else {
+			glfwPollEvents();
+		}
 	}
+
+	RenderThread::stop();
 }
 
-void Viewport::render() {
-	glfwGetFramebufferSize(window, &width, &height);
+shared_ptr<const FrameSnapshot> Viewport::captureFrame() const {
+	auto frame = make_shared<FrameSnapshot>();
+	frame->width  = width;
+	frame->height = height;
+
+	frame->camera = activeCamera->snapshot();
+	frame->scenes = SceneManager::snapshotScenes();
+
+	frame->selectionRegion		= selectionRegion;
+	frame->drawCoordinateSystem = drawCoordinateSystem;
+	frame->rayStart				= rayStart;
+	frame->rayEnd				= rayEnd;
+
+	#ifdef DEBUG
+		frame->debugText = Debug::collectDebugText();
+	#endif
+
+	return frame;
+}
+
+void Viewport::render(const FrameSnapshot& frame) {
+	const int width  = frame.width;
+	const int height = frame.height;
 
 	glViewport(0, 0, width, height);
-	glGetIntegerv(GL_VIEWPORT, viewport->data());
+
+	// Continue streaming Textures to the GPU and keep them within the VRAM budget
+	TextureLoader::update();
+	TextureRegistry::update();
+
+	// Render the 3D Scenes offscreen at a reduced resolution if the frame time target isn't met
+	renderScale = resolutionScaler.getScale();
+	const bool scaled = sceneTarget && renderScale < RESOLUTION_SCALE_MAX;
+	if (scaled) {
+		sceneTarget->resize(
+			max(1, static_cast<int>(static_cast<float>(width) * renderScale)),
+			max(1, static_cast<int>(static_cast<float>(height) * renderScale))
+		);
+		sceneTarget->bind();
+		glViewport(0, 0, sceneTarget->getWidth(), sceneTarget->getHeight());
+	}
 
 	glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
 	// Render Scenes
-	SceneManager::renderScenes();
+	SceneManager::renderScenes(frame.scenes, frame.camera);
 
 	// Draw the coordinate system
-	if (drawCoordinateSystem) {
+	if (frame.drawCoordinateSystem) {
 		drawAxes();
 		drawGrid();
 	}
 
 	#ifdef DRAW_MOUSE_RAY
-		drawRay(rayStart, rayEnd);
+		drawRay(frame.rayStart, frame.rayEnd);
 	#endif
 
-	// Render UI last
-	UI::render();
+	// Upscale the 3D Scenes to the window resolution
+	if (scaled) {
+		sceneTarget->blitToScreen(width, height);
+		glViewport(0, 0, width, height);
+	}
+
+	frame.selectionRegion.draw(width, height);
+
+	// Render UI last (always at full resolution)
+	UI::render(frame.debugText);
 }
 
 
-void Viewport::getFPS() {
-	if (const double currentTime = glfwGetTime(); currentTime - previousTime >= 1.0) {
+/**
+ * Count frames per second and feed the time spent on the last frame into the dynamic
+ * resolution scaling. Only the time between frameStart and now counts, so time spent
+ * idling in on-demand mode doesn't look like a slow frame.
+ */
+void Viewport::getFPS(const double frameStart) {
+	const double currentTime = glfwGetTime();
+
+	if (currentTime - previousTime >= 1.0) {
 		fps = frameCount;
 		frameCount = 0;
 		previousTime = currentTime;
 	}
 	frameCount++;
+
+	resolutionScaler.addFrameTime((currentTime - frameStart) * 1000.0);
+	frameTime = resolutionScaler.getAverageFrameTime();
 }
 
+/** Main thread only; the render thread picks the new size up with the next snapshot */
 void Viewport::windowResize(const int newW, const int newH) {
-	glViewport(0, 0, width = newW, height = newH);
+	{
+		lock_guard lock(UI::uiMutex);	// The UI is laid out with the viewport size
+		width	  = newW;
+		height	  = newH;
+		*viewport = {0, 0, width, height};
+	}
 	aspect = static_cast<float>(width) / static_cast<float>(height);
-	activeCamera->loadProjectionMatrix(aspect);
+	activeCamera->setAspect(aspect);
 }
 
 /** Centers the application's window to the middle of the screen. */
@@ -227,7 +342,7 @@ void Viewport::centerWindow() const {
 }
 
 void Viewport::setMouseRay(const Vector2& mousePos) const {
-	mouseRay->direction = unproject(mousePos, viewport.get(), activeCamera->viewMatrix, activeCamera->projMatrix).normalize();
+	mouseRay->direction = activeCamera->unproject(mousePos, *viewport).normalize();
 	const auto directionScaled = mouseRay->direction * MOUSE_RAY_LENGTH;
 	rayStart = mouseRay->origin = activeCamera->camPos;
 	rayEnd   = mouseRay->origin + directionScaled;
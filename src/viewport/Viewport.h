@@ -9,6 +9,10 @@
 #include "math/vector/Vector3.h"
 #include "math/ray/Ray.h"
 #include "Camera.h"
+#include "Redraw.h"
+#include "ResolutionScaler.h"
+#include "scene/SelectionRegion.h"
+#include "graphics/framebuffer/Framebuffer.h"
 #include "graphics/ui/UI.h"
 
 #define GLFW_INCLUDE_GLEXT
@@ -19,14 +23,18 @@ using namespace std;
 class Vector2;
 class SceneManager;	// Forward declaration for friend
 
+struct FrameSnapshot;
+
 // Constants
 constexpr int ANTIALIASING_SAMPLES	= 25;
 
 constexpr float AXES_LENGTH			= 100.0f;
 constexpr float MOUSE_RAY_LENGTH	= 1000.0f;
 
-// These really shouldn't be here
+// These really shouldn't be here (render thread only)
 inline int fps = 0;
+inline double frameTime = 0.0;		// Moving average of the frame time in ms
+inline float renderScale = 1.0f;	// Current resolution scale of the 3D Scenes
 
 
 class Viewport {
@@ -35,7 +43,12 @@ public:
 	~Viewport();
 
 	void start();
-	void render();
+
+	/** Copy of everything the next frame shows; main thread only */
+	[[nodiscard]] shared_ptr<const FrameSnapshot> captureFrame() const;
+
+	/** Draw a frame; render thread only */
+	void render(const FrameSnapshot &frame);
 
 	void setCallbacks(GLFWwindow* window);
 	void onKeyboardInput(GLFWwindow* cbWindow, int key, int scancode, int action, int mods);
@@ -46,18 +59,25 @@ private:
 
 	GLFWwindow* window = nullptr;
 	string title;
-	int width, height;
+	int width, height;	// Framebuffer size, as last reported to the main thread
 	float aspect;
 
-	// FPS tracking
+	// FPS tracking (render thread only)
 	double previousTime = 0.0;
 	int frameCount		= 0;
 
+	bool onDemandRendering = ON_DEMAND_RENDERING;	// Block until something changes instead of rendering continuously
+
+	// Dynamic resolution scaling (render thread only)
+	ResolutionScaler resolutionScaler;
+	unique_ptr<Framebuffer> sceneTarget;
+
 	// Mouse data
 	//Vector2 lastMousePos	 = Vector2(0.0, 0.0);
 	mutable Vector3 rayStart = Vector3::MINUS_ONE;
 	mutable Vector3 rayEnd   = Vector3::ONE;
 	shared_ptr<Ray> mouseRay;
+	SelectionRegion selectionRegion;	// Rectangle or lasso while the left mouse button is held
 
 	bool drawCoordinateSystem = true;
 
@@ -71,5 +91,5 @@ private:
 	static void drawAxes();
 	static void drawGrid();
 
-	void getFPS();
+	void getFPS(double frameStart);
 };
@@ -5,61 +5,83 @@
 #include "graphics/MeshRenderer.h"
 #include "graphics/ui/UISceneManager.h"
 #include "viewport/Camera.h"
+#include "viewport/Redraw.h"
 #include "viewport/scene/SceneManager.h"
 #include "objects/light/Light.h"
 
 
 void Scene::addObject(const shared_ptr<Object>& obj) {
 	sceneObjects.emplace_back(obj);
+	SceneManager::onObjectAdded(*this, obj);
 	UISceneManager::update();
+	Redraw::request();
 }
 
 void Scene::removeObject(const shared_ptr<Object>& obj) {
 	sceneObjects.erase(ranges::find(sceneObjects, obj));
+	SceneManager::onObjectRemoved(*obj);
 	UISceneManager::update();
+	Redraw::request();
 }
 
 
-void Scene::render() const {
-	if (fixedPosition) {
-		// Load view matrix for background
-		SceneManager::activeCamera->loadFixedViewMatrix();
-	} else {
-		// Load view matrix for foreground
-		SceneManager::activeCamera->loadViewMatrix();
-	}
+SceneSnapshot Scene::snapshot() const {
+	SceneSnapshot snapshot;
+	snapshot.depthIsolation = depthIsolation;
+	snapshot.fixedPosition	= fixedPosition;
 
-	// Enable lighting
-	glEnable(GL_LIGHTING);
 	for (const auto& light : lights) {
-		glEnable(light->macro);
-		glLightfv(light->macro, GL_POSITION, light->pos.data());
-		glLightfv(light->macro, GL_AMBIENT, light->ambient);
-		glLightfv(light->macro, GL_DIFFUSE, light->diffuse);
-		glLightfv(light->macro, GL_SPECULAR, light->specular);
+		snapshot.lights.push_back({
+			light->macro,
+			light->pos,
+			{light->ambient[0], light->ambient[1], light->ambient[2], 1.0f},
+			{light->diffuse[0], light->diffuse[1], light->diffuse[2], 1.0f},
+			{light->specular[0], light->specular[1], light->specular[2], 1.0f}
+		});
 	}
 
 	const auto& sceneMeshes = filterMeshes(sceneObjects);
 	const auto selectionMode = SceneManager::selectionMode;
-	const auto camPos = SceneManager::activeCamera->camPos;
 
-	// Loop through the sceneObjects and render Mesh instances
+	snapshot.meshes.reserve(sceneMeshes.size());
 	for (const auto& mesh : sceneMeshes) {
-		MeshRenderer::render(*mesh, selectionMode, SceneManager::isMeshSelected(mesh));
+		snapshot.meshes.emplace_back(MeshSnapshot::capture(*mesh, SceneManager::isMeshSelected(mesh), selectionMode));
+	}
+	return snapshot;
+}
+
+void Scene::render(const SceneSnapshot& scene, const CameraSnapshot& camera) {
+	// Load view matrix for the background (without the camera position) or the foreground
+	glMatrixMode(GL_MODELVIEW);
+	glLoadMatrixf(scene.fixedPosition ? camera.fixedViewMatrix.data() : camera.viewMatrix.data());
+
+	// Enable lighting
+	glEnable(GL_LIGHTING);
+	for (const auto& light : scene.lights) {
+		glEnable(light.macro);
+		glLightfv(light.macro, GL_POSITION, light.pos.data());
+		glLightfv(light.macro, GL_AMBIENT, light.ambient.data());
+		glLightfv(light.macro, GL_DIFFUSE, light.diffuse.data());
+		glLightfv(light.macro, GL_SPECULAR, light.specular.data());
+	}
+
+	// Loop through the Mesh snapshots and render them
+	for (const auto& mesh : scene.meshes) {
+		MeshRenderer::render(mesh);
 	}
 
 	// Disable lighting for outline rendering
-	for (const auto& light : lights) {
-		glDisable(light->macro);
+	for (const auto& light : scene.lights) {
+		glDisable(light.macro);
 	}
 	glDisable(GL_LIGHTING);
 
-	// Loop through the sceneObjects and render Mesh outlines
-	for (const auto& mesh : sceneMeshes) {
-		MeshRenderer::renderSilhouette(*mesh, selectionMode, camPos, SceneManager::isMeshSelected(mesh));
+	// Loop through the Mesh snapshots and render their outlines
+	for (const auto& mesh : scene.meshes) {
+		MeshRenderer::renderSilhouette(mesh, camera.camPos);
 	}
 
-	if (depthIsolation) {
+	if (scene.depthIsolation) {
 		glClear(GL_DEPTH_BUFFER_BIT);
 	}
 }
@@ -91,6 +113,7 @@ void Scene::addLight(
 	lights.emplace_back(light);
 
 	UISceneManager::update();
+	Redraw::request();
 }
 
 void Scene::enableDepthIsolation() {
@@ -6,6 +6,8 @@ using namespace std;
 #include <string>
 #include <memory>
 
+#include "SceneSnapshot.h"
+
 class Color;
 class Ray;
 class Object;
@@ -13,6 +15,7 @@ class Mesh;
 class Light;
 
 struct Vertex;
+struct CameraSnapshot;
 
 
 class Scene final {
@@ -23,7 +26,11 @@ public:
 	explicit Scene(string name) : name(move(name)) {}
 	~Scene() = default;
 
-	void render() const;
+	/** Copy of what render() draws; main thread only */
+	[[nodiscard]] SceneSnapshot snapshot() const;
+
+	/** Draw a snapshot; render thread only */
+	static void render(const SceneSnapshot &scene, const CameraSnapshot &camera);
 
 	void addObject(const shared_ptr<Object>& obj);
 	void removeObject(const shared_ptr<Object>& obj);
@@ -39,6 +46,7 @@ private:
 	friend class Debug;
 	friend class SceneManager;
 	friend class UISceneManager;
+	friend class SceneBench;
 
 	// Objects
 	vector<shared_ptr<Object>> sceneObjects;	// Scene Objects (as shared pointers to prevent object slicing)
@@ -1,19 +1,30 @@
 #include "SceneManager.h"
 
 #include <iostream>
+#include <unordered_map>
 
 #include "Scene.h"
 #include "viewport/Camera.h"
+#include "viewport/Redraw.h"
+#include "viewport/RenderThread.h"
+#include "jobs/JobSystem.h"
+#include "math/bounds/Frustum.h"
 #include "objects/mesh/skybox/Skybox.cpp"
 
 // Constants
 constexpr float SCALING_SENS		= 0.001;	// Scaling sensitivity
 constexpr float ROTATION_SENS		= 10.0f;	// Rotation sensitivity
 constexpr float SELECT_TOLERANCE	= 20.0f;	// Tolerance in pixel distance for mouse picking
+constexpr float MERGE_DISTANCE		= 0.001f;	// Selected Vertices closer than this are merged
+constexpr float SNAP_RADIUS			= 0.05f;	// Snapping reach while grabbing, relative to the camera distance
+constexpr bool GPU_PICKING			= true;		// Pick through the PickingBuffer if available (respects occlusion)
 
 inline bool depthIsolation			= false;
 inline bool fixedPosition			= false;
 inline Vector3 lastTransform		= Vector3::ZERO;
+inline unordered_map<const Object*, Vector3> grabPositions;	// Where the grabbed Meshes would be without snapping
+inline vector<shared_ptr<Mesh>> snapTargets;				// Pickable Meshes that aren't selected
+inline bool snapTargetsOutdated		= true;
 
 
 // Pointers from Viewport
@@ -23,7 +34,18 @@ shared_ptr<Ray> SceneManager::mouseRay				= nullptr;
 
 // Scene Management
 vector<shared_ptr<Scene>> SceneManager::scenes				= vector<shared_ptr<Scene>>();
-vector<shared_ptr<Object>> SceneManager::selectedObjects	= vector<shared_ptr<Object>>();
+SelectionManager SceneManager::selection;
+SceneBVH SceneManager::sceneBVH;
+unique_ptr<PickingBuffer> SceneManager::pickingBuffer = nullptr;
+ScreenVertexGrid SceneManager::vertexGrid;
+SnapIndex SceneManager::snapIndex;
+bool SceneManager::selectVisibleOnly = false;
+
+// Everything derived from the selection follows its changes: the snapping targets and the frame on screen
+static const int selectionListener = SceneManager::selection.addListener([] {
+	snapTargetsOutdated = true;
+	Redraw::request();
+});
 
 // Modes
 Mode SceneManager::selectionMode = OBJECT;
@@ -36,9 +58,15 @@ double* SceneManager::mouseY = new double[1];
 
 void SceneManager::addScene(const shared_ptr<Scene>& scene) {
 	scenes.emplace_back(scene);
+	for (const auto& obj : scene->sceneObjects) {
+		onObjectAdded(*scene, obj);
+	}
 }
 
 void SceneManager::deleteScene(const shared_ptr<Scene>& scene) {
+	for (const auto& obj : scene->sceneObjects) {
+		onObjectRemoved(*obj);
+	}
 	scenes.erase(
 		ranges::remove_if(scenes,
             [&scene](const weak_ptr<Scene>& weakScene) {
@@ -65,7 +93,7 @@ void SceneManager::cleanupScenes() {
 void SceneManager::toggleSelectionMode() {
 	if (selectionMode == OBJECT) {
 		// Don't change mode if no Object is selected
-		if (!selectedObjects.empty()) {
+		if (!selection.isEmpty()) {
 			selectionMode = EDIT;
 		}
 	} else if (selectionMode == EDIT) {
@@ -75,8 +103,16 @@ void SceneManager::toggleSelectionMode() {
 
 void SceneManager::setTransformMode(const Mode& mode) {
 	// Don't change mode if no Object is selected
-	if (selectedObjects.empty()) return;
+	if (selection.isEmpty()) return;
+
+	// Merging happens at once instead of following the mouse
+	if (mode.mode == Mode::MERGE) {
+		if (selectionMode == EDIT) mergeVertices();
+		return;
+	}
+
 	transformMode = mode;
+	grabPositions.clear();
 
 	// Reset transformation direction
 	transformMode.subMode = SubMode::NONE;
@@ -84,14 +120,14 @@ void SceneManager::setTransformMode(const Mode& mode) {
 
 void SceneManager::setTransformSubMode(const SubMode& subMode) {
 	// Don't change mode if no Object is selected
-	if (selectedObjects.empty() || transformMode.type != ModeType::TRANSFORM) return;
+	if (selection.isEmpty() || transformMode.type != ModeType::TRANSFORM) return;
 
 	// Set transformation direction
 	transformMode.subMode = subMode;
 }
 
 void SceneManager::toggleShadingMode() {
-	if (const auto meshes = getSelectedMeshes(); !meshes.empty()) {
+	if (const auto& meshes = getSelectedMeshes(); !meshes.empty()) {
 		for (const auto& mesh : meshes) {
 			mesh->setShadingMode(mesh->shadingMode == ShadingMode::SMOOTH
 				? ShadingMode::FLAT
@@ -101,26 +137,61 @@ void SceneManager::toggleShadingMode() {
 }
 
 Vector3 SceneManager::mouseWorld() {
-	return unproject(
-		Vector2(*mouseX, *mouseY),
-		viewport.get(),
-		activeCamera->viewMatrix,
-		activeCamera->projMatrix
-	);
+	return activeCamera->unproject(Vector2(*mouseX, *mouseY), *viewport);
 }
 
 
 // Scene rendering
 
-void SceneManager::renderScenes() {
+vector<SceneSnapshot> SceneManager::snapshotScenes() {
+	vector<SceneSnapshot> sceneSnapshots;
+	sceneSnapshots.reserve(scenes.size());
 	for (const auto& scene : scenes) {
-		scene->render(); // Call the render method on the scene
+		sceneSnapshots.emplace_back(scene->snapshot());
+	}
+	return sceneSnapshots;
+}
+
+void SceneManager::renderScenes(const vector<SceneSnapshot>& sceneSnapshots, const CameraSnapshot& camera) {
+	glMatrixMode(GL_PROJECTION);
+	glLoadMatrixf(camera.projMatrix.data());
+
+	for (const auto& scene : sceneSnapshots) {
+		Scene::render(scene, camera); // Call the render method on the scene
 	}
 }
 
 
 // Object and Vertex operations that apply across all Scenes, e.g. selection
 
+SceneHit SceneManager::pick(const Ray& ray) {
+	sceneBVH.update();
+	return sceneBVH.intersect(ray);
+}
+
+/** Meshes of all Scenes that can be selected (and occlude each other when picking), kept by sceneBVH */
+const vector<shared_ptr<Mesh>>& SceneManager::getPickableMeshes() {
+	return sceneBVH.getMeshes();
+}
+
+/** Track obj for picking if it's a selectable Mesh in one of the Scenes; called once per added Object */
+void SceneManager::onObjectAdded(const Scene& scene, const shared_ptr<Object>& obj) {
+	if (ranges::none_of(scenes, [&scene](const auto& s) { return s.get() == &scene; })) return;
+
+	// TODO Implement selection logic for Objects that aren't Meshes (e.g. Cameras, light sources, etc.)
+	const auto mesh = dynamic_pointer_cast<Mesh>(obj);
+	if (mesh && !mesh->triangles.empty() && !dynamic_cast<const Skybox*>(mesh.get())) {
+		sceneBVH.add(mesh);
+		snapTargetsOutdated = true;
+	}
+}
+
+void SceneManager::onObjectRemoved(const Object& obj) {
+	if (const auto mesh = dynamic_cast<const Mesh*>(&obj); mesh && sceneBVH.remove(*mesh)) {
+		snapTargetsOutdated = true;
+	}
+}
+
 /**
  * Handles the selection of Objects in the scene based on the current mouse position.
  *
@@ -136,123 +207,227 @@ void SceneManager::select(const Vector2& mousePos, const bool preserve) {
 
     // If in Object Mode, select entire Objects
     if (selectionMode == OBJECT) {
-        // Find Objects that intersect with the mouse Ray
-        vector<shared_ptr<Object>> intersectingObjects;
-    	for (const auto& scene : scenes) {
-    		for (const auto& obj : scene.get()->sceneObjects) {
-    			// Attempt to cast Object to Mesh
-    			if (const auto mesh = dynamic_cast<const Mesh*>(obj.get())) {
-    				if (!dynamic_cast<const Skybox*>(obj.get())) {
-    					if (ray->intersects(*mesh)) {
-							intersectingObjects.emplace_back(obj);
-						}
-    				}
-    			} else {
-    				// TODO Implement selection logic for Objects that aren't Meshes (e.g. Cameras, light sources, etc.)
-    			}
-    		}
-    	}
-
-
-        // Select the Object that's closest to the Ray origin (the camera)
-        if (!intersectingObjects.empty()) {
-            selectObject(
-                *ranges::min_element(
-                    intersectingObjects,
-                    [&ray](const shared_ptr<Object>& a, const shared_ptr<Object>& b) {
-                        return a->position.distance(ray->origin) < b->position.distance(ray->origin);
-                    }
-                )
-            );
+        shared_ptr<Mesh> picked;
+        if (GPU_PICKING && pickingBuffer) {
+            const auto& pickable = getPickableMeshes();
+            if (const auto result = RenderThread::invoke([&] {
+                    return pickingBuffer->pick(
+                        pickable, {}, PickTarget::OBJECT,
+                        static_cast<int>(mousePos.x), static_cast<int>(mousePos.y), 0,
+                        *viewport, activeCamera->viewMatrix, activeCamera->projMatrix
+                    );
+                })) {
+                picked = pickable[result->mesh];
+            }
+        } else {
+            // Select the Object that's actually under the cursor (the closest hit along the Ray)
+            picked = pick(*ray).mesh;
+        }
+
+        if (picked) {
+            selectObject(picked);
         } else if (!preserve) {
             deselectAllObjects();
         }
     }
 
     // If in Edit Mode, select specific Vertices
+    else if (selectionMode == EDIT && GPU_PICKING && pickingBuffer) {
+        // Only Vertices that are visible (not hidden behind any Mesh) can be picked
+        const auto& meshes = getSelectedMeshes();
+        const auto& occluders = getPickableMeshes();
+        if (const auto result = RenderThread::invoke([&] {
+                return pickingBuffer->pick(
+                    meshes, occluders, PickTarget::VERTEX,
+                    static_cast<int>(mousePos.x), static_cast<int>(mousePos.y), static_cast<int>(SELECT_TOLERANCE),
+                    *viewport, activeCamera->viewMatrix, activeCamera->projMatrix
+                );
+            })) {
+            selectVertex(meshes[result->mesh], result->element);
+        } else if (!preserve) {
+            deselectAllVertices();
+        }
+    }
+
+    // Edit Mode without GPU picking
     else if (selectionMode == EDIT) {
-        // Find Vertices that intersect with the mouse Ray
-        vector<shared_ptr<Vertex>> intersectingVertices;
-        for (const auto& mesh : getSelectedMeshes()) {
-            for (const auto& v : mesh->vertices) {
-                if (Ray::intersects(project(
-                        v->position,
-                        viewport.get(),
-                        activeCamera->viewMatrix,
-                        activeCamera->projMatrix
-                    ), mousePos, SELECT_TOLERANCE)) {
-                    intersectingVertices.push_back(v);
+        // Find the Vertex within the tolerance that's closest to the camera
+        const auto& meshes = getSelectedMeshes();
+        vertexGrid.update(meshes, *viewport, activeCamera->viewMatrix, activeCamera->projMatrix);
+
+        if (const auto hit = vertexGrid.pick(mousePos, SELECT_TOLERANCE)) {
+            selectVertex(meshes[hit->mesh], hit->vertex);
+        } else if (!preserve) {
+            deselectAllVertices();
+        }
+    }
+
+    // When transforming a Mesh, clicking applies the transformation
+    applyTransformation();
+}
+
+/**
+ * Replace the selection with everything inside a rectangle or lasso.
+ *
+ * In Object Mode, the bounds of every Mesh are first tested against the frustum through the bounding
+ * rectangle of the region. Meshes entirely inside a rectangular region are selected right away; for the
+ * rest, the projected Vertices decide. In Edit Mode, the cached projection of the Vertices of the
+ * selected Meshes is tested directly.
+ *
+ * With selectVisibleOnly, the PickingBuffer decides instead, so hidden Objects and Vertices are skipped.
+ */
+void SceneManager::selectRegion(const SelectionRegion& region) {
+    const auto min = region.getMin();
+    const auto max = region.getMax();
+    const bool visibleOnly = selectVisibleOnly && GPU_PICKING && pickingBuffer;
+
+    const auto inside = [&region](const int x, const int y) {
+        return region.contains(static_cast<float>(x) + 0.5f, static_cast<float>(y) + 0.5f);
+    };
+    const auto pickRegion = [&](const vector<shared_ptr<Mesh>>& targets, const PickTarget target) {
+        const auto& occluders = getPickableMeshes();
+        return RenderThread::invoke([&] {
+            return pickingBuffer->pickRegion(
+                targets, occluders, target,
+                static_cast<int>(min.x), static_cast<int>(min.y), static_cast<int>(max.x), static_cast<int>(max.y),
+                inside, *viewport, activeCamera->viewMatrix, activeCamera->projMatrix
+            );
+        });
+    };
+
+    if (selectionMode == OBJECT) {
+        const auto& pickable = getPickableMeshes();
+        vector<bool> selected(pickable.size(), false);
+
+        if (visibleOnly) {
+            for (const auto& result : pickRegion(pickable, PickTarget::OBJECT)) {
+                selected[result.mesh] = true;
+            }
+        } else {
+            const auto corner = [](const double x, const double y) {
+                return activeCamera->unproject(Vector2(x, y), *viewport);
+            };
+            const auto frustum = Frustum::fromCorners(activeCamera->camPos, {
+                corner(min.x, min.y), corner(max.x, min.y), corner(max.x, max.y), corner(min.x, max.y)
+            });
+
+            // Cull on all threads; every Mesh only updates its own cached bounds
+            vector<Containment> containments(pickable.size());
+            JobSystem::parallelFor(pickable.size(), SCENE_PARALLEL_THRESHOLD, [&](const size_t begin, const size_t end) {
+                for (size_t i = begin; i < end; i++) {
+                    containments[i] = frustum.classify(pickable[i]->getWorldBounds());
                 }
+            });
+
+            vector<shared_ptr<Mesh>> candidates;
+            vector<size_t> candidateIndices;
+            for (size_t i = 0; i < pickable.size(); i++) {
+                const auto containment = containments[i];
+                if (containment == Containment::OUTSIDE) continue;
+                if (containment == Containment::INSIDE && region.getShape() == RegionShape::RECTANGLE) {
+                    selected[i] = true;
+                    continue;
+                }
+                candidates.emplace_back(pickable[i]);
+                candidateIndices.emplace_back(i);
             }
 
-            // Select the Vertex that's closest to the Ray origin (the camera)
-            if (!intersectingVertices.empty()) {
-            	selectVertex(
-	                *ranges::min_element(
-		                intersectingVertices,
-		                [&ray](const shared_ptr<Vertex>& a, const shared_ptr<Vertex>& b) {
-			                return a->position.distance(ray->origin) < b->position.distance(ray->origin);
-		                }
-	                )
-                );
-            } else if (!preserve) {
-                deselectAllVertices();
+            ScreenVertexGrid candidateGrid;
+            candidateGrid.update(candidates, *viewport, activeCamera->viewMatrix, activeCamera->projMatrix);
+            for (const auto& hit : candidateGrid.query(region)) {
+                selected[candidateIndices[hit.mesh]] = true;
             }
         }
+
+        vector<shared_ptr<Object>> objects;
+        for (size_t i = 0; i < pickable.size(); i++) {
+            if (selected[i]) objects.emplace_back(pickable[i]);
+        }
+        selection.assign(objects);
     }
 
-    // When transforming a Mesh, clicking applies the transformation
-    applyTransformation();
+    else if (selectionMode == EDIT) {
+        const auto& meshes = getSelectedMeshes();
+        deselectAllVertices();
+
+        if (visibleOnly) {
+            for (const auto& result : pickRegion(meshes, PickTarget::VERTEX)) {
+                meshes[result.mesh]->getSelection().select(result.element);
+            }
+        } else {
+            vertexGrid.update(meshes, *viewport, activeCamera->viewMatrix, activeCamera->projMatrix);
+            for (const auto& hit : vertexGrid.query(region)) {
+                meshes[hit.mesh]->getSelection().select(hit.vertex);
+            }
+        }
+    }
 }
 
 bool SceneManager::isMeshSelected(const shared_ptr<Mesh>& mesh) {
-	return ranges::any_of(getSelectedMeshes(), [&mesh](const shared_ptr<Mesh>& element) {
-		return *element == *mesh;
-	});
+	return selection.contains(*mesh);
 }
 
-vector<shared_ptr<Mesh>> SceneManager::getSelectedMeshes() {
-	return filterMeshes(selectedObjects);
+const vector<shared_ptr<Mesh>>& SceneManager::getSelectedMeshes() {
+	return selection.getMeshes();
 }
 
 
 void SceneManager::selectAllObjects(const vector<shared_ptr<Object>>& sceneObjects) {
 	for (const auto& obj : sceneObjects) {
-		selectedObjects.emplace_back(obj);
+		selection.add(obj);
 	}
 }
 
 void SceneManager::deselectAllObjects() {
-	selectedObjects.clear();
+	selection.clear();
 }
 
 void SceneManager::selectAllVertices(const shared_ptr<Mesh>& mesh) {
-	for (const auto& v : mesh->vertices) {
-		v->isSelected = true;
-	}
+	mesh->getSelection().selectAll();
 }
 
 void SceneManager::deselectAllVertices() {
 	for (const auto& mesh : getSelectedMeshes()) {
-		for (const auto& v : mesh->vertices) {
-			v->isSelected = false;
-		}
+		mesh->getSelection().deselectAll();
 	}
 }
 
-void SceneManager::selectObject(const shared_ptr<Object>& obj) {
-	// Check if the object is already selected
-	if (ranges::find(selectedObjects, obj) == selectedObjects.end()) {
-		// Add the object to selectedObjects and stop searching
-		selectedObjects.emplace_back(obj);
+/** Select every Vertex of the selected Meshes, or deselect them all if any is selected already */
+void SceneManager::toggleAllVertices() {
+	const auto& meshes = getSelectedMeshes();
+	if (ranges::any_of(meshes, [](const shared_ptr<Mesh>& mesh) { return !mesh->getSelection().isEmpty(); })) {
+		deselectAllVertices();
 	} else {
-		// If the object is already selected, deselect it
-		deselectObject(obj);
+		for (const auto& mesh : meshes) selectAllVertices(mesh);
 	}
 }
 
+void SceneManager::invertVertexSelection() {
+	for (const auto& mesh : getSelectedMeshes()) {
+		mesh->getSelection().invert();
+	}
+}
+
+void SceneManager::growVertexSelection() {
+	for (const auto& mesh : getSelectedMeshes()) {
+		mesh->getSelection().grow();
+	}
+}
+
+void SceneManager::shrinkVertexSelection() {
+	for (const auto& mesh : getSelectedMeshes()) {
+		mesh->getSelection().shrink();
+	}
+}
+
+void SceneManager::selectObject(const shared_ptr<Object>& obj) {
+	// Deselect the object if it's already selected, otherwise select it
+	selection.toggle(obj);
+}
+
 void SceneManager::selectObject(const string& label) {
 	// Check if the object is already selected
+	const auto& selectedObjects = selection.getObjects();
 	const auto it = ranges::find_if(selectedObjects, [&label](const auto& obj) {
 		return obj->name == label;
 	});
@@ -265,8 +440,8 @@ void SceneManager::selectObject(const string& label) {
 			});
 
 			if (objIt != scene->sceneObjects.end()) {
-				// Add the object to selectedObjects and stop searching
-				selectedObjects.emplace_back(*objIt);
+				// Add the object to the selection and stop searching
+				selection.add(*objIt);
 				return;
 			}
 		}
@@ -277,13 +452,11 @@ void SceneManager::selectObject(const string& label) {
 }
 
 void SceneManager::deselectObject(const shared_ptr<Object>& obj) {
-	if (const auto it = ranges::find(selectedObjects, obj); it != selectedObjects.end()) {
-		selectedObjects.erase(it);
-	}
+	selection.remove(*obj);
 }
 
-void SceneManager::selectVertex(const shared_ptr<Vertex>& v) {
-	v->isSelected = !v->isSelected;
+void SceneManager::selectVertex(const shared_ptr<Mesh>& mesh, const int vertex) {
+	mesh->getSelection().toggle(vertex);
 }
 
 
@@ -294,7 +467,8 @@ void SceneManager::transform(
 	const double mouseX,
 	const double mouseY,
 	const Vector3 worldPos,
-	const Vector3 camPos
+	const Vector3 camPos,
+	const bool snap
 ) {
     if (getSelectedMeshes().empty()) return;	// TODO Implement transformation for Objects that aren't Meshes
 
@@ -306,63 +480,103 @@ void SceneManager::transform(
 	if (lastTransform == Vector3::ZERO) lastTransform = worldPos;
 	const auto dPos = worldPos - lastTransform;
 
+	if (transformMode.mode == Mode::GRAB) {
+		grab(direction, dPos, camPos, snap);
+		lastTransform = worldPos;
+		return;
+	}
+
 	for (const auto& mesh : getSelectedMeshes()) {
-		const auto camDist = mesh->position.distance(camPos); // Distance from Object to camera
+		const auto camDist = mesh->transform.position.distance(camPos); // Distance from Object to camera
 
 		const auto mouseDist = static_cast<float>(	// Distance from Object to mouse
-			 project(mesh->position, viewport.get(), activeCamera->viewMatrix, activeCamera->projMatrix)
+			 project(mesh->transform.position, viewport.get(), activeCamera->viewMatrix, activeCamera->projMatrix)
 			.distance(Vector2(mouseX, mouseY))
 		);
 
 		switch (transformMode.mode) {
-			case Mode::GRAB: {
-				const Matrix4 transform = Matrix4::translate(
-					direction * camDist	// Clamp direction
-					* dPos				// Difference from last transform
-				);
-				mesh->applyTransformation(transformMode, transformMode, transform);
-				break;
-			}
 			case Mode::SCALE: {
 				const float scaleFactor = camDist * mouseDist * SCALING_SENS;
 				// Clamp direction
 				const auto scaleVector = Vector3(
-					direction.x != 0 ? scaleFactor : mesh->scale.x,
-					direction.y != 0 ? scaleFactor : mesh->scale.y,
-					direction.z != 0 ? scaleFactor : mesh->scale.z
+					direction.x != 0 ? scaleFactor : mesh->transform.scale.x,
+					direction.y != 0 ? scaleFactor : mesh->transform.scale.y,
+					direction.z != 0 ? scaleFactor : mesh->transform.scale.z
 				);
 				const Matrix4 transform	= Matrix4::scale(
 					  scaleVector
-					/ mesh->scale		// Difference from last transform
+					/ mesh->transform.scale		// Difference from last transform
 				);
 				mesh->applyTransformation(transformMode, transformMode, transform);
 				break;
 			}
 			case Mode::ROTATE: {
-				// Calculate rotation angle based on mouse drag distance
+				// Calculate rotation angle based on mouse drag distance, about the clamped axes only
 				const float angle = dPos.length() * ROTATION_SENS;
-
-				// Create rotation matrix
-				Matrix4 rotation =
-					  Matrix4::rotateX(angle * direction.x)
-					* Matrix4::rotateY(angle * direction.y)
-					* Matrix4::rotateZ(angle * direction.z);
-
-				// Apply rotation
-				mesh->applyTransformation(transformMode, transformMode, rotation);
+				mesh->rotate(Quaternion::fromEuler(direction * angle));
 				break;
 			}
 			default: throw invalid_argument("Invalid transformation: Wrong Mode");
 		}
+		sceneBVH.markMoved(*mesh);
 	}
 
 	// Update lastTransform for next frame
 	lastTransform = worldPos;
 }
 
+/**
+ * Move the selected Meshes with the mouse. Their unsnapped positions are tracked separately,
+ * so with snap the first Mesh's origin jumps to the nearest Vertex of the other Meshes in reach
+ * (the others keep their offsets to it), and releasing snap lets them follow the mouse again.
+ */
+void SceneManager::grab(const Vector3& direction, const Vector3& dPos, const Vector3& camPos, const bool snap) {
+	const auto& meshes = getSelectedMeshes();
+
+	for (const auto& mesh : meshes) {
+		auto& free = grabPositions.try_emplace(mesh.get(), mesh->transform.position).first->second;
+		free = free
+			+ direction * mesh->transform.position.distance(camPos)	// Clamp direction
+			* dPos;											// Difference from last transform
+	}
+
+	Vector3 offset = Vector3::ZERO;
+	if (snap) {
+		// Unselected Meshes don't move while grabbing, so the index only changes with the selection or the Scenes
+		if (snapTargetsOutdated) {
+			snapTargets.clear();
+			for (const auto& mesh : getPickableMeshes()) {
+				if (!isMeshSelected(mesh)) snapTargets.emplace_back(mesh);
+			}
+			snapIndex.update(snapTargets);
+			snapTargetsOutdated = false;
+		}
+
+		const auto& anchor = grabPositions[meshes.front().get()];
+		if (const auto hit = snapIndex.nearest(anchor, SNAP_RADIUS * anchor.distance(camPos))) {
+			offset = (hit->position - anchor) * direction;
+		}
+	}
+
+	for (const auto& mesh : meshes) {
+		const auto transform = Matrix4::translate(grabPositions[mesh.get()] + offset - mesh->transform.position);
+		mesh->applyTransformation(transformMode, transformMode, transform);
+		sceneBVH.markMoved(*mesh);
+	}
+}
+
+/** Merge the selected Vertices of every selected Mesh by distance */
+void SceneManager::mergeVertices() {
+	for (const auto& mesh : getSelectedMeshes()) {
+		mesh->mergeByDistance(MERGE_DISTANCE);
+		sceneBVH.markMoved(*mesh);
+	}
+}
+
 void SceneManager::applyTransformation() {
 	if (transformMode != NONE) {
 		lastTransform			= Vector3::ZERO;	// Reset transformation data
+		grabPositions.clear();
 		transformMode			= NONE;				// Go back to View Mode
 		transformMode.subMode	= SubMode::NONE;	// Reset transformation direction
 	}
@@ -7,6 +7,13 @@ using namespace std;
 #include <vector>
 
 #include "Mode.h"
+#include "ScreenVertexGrid.h"
+#include "SelectionManager.h"
+#include "SceneSnapshot.h"
+#include "SelectionRegion.h"
+#include "SnapIndex.h"
+#include "graphics/framebuffer/PickingBuffer.h"
+#include "math/bvh/SceneBVH.h"
 
 class Scene;
 class Camera;
@@ -17,6 +24,7 @@ class Vector2;
 class Vector3;
 
 struct Vertex;
+struct CameraSnapshot;
 
 
 class SceneManager {
@@ -34,7 +42,14 @@ public:
 	static Mode selectionMode;
 	static Mode transformMode;
 
-	static vector<shared_ptr<Object>> selectedObjects;
+	static SelectionManager selection;					// Selected Objects, in selection order
+
+	static SceneBVH sceneBVH;							// Picking acceleration structure over the pickable Meshes of all Scenes, updated lazily by pick()
+	static unique_ptr<PickingBuffer> pickingBuffer;		// GPU ID buffer for occlusion-aware picking (null if unsupported); used through RenderThread::invoke()
+	static ScreenVertexGrid vertexGrid;					// Projected Vertices of the selected Meshes, updated lazily
+	static SnapIndex snapIndex;							// Vertices of the unselected Meshes, for snapping while grabbing
+
+	static bool selectVisibleOnly;						// Region selection skips occluded Objects and Vertices
 
 private:
 	friend class Viewport;
@@ -42,38 +57,61 @@ private:
 	friend class UI;
 	friend class UISceneManager;
 	friend class Debug;
+	friend class SceneBench;
 
 	// General
 	static void addScene(const shared_ptr<Scene> &scene);
 	static void deleteScene(const shared_ptr<Scene> &scene);
 	static void cleanupScenes();
-	static void renderScenes();
+
+	/** Keep the pickable Meshes in sceneBVH in sync with the Scenes; called by Scene */
+	static void onObjectAdded(const Scene &scene, const shared_ptr<Object> &obj);
+	static void onObjectRemoved(const Object &obj);
+
+	/** Copy of all Scenes, taken on the main thread */
+	[[nodiscard]] static vector<SceneSnapshot> snapshotScenes();
+
+	/** Draw the snapshots with the thread owning the GL context */
+	static void renderScenes(const vector<SceneSnapshot> &sceneSnapshots, const CameraSnapshot &camera);
 
 	// Selection
 	static void select(const Vector2 &mousePos, bool preserve);
+	static void selectRegion(const SelectionRegion &region);
+
+	/** Closest pickable Mesh hit by the ray, through the scene-level BVH */
+	[[nodiscard]] static SceneHit pick(const Ray &ray);
+	[[nodiscard]] static const vector<shared_ptr<Mesh>>& getPickableMeshes();
 
 	static void selectAllObjects(const vector<shared_ptr<Object>> &sceneObjects);
 	static void deselectAllObjects();
 	static void selectAllVertices(const shared_ptr<Mesh>& mesh);
 	static void deselectAllVertices();
+	static void toggleAllVertices();
+	static void invertVertexSelection();
+	static void growVertexSelection();
+	static void shrinkVertexSelection();
 
 	static void selectObject(const shared_ptr<Object>& obj);
 	static void selectObject(const string &label);
 	static void deselectObject(const shared_ptr<Object> &obj);
-	static void selectVertex(const shared_ptr<Vertex> &v);
+	static void selectVertex(const shared_ptr<Mesh> &mesh, int vertex);
 
 	static void toggleSelectionMode();
 
 	[[nodiscard]] static bool isMeshSelected(const shared_ptr<Mesh> &mesh);
-	[[nodiscard]] static vector<shared_ptr<Mesh>> getSelectedMeshes();
+	[[nodiscard]] static const vector<shared_ptr<Mesh>>& getSelectedMeshes();
 
 	// Transformation
 	static void setTransformMode(const Mode& mode);
 	static void setTransformSubMode(const SubMode& subMode);
 
-	static void transform(double mouseX, double mouseY, Vector3 worldPos, Vector3 camPos);
+	static void transform(double mouseX, double mouseY, Vector3 worldPos, Vector3 camPos, bool snap);
+	static void grab(const Vector3 &direction, const Vector3 &dPos, const Vector3 &camPos, bool snap);
 	static void applyTransformation();
 
+	// Mesh operations
+	static void mergeVertices();
+
 	// Other
 	[[nodiscard]] static Vector3 mouseWorld();
 
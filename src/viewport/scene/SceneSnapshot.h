@@ -0,0 +1,27 @@
+#pragma once
+
+using namespace std;
+
+#include <array>
+#include <vector>
+
+#include "graphics/MeshSnapshot.h"
+
+
+/** GL light parameters of a Light */
+struct LightSnapshot {
+	int macro = 0;
+	array<float, 4> pos{};
+	array<float, 4> ambient{};
+	array<float, 4> diffuse{};
+	array<float, 4> specular{};
+};
+
+/** Everything Scene::render() draws, taken on the main thread by Scene::snapshot() */
+struct SceneSnapshot {
+	vector<LightSnapshot> lights;
+	vector<MeshSnapshot> meshes;
+
+	bool depthIsolation = false;
+	bool fixedPosition	= false;
+};
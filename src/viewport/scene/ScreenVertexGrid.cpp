@@ -0,0 +1,178 @@
+#include "ScreenVertexGrid.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "SelectionRegion.h"
+#include "math/matrix/Matrix4.h"
+#include "math/vector/Vector2.h"
+#include "objects/mesh/Mesh.h"
+
+
+/** Cell of a window coordinate, clamped to [-1, cells] before the cast so far-off or non-finite points can't overflow */
+static int cellIndex(const float coordinate, const int cells) {
+	const float cell = floor(coordinate / SCREEN_GRID_CELL_SIZE);
+	if (!(cell >= 0.0f)) return -1;		// Also NaN
+	return cell < static_cast<float>(cells) ? static_cast<int>(cell) : cells;
+}
+
+
+void ScreenVertexGrid::update(
+	const vector<shared_ptr<Mesh>>& current,
+	const array<int, 4>& currentViewport,
+	const array<float, 16>& currentView,
+	const array<float, 16>& currentProj
+) {
+	bool changed = current != meshes
+		|| currentViewport != viewport
+		|| currentView != viewMatrix
+		|| currentProj != projMatrix;
+
+	if (!changed) {
+		for (size_t i = 0; i < meshes.size(); i++) {
+			if (meshes[i]->getGeometryVersion() != versions[i]) {
+				changed = true;
+				break;
+			}
+		}
+	}
+	if (!changed) return;
+
+	meshes	   = current;
+	viewport   = currentViewport;
+	viewMatrix = currentView;
+	projMatrix = currentProj;
+
+	versions.clear();
+	for (const auto& mesh : meshes) {
+		versions.emplace_back(mesh->getGeometryVersion());
+	}
+
+	project();
+	bin();
+}
+
+/**
+ * Transform all vertices to window coordinates with a single view-projection matrix.
+ * The positions of all Meshes are gathered into one PointBatch, projected by the batch kernels
+ * and then compacted to the points in front of the camera and inside the viewport. Vertices just in
+ * front of the camera plane project arbitrarily far out (or to infinity), so they're dropped here too.
+ */
+void ScreenVertexGrid::project() {
+	size_t total = 0;
+	for (const auto& mesh : meshes) total += mesh->vertices.size();
+
+	points.resize(total);
+	size_t offset = 0;
+	for (const auto& mesh : meshes) {
+		for (const auto& v : mesh->vertices) {
+			points.x[offset] = v->position.x;
+			points.y[offset] = v->position.y;
+			points.z[offset] = v->position.z;
+			offset++;
+		}
+	}
+
+	projectPoints(Matrix4(projMatrix) * Matrix4(viewMatrix), viewport, points, screen);
+
+	xs.resize(total); ys.resize(total); depths.resize(total);
+	meshIndices.resize(total); vertexIndices.resize(total);
+	size_t count = 0;
+
+	const auto width  = static_cast<float>(viewport[2]);
+	const auto height = static_cast<float>(viewport[3]);
+
+	offset = 0;
+	for (size_t meshIndex = 0; meshIndex < meshes.size(); meshIndex++) {
+		const size_t n = meshes[meshIndex]->vertices.size();
+		for (size_t i = 0; i < n; i++) {
+			const size_t k = offset + i;
+			if (screen.w[k] <= 0.0f) continue;	// Behind the camera
+
+			// Written so that NaNs fail too
+			const float x = screen.x[k], y = screen.y[k];
+			if (!(x >= 0.0f && x <= width && y >= 0.0f && y <= height && isfinite(screen.w[k]))) continue;
+
+			xs[count]			 = screen.x[k];
+			ys[count]			 = screen.y[k];
+			depths[count]		 = screen.w[k];
+			meshIndices[count]	 = static_cast<int>(meshIndex);
+			vertexIndices[count] = static_cast<int>(i);
+			count++;
+		}
+		offset += n;
+	}
+
+	xs.resize(count); ys.resize(count); depths.resize(count);
+	meshIndices.resize(count); vertexIndices.resize(count);
+}
+
+/** Counting sort of the projected points into their cells; points on the far edges of the viewport are dropped */
+void ScreenVertexGrid::bin() {
+	cellsX = max(1, (viewport[2] + SCREEN_GRID_CELL_SIZE - 1) / SCREEN_GRID_CELL_SIZE);
+	cellsY = max(1, (viewport[3] + SCREEN_GRID_CELL_SIZE - 1) / SCREEN_GRID_CELL_SIZE);
+	const size_t cellCount = static_cast<size_t>(cellsX) * cellsY;
+
+	auto cellOf = [this](const size_t i) -> int64_t {
+		const auto cx = cellIndex(xs[i], cellsX);
+		const auto cy = cellIndex(ys[i], cellsY);
+		if (cx < 0 || cy < 0 || cx >= cellsX || cy >= cellsY) return -1;
+		return static_cast<int64_t>(cy) * cellsX + cx;
+	};
+
+	cellStart.assign(cellCount + 1, 0);
+	for (size_t i = 0; i < xs.size(); i++) {
+		if (const auto cell = cellOf(i); cell >= 0) cellStart[cell + 1]++;
+	}
+	for (size_t c = 0; c < cellCount; c++) {
+		cellStart[c + 1] += cellStart[c];
+	}
+
+	cellPoints.resize(cellStart.back());
+	vector<uint32_t> fill(cellStart.begin(), cellStart.end() - 1);
+	for (size_t i = 0; i < xs.size(); i++) {
+		if (const auto cell = cellOf(i); cell >= 0) cellPoints[fill[cell]++] = static_cast<uint32_t>(i);
+	}
+}
+
+
+optional<ScreenVertexGrid::Hit> ScreenVertexGrid::pick(const Vector2& point, const float radius) const {
+	if (cellStart.empty()) return nullopt;
+
+	const auto px = static_cast<float>(point.x);
+	const auto py = static_cast<float>(point.y);
+	const int x0 = max(0, cellIndex(px - radius, cellsX));
+	const int y0 = max(0, cellIndex(py - radius, cellsY));
+	const int x1 = min(cellsX - 1, cellIndex(px + radius, cellsX));
+	const int y1 = min(cellsY - 1, cellIndex(py + radius, cellsY));
+
+	int best = -1;
+	for (int cy = y0; cy <= y1; cy++) {
+		for (int cx = x0; cx <= x1; cx++) {
+			const size_t cell = static_cast<size_t>(cy) * cellsX + cx;
+			for (uint32_t k = cellStart[cell]; k < cellStart[cell + 1]; k++) {
+				const uint32_t i = cellPoints[k];
+				const float dx = xs[i] - px;
+				const float dy = ys[i] - py;
+				if (dx * dx + dy * dy >= radius * radius) continue;
+
+				// Closest to the camera wins
+				if (best < 0 || depths[i] < depths[best]) best = static_cast<int>(i);
+			}
+		}
+	}
+
+	if (best < 0) return nullopt;
+	return Hit{meshIndices[best], vertexIndices[best]};
+}
+
+vector<ScreenVertexGrid::Hit> ScreenVertexGrid::query(const SelectionRegion& region) const {
+	vector<uint8_t> inside(xs.size());
+	region.contains(xs.data(), ys.data(), xs.size(), inside.data());
+
+	vector<Hit> hits;
+	for (size_t i = 0; i < inside.size(); i++) {
+		if (inside[i]) hits.push_back({meshIndices[i], vertexIndices[i]});
+	}
+	return hits;
+}
@@ -0,0 +1,73 @@
+#pragma once
+
+using namespace std;
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <vector>
+
+#include "math/matrix/BatchTransform.h"
+
+class Mesh;
+class SelectionRegion;
+class Vector2;
+
+// Constants
+constexpr int SCREEN_GRID_CELL_SIZE = 32;	// Cell edge length in pixels
+
+
+/**
+ * Screen-space positions of the vertices of a set of Meshes, bucketed into a uniform 2D grid.
+ *
+ * The vertices are projected in one batched pass (see projectPoints()) with a view-projection matrix,
+ * and only again after the camera, the viewport or one of the Meshes changed.
+ * Point queries then only visit the cells overlapping the query radius, while region queries
+ * sweep the contiguous coordinate arrays with vectorized inclusion tests.
+ */
+class ScreenVertexGrid {
+public:
+	struct Hit {
+		int mesh;		// Index into the Meshes passed to update()
+		int vertex;		// Index into Mesh::vertices
+	};
+
+	/** Reproject the vertices if anything they depend on changed since the last call */
+	void update(
+		const vector<shared_ptr<Mesh>> &meshes,
+		const array<int, 4> &viewport,
+		const array<float, 16> &viewMatrix,
+		const array<float, 16> &projMatrix
+	);
+
+	/** Vertex closest to the camera among those within radius pixels of the point (top-left origin) */
+	[[nodiscard]] optional<Hit> pick(const Vector2 &point, float radius) const;
+
+	/** All projected vertices within the region, regardless of occlusion */
+	[[nodiscard]] vector<Hit> query(const SelectionRegion &region) const;
+
+private:
+	// Cache keys
+	vector<shared_ptr<Mesh>> meshes;
+	vector<uint64_t> versions;
+	array<int, 4> viewport{};
+	array<float, 16> viewMatrix{};
+	array<float, 16> projMatrix{};
+
+	// All vertices before and after projection, reused between updates
+	PointBatch points;
+	ScreenBatch screen;
+
+	// Projected vertices in front of the camera (structure of arrays)
+	vector<float> xs, ys, depths;
+	vector<int> meshIndices, vertexIndices;
+
+	// Grid cells: the points of cell c are cellPoints[cellStart[c] .. cellStart[c + 1])
+	int cellsX = 0, cellsY = 0;
+	vector<uint32_t> cellStart;
+	vector<uint32_t> cellPoints;
+
+	void project();
+	void bin();
+};
@@ -0,0 +1,94 @@
+#include "SelectionManager.h"
+
+#include <algorithm>
+#include <ranges>
+
+#include "objects/mesh/Mesh.h"
+
+
+bool SelectionManager::contains(const Object& obj) const {
+	const auto id = static_cast<size_t>(obj.getID());
+	return id < slots.size() && slots[id] != 0;
+}
+
+bool SelectionManager::add(const shared_ptr<Object>& obj) {
+	if (contains(*obj)) return false;
+
+	objects.emplace_back(obj);
+	setSlot(*obj, static_cast<uint32_t>(objects.size()));
+	changed();
+	return true;
+}
+
+bool SelectionManager::remove(const Object& obj) {
+	if (!contains(obj)) return false;
+
+	// Keep the selection order, so the Objects after the removed one move up
+	// (obj may be owned by nothing but the selection, so it's not touched after erasing)
+	const auto id = obj.getID();
+	const uint32_t position = slots[id] - 1;
+	slots[id] = 0;
+	objects.erase(objects.begin() + position);
+	for (size_t i = position; i < objects.size(); i++) {
+		setSlot(*objects[i], static_cast<uint32_t>(i + 1));
+	}
+	changed();
+	return true;
+}
+
+void SelectionManager::toggle(const shared_ptr<Object>& obj) {
+	if (!remove(*obj)) add(obj);
+}
+
+void SelectionManager::clear() {
+	if (objects.empty()) return;
+
+	for (const auto& obj : objects) slots[obj->getID()] = 0;
+	objects.clear();
+	changed();
+}
+
+void SelectionManager::assign(const vector<shared_ptr<Object>>& selection) {
+	for (const auto& obj : objects) slots[obj->getID()] = 0;
+	objects.clear();
+
+	for (const auto& obj : selection) {
+		if (contains(*obj)) continue;
+		objects.emplace_back(obj);
+		setSlot(*obj, static_cast<uint32_t>(objects.size()));
+	}
+	changed();
+}
+
+const vector<shared_ptr<Mesh>>& SelectionManager::getMeshes() const {
+	if (meshesVersion != version) {
+		meshes.clear();
+		for (const auto& obj : objects) {
+			if (auto mesh = dynamic_pointer_cast<Mesh>(obj)) meshes.emplace_back(std::move(mesh));
+		}
+		meshesVersion = version;
+	}
+	return meshes;
+}
+
+
+int SelectionManager::addListener(Listener listener) {
+	listeners.emplace_back(nextListener, std::move(listener));
+	return nextListener++;
+}
+
+void SelectionManager::removeListener(const int handle) {
+	erase_if(listeners, [handle](const auto& entry) { return entry.first == handle; });
+}
+
+
+void SelectionManager::setSlot(const Object& obj, const uint32_t slot) {
+	const auto id = static_cast<size_t>(obj.getID());
+	if (id >= slots.size()) slots.resize(max(id + 1, slots.size() * 2), 0);
+	slots[id] = slot;
+}
+
+void SelectionManager::changed() {
+	version++;
+	for (const auto& listener : listeners | views::values) listener();
+}
@@ -0,0 +1,62 @@
+#pragma once
+
+using namespace std;
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+
+class Object;
+class Mesh;
+
+
+/**
+ * Set of selected Objects, indexed by Object ID for O(1) membership tests.
+ *
+ * Objects are kept in selection order (the first one is the active Object). Every change increments
+ * a version and notifies the listeners once, so caches derived from the selection only have to be
+ * rebuilt when it actually changed. The selected Meshes are such a cache and come without allocations.
+ */
+class SelectionManager {
+public:
+	using Listener = function<void()>;
+
+	[[nodiscard]] bool contains(const Object &obj) const;
+	[[nodiscard]] bool isEmpty() const { return objects.empty(); }
+	[[nodiscard]] size_t size() const { return objects.size(); }
+
+	/** Returns false if the Object was already selected */
+	bool add(const shared_ptr<Object> &obj);
+	/** Returns false if the Object wasn't selected */
+	bool remove(const Object &obj);
+	void toggle(const shared_ptr<Object> &obj);
+	void clear();
+
+	/** Replace the whole selection, notifying once */
+	void assign(const vector<shared_ptr<Object>> &selection);
+
+	[[nodiscard]] const vector<shared_ptr<Object>>& getObjects() const { return objects; }
+	[[nodiscard]] const vector<shared_ptr<Mesh>>& getMeshes() const;
+
+	/** Incremented on every change */
+	[[nodiscard]] uint64_t getVersion() const { return version; }
+
+	/** Call listener after every change; returns a handle for removeListener() */
+	int addListener(Listener listener);
+	void removeListener(int handle);
+
+private:
+	vector<shared_ptr<Object>> objects;
+	vector<uint32_t> slots;		// By Object ID: position in objects + 1, or 0 if not selected
+
+	mutable vector<shared_ptr<Mesh>> meshes;
+	mutable uint64_t meshesVersion = UINT64_MAX;
+
+	uint64_t version = 0;
+	vector<pair<int, Listener>> listeners;
+	int nextListener = 0;
+
+	void setSlot(const Object &obj, uint32_t slot);
+	void changed();
+};
@@ -0,0 +1,163 @@
+#include "SelectionRegion.h"
+
+#include <algorithm>
+
+#include <GL/glew.h>
+
+#include "graphics/color/Colors.h"
+#include "math/Simd.h"
+
+
+optional<SelectionRegion::LassoEdge> SelectionRegion::lassoEdge(const Vector2& a, const Vector2& b) {
+	if (a.y == b.y) return nullopt;	// Horizontal edges are never crossed
+
+	return LassoEdge{
+		static_cast<float>(a.x), static_cast<float>(a.y), static_cast<float>(b.y),
+		static_cast<float>((b.x - a.x) / (b.y - a.y))
+	};
+}
+
+
+void SelectionRegion::begin(const Vector2& point, const RegionShape regionShape) {
+	shape  = regionShape;
+	points = {point, point};
+	min = max = point;
+	edges.clear();
+	closingEdge.reset();
+}
+
+void SelectionRegion::extend(const Vector2& point) {
+	if (points.empty()) return;
+
+	if (shape == RegionShape::RECTANGLE) {
+		points.back() = point;
+		min = {std::min(points[0].x, point.x), std::min(points[0].y, point.y)};
+		max = {std::max(points[0].x, point.x), std::max(points[0].y, point.y)};
+		return;
+	}
+
+	if (points.back().distance(point) < LASSO_POINT_SPACING) return;
+	if (const auto edge = lassoEdge(points.back(), point)) edges.emplace_back(*edge);
+	closingEdge = lassoEdge(point, points.front());
+	points.emplace_back(point);
+	min = {std::min(min.x, point.x), std::min(min.y, point.y)};
+	max = {std::max(max.x, point.x), std::max(max.y, point.y)};
+}
+
+void SelectionRegion::clear() {
+	points.clear();
+	edges.clear();
+	closingEdge.reset();
+}
+
+bool SelectionRegion::isDrag() const {
+	return isActive() && std::max(max.x - min.x, max.y - min.y) >= REGION_DRAG_THRESHOLD;
+}
+
+
+bool SelectionRegion::contains(const float x, const float y) const {
+	if (x < min.x || x > max.x || y < min.y || y > max.y) return false;
+	if (shape == RegionShape::RECTANGLE) return true;
+
+	bool odd = false;
+	const auto cross = [&](const LassoEdge& e) {
+		if ((e.y0 > y) != (e.y1 > y) && x < e.x0 + (y - e.y0) * e.slope) odd = !odd;
+	};
+	for (const auto& e : edges) cross(e);
+	if (closingEdge) cross(*closingEdge);
+	return odd;
+}
+
+void SelectionRegion::contains(const float* xs, const float* ys, const size_t count, uint8_t* inside) const {
+	if (!isActive()) {
+		fill_n(inside, count, 0);
+		return;
+	}
+
+	const auto minX = static_cast<float>(min.x), maxX = static_cast<float>(max.x);
+	const auto minY = static_cast<float>(min.y), maxY = static_cast<float>(max.y);
+	const bool lasso = shape == RegionShape::LASSO;
+
+	size_t i = 0;
+#ifdef USE_SSE
+	const __m128 vMinX = _mm_set1_ps(minX), vMaxX = _mm_set1_ps(maxX);
+	const __m128 vMinY = _mm_set1_ps(minY), vMaxY = _mm_set1_ps(maxY);
+
+	for (; i + 4 <= count; i += 4) {
+		const __m128 x = _mm_loadu_ps(xs + i);
+		const __m128 y = _mm_loadu_ps(ys + i);
+
+		// Bounding rectangle
+		__m128 mask = _mm_and_ps(
+			_mm_and_ps(_mm_cmpge_ps(x, vMinX), _mm_cmple_ps(x, vMaxX)),
+			_mm_and_ps(_mm_cmpge_ps(y, vMinY), _mm_cmple_ps(y, vMaxY))
+		);
+
+		// Count the edges crossed by a ray towards +x; only needed if any lane is still in
+		if (lasso && _mm_movemask_ps(mask)) {
+			__m128 odd = _mm_setzero_ps();
+			const auto cross = [&](const LassoEdge& e) {
+				const __m128 y0 = _mm_set1_ps(e.y0);
+				const __m128 spans = _mm_xor_ps(_mm_cmpgt_ps(y0, y), _mm_cmpgt_ps(_mm_set1_ps(e.y1), y));
+				const __m128 crossX = _mm_add_ps(_mm_set1_ps(e.x0), _mm_mul_ps(_mm_sub_ps(y, y0), _mm_set1_ps(e.slope)));
+				odd = _mm_xor_ps(odd, _mm_and_ps(spans, _mm_cmplt_ps(x, crossX)));
+			};
+			for (const auto& e : edges) cross(e);
+			if (closingEdge) cross(*closingEdge);
+			mask = _mm_and_ps(mask, odd);
+		}
+
+		const int bits = _mm_movemask_ps(mask);
+		inside[i]	  = bits & 1;
+		inside[i + 1] = bits >> 1 & 1;
+		inside[i + 2] = bits >> 2 & 1;
+		inside[i + 3] = bits >> 3 & 1;
+	}
+#endif
+
+	for (; i < count; i++) {
+		const float x = xs[i], y = ys[i];
+		bool in = x >= minX && x <= maxX && y >= minY && y <= maxY;
+		if (in && lasso) in = contains(x, y);
+		inside[i] = in;
+	}
+}
+
+
+void SelectionRegion::draw(const int width, const int height) const {
+	if (!isDrag()) return;
+
+	glPushAttrib(GL_ENABLE_BIT | GL_LINE_BIT | GL_CURRENT_BIT);
+	glDisable(GL_DEPTH_TEST);
+	glDisable(GL_LIGHTING);
+	glDisable(GL_TEXTURE_2D);
+	glEnable(GL_LINE_STIPPLE);
+	glLineStipple(1, 0x0F0F);	// Dashed
+	glLineWidth(1.0f);
+
+	glMatrixMode(GL_PROJECTION);
+	glPushMatrix();
+	glLoadIdentity();
+	glOrtho(0, width, height, 0, -1, 1);
+	glMatrixMode(GL_MODELVIEW);
+	glPushMatrix();
+	glLoadIdentity();
+
+	color3f(Colors::WHITE);
+	glBegin(GL_LINE_LOOP);
+	if (shape == RegionShape::RECTANGLE) {
+		glVertex2d(min.x, min.y);
+		glVertex2d(max.x, min.y);
+		glVertex2d(max.x, max.y);
+		glVertex2d(min.x, max.y);
+	} else {
+		for (const auto& p : points) glVertex2d(p.x, p.y);
+	}
+	glEnd();
+
+	glMatrixMode(GL_PROJECTION);
+	glPopMatrix();
+	glMatrixMode(GL_MODELVIEW);
+	glPopMatrix();
+	glPopAttrib();
+}
@@ -0,0 +1,68 @@
+#pragma once
+
+using namespace std;
+
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+#include "math/vector/Vector2.h"
+
+// Constants
+constexpr double REGION_DRAG_THRESHOLD	= 4.0;	// Pixels the cursor has to move before a click becomes a region selection
+constexpr double LASSO_POINT_SPACING	= 3.0;	// Minimum pixel distance between consecutive lasso points
+
+
+/** Outline of a region selection */
+enum class RegionShape {
+	RECTANGLE,	// Spanned by the drag start and the current cursor position
+	LASSO		// Closed polygon along the cursor path
+};
+
+
+/**
+ * Screen-space region dragged out with the mouse (window coordinates, origin top left).
+ *
+ * Inclusion tests run over whole arrays of projected points at once; with SSE they classify
+ * four points per iteration against the bounding rectangle and, for lassos, against every edge
+ * of the polygon (even-odd rule).
+ */
+class SelectionRegion {
+public:
+	void begin(const Vector2 &point, RegionShape shape);
+	void extend(const Vector2 &point);
+	void clear();
+
+	[[nodiscard]] bool isActive() const { return !points.empty(); }
+	[[nodiscard]] bool isDrag() const;
+	[[nodiscard]] RegionShape getShape() const { return shape; }
+
+	/** Bounding rectangle */
+	[[nodiscard]] Vector2 getMin() const { return min; }
+	[[nodiscard]] Vector2 getMax() const { return max; }
+
+	[[nodiscard]] bool contains(float x, float y) const;
+
+	/** Set inside[i] to 1 if (xs[i], ys[i]) lies within the region, 0 otherwise */
+	void contains(const float *xs, const float *ys, size_t count, uint8_t *inside) const;
+
+	/** Draw the outline on top of the Viewport */
+	void draw(int width, int height) const;
+
+private:
+	/** Lasso edge prepared for the crossing test */
+	struct LassoEdge {
+		float x0, y0, y1;
+		float slope;	// dx / dy
+	};
+
+	RegionShape shape = RegionShape::RECTANGLE;
+	vector<Vector2> points;		// Both corners for rectangles, the cursor path for lassos
+	Vector2 min, max;
+
+	// Kept up to date by extend(), so inclusion tests don't rebuild them; horizontal edges are left out
+	vector<LassoEdge> edges;			// Between consecutive lasso points
+	optional<LassoEdge> closingEdge;	// From the last lasso point back to the first
+
+	[[nodiscard]] static optional<LassoEdge> lassoEdge(const Vector2 &a, const Vector2 &b);
+};
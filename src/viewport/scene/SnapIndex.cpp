@@ -0,0 +1,88 @@
+#include "SnapIndex.h"
+
+#include <cmath>
+
+#include "objects/mesh/Mesh.h"
+
+
+void SnapIndex::update(const vector<shared_ptr<Mesh>>& meshes) {
+	updates++;
+
+	for (const auto& mesh : meshes) {
+		const auto id = static_cast<size_t>(mesh->getID());
+		if (id >= slots.size()) slots.resize(id + 1, 0);
+
+		if (slots[id] == 0) {
+			entries.emplace_back(Entry{mesh, mesh->getGeometryVersion(), {}, updates});
+			slots[id] = static_cast<uint32_t>(entries.size());
+			build(entries.back());
+			continue;
+		}
+
+		Entry& entry = entries[slots[id] - 1];
+		entry.lastUpdate = updates;
+		if (entry.version != mesh->getGeometryVersion()) {
+			entry.version = mesh->getGeometryVersion();
+			build(entry);
+		}
+	}
+
+	// Drop the Meshes that weren't passed this time, moving the last entry into every gap
+	for (size_t i = 0; i < entries.size();) {
+		if (entries[i].lastUpdate == updates) {
+			i++;
+			continue;
+		}
+		slots[entries[i].mesh->getID()] = 0;
+		if (i + 1 != entries.size()) {
+			entries[i] = std::move(entries.back());
+			slots[entries[i].mesh->getID()] = static_cast<uint32_t>(i + 1);
+		}
+		entries.pop_back();
+	}
+}
+
+void SnapIndex::build(Entry& entry) const {
+	vector<Vector3> positions;
+	positions.reserve(entry.mesh->vertices.size());
+	for (const auto& v : entry.mesh->vertices) positions.emplace_back(v->position);
+	entry.tree.build(positions);
+}
+
+void SnapIndex::clear() {
+	for (const auto& entry : entries) slots[entry.mesh->getID()] = 0;
+	entries.clear();
+}
+
+optional<SnapIndex::Hit> SnapIndex::nearest(const Vector3& p, const float maxDistance) const {
+	optional<Hit> best;
+	float bestDistance = maxDistance;
+
+	const auto visit = [&](const Entry& entry) {
+		if (const auto hit = entry.tree.nearest(p, bestDistance)) {
+			bestDistance = sqrt(hit->distanceSquared);
+			best = Hit{entry.mesh, static_cast<int>(hit->index), entry.tree.getPoint(hit->index), bestDistance};
+		}
+	};
+
+	// Start with the tree closest to p, which usually holds the answer and tightens the reach for the others
+	const Entry* closest = nullptr;
+	float closestBound = maxDistance * maxDistance;
+	for (const auto& entry : entries) {
+		if (entry.tree.isEmpty()) continue;
+		if (const float bound = entry.tree.getBounds().distanceSquared(p); bound <= closestBound) {
+			closestBound = bound;
+			closest = &entry;
+		}
+	}
+	if (!closest) return nullopt;
+	visit(*closest);
+
+	for (const auto& entry : entries) {
+		if (&entry == closest || entry.tree.isEmpty()) continue;
+		if (entry.tree.getBounds().distanceSquared(p) > bestDistance * bestDistance) continue;
+		visit(entry);
+	}
+
+	return best;
+}
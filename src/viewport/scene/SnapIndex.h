@@ -0,0 +1,51 @@
+#pragma once
+
+using namespace std;
+
+#include <memory>
+#include <optional>
+#include <vector>
+
+#include "math/geometry/KDTree.h"
+
+class Mesh;
+
+
+/**
+ * Nearest-vertex lookup over a set of Meshes, for snapping during transformations.
+ *
+ * Every Mesh gets its own KDTree, which is kept across updates until the Mesh's geometry changes,
+ * so the Meshes that stand still while others are being moved are only indexed once. Entries are
+ * found by Object ID, so an update costs O(1) per Mesh besides the trees it rebuilds.
+ * Queries start at the tree closest to the query point and skip the others by their bounds.
+ */
+class SnapIndex {
+public:
+	struct Hit {
+		shared_ptr<Mesh> mesh;
+		int vertex;				// Index into Mesh::vertices
+		Vector3 position;
+		float distance;
+	};
+
+	/** Index the vertices of these Meshes, rebuilding only the trees of new or changed Meshes */
+	void update(const vector<shared_ptr<Mesh>> &meshes);
+	void clear();
+
+	/** Closest indexed vertex within maxDistance of p */
+	[[nodiscard]] optional<Hit> nearest(const Vector3 &p, float maxDistance) const;
+
+private:
+	struct Entry {
+		shared_ptr<Mesh> mesh;
+		uint64_t version;
+		KDTree tree;
+		uint64_t lastUpdate;	// Number of the last update() that included the Mesh
+	};
+
+	vector<Entry> entries;
+	vector<uint32_t> slots;		// By Object ID: position in entries + 1, or 0 if not indexed
+	uint64_t updates = 0;
+
+	void build(Entry &entry) const;
+};